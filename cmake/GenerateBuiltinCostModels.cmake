@@ -0,0 +1,46 @@
+# Turns the cost models in costmodels/ into BuiltinCostModels.def, which
+# lib/BuiltinCostModel.cpp compiles into constexpr tables.
+#
+# cmake -DMODELS=<name>,<name>... -DSOURCE_DIR=<dir> -DOUTPUT=<file> -P GenerateBuiltinCostModels.cmake
+
+string(REPLACE "," ";" MODELS "${MODELS}")
+
+set(content "// Generated by cmake/GenerateBuiltinCostModels.cmake, do not edit\n")
+
+foreach(model ${MODELS})
+    # Model names become C++ identifiers
+    if(NOT model MATCHES "^[A-Za-z_][A-Za-z0-9_]*$")
+        message(FATAL_ERROR "Invalid built-in cost model name: ${model}")
+    endif()
+
+    set(path "${SOURCE_DIR}/${model}.csv")
+    file(STRINGS "${path}" lines)
+    list(LENGTH lines numLines)
+    if(numLines LESS 2)
+        message(FATAL_ERROR "${path}: no opcodes")
+    endif()
+
+    list(GET lines 0 header)
+    string(STRIP "${header}" header)
+    if(NOT header STREQUAL "Opcode,Cost")
+        message(FATAL_ERROR "${path}: the header must be Opcode,Cost")
+    endif()
+    list(REMOVE_AT lines 0)
+
+    string(APPEND content "\nBUILTIN_COST_MODEL(${model},\n")
+    set(separator "")
+    foreach(line ${lines})
+        string(STRIP "${line}" line)
+        if(line STREQUAL "")
+            continue()
+        endif()
+        if(NOT line MATCHES "^([^,\"\\\\ ]+),(-?[0-9]+)$")
+            message(FATAL_ERROR "${path}: cannot parse \"${line}\"")
+        endif()
+        string(APPEND content "${separator}    {\"${CMAKE_MATCH_1}\", ${CMAKE_MATCH_2}}")
+        set(separator ",\n")
+    endforeach()
+    string(APPEND content "\n)\n")
+endforeach()
+
+file(WRITE "${OUTPUT}" "${content}")
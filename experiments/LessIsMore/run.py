@@ -109,7 +109,7 @@ def getScore(optArgList):
                                 *optArgList,
                                 ], stdout=subprocess.PIPE, stderr=subprocess.PIPE)
     costAnalyzer = subprocess.Popen(['gpscat-cost',
-                                     'costModel.csv',
+                                     'builtin:wasm32',
                                      '-arch=wasm32',
                                      '-replace-nat',
                                      '-inline=1000',
@@ -0,0 +1,100 @@
+#pragma once
+
+/* C interface of gpscat::Analyzer, exported by libgpscat.so.
+ *
+ * An analyzer is configured with gpscat_analyzer_set_option, gets its cost
+ * model once with gpscat_analyzer_load_cost_model, and can then analyze
+ * any number of modules, one at a time. The result of the last analysis
+ * is kept in the handle: strings and arrays returned by the
+ * gpscat_result_* functions belong to it and stay valid until the next
+ * analysis or until the analyzer is freed. Different analyzers can be
+ * used concurrently from different threads.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+#define GPSCAT_C_API __attribute__((visibility("default")))
+#else
+#define GPSCAT_C_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct gpscat_analyzer gpscat_analyzer;
+
+/* Return codes */
+enum {
+    GPSCAT_OK = 0,
+    GPSCAT_ERROR_INVALID_ARGUMENT = 1,
+    /* The cost model cannot be read */
+    GPSCAT_ERROR_COST_MODEL = 2,
+    /* Options after the cost model was loaded, or analysis before */
+    GPSCAT_ERROR_STATE = 3,
+    /* Out of memory or another unexpected failure */
+    GPSCAT_ERROR_INTERNAL = 4
+};
+
+/* Status of the last analysis */
+enum {
+    GPSCAT_STATUS_COMPLETE = 0,
+    GPSCAT_STATUS_PARTIAL = 1,
+    GPSCAT_STATUS_FAILED = 2
+};
+
+/* Returns NULL if out of memory */
+GPSCAT_C_API gpscat_analyzer *gpscat_analyzer_create(void);
+/* Also stops the solver worker processes the analyzer started */
+GPSCAT_C_API void gpscat_analyzer_free(gpscat_analyzer *analyzer);
+
+/* Options use the names of the gpscat-cost command line: arch, O,
+ * mcpu, schedule-blocks, function, inline, eager-inline,
+ * coalesce-ticks, slice-control, component-jobs, compositional,
+ * compositional-jobs, all-functions, function-jobs, deadline,
+ * cache-dir, cache-size, solver-worker and solver-workers. Flags take
+ * "0" or "1". */
+GPSCAT_C_API int gpscat_analyzer_set_option(gpscat_analyzer *analyzer, const char *name, const char *value);
+
+/* A CSV file, or builtin:<name> for a cost model compiled into gpscat */
+GPSCAT_C_API int gpscat_analyzer_load_cost_model(gpscat_analyzer *analyzer, const char *path);
+
+/* Analyzes bitcode or textual IR of the given size. GPSCAT_OK means the
+ * analysis ran, gpscat_result_status tells how far it got. */
+GPSCAT_C_API int gpscat_analyzer_analyze(gpscat_analyzer *analyzer, const char *data, size_t size);
+
+/* Message of the last error returned, or an empty string */
+GPSCAT_C_API const char *gpscat_analyzer_get_error(const gpscat_analyzer *analyzer);
+
+GPSCAT_C_API int gpscat_result_status(const gpscat_analyzer *analyzer);
+/* The stage the analysis was in when it finished or stopped */
+GPSCAT_C_API const char *gpscat_result_stage(const gpscat_analyzer *analyzer);
+GPSCAT_C_API const char *gpscat_result_message(const gpscat_analyzer *analyzer);
+/* NULL if no bound was found */
+GPSCAT_C_API const char *gpscat_result_bound(const gpscat_analyzer *analyzer);
+/* The whole result, as printed by gpscat-cost -json */
+GPSCAT_C_API const char *gpscat_result_json(const gpscat_analyzer *analyzer);
+
+/* Only set when the cost model has several resources, one bound for each
+ * of them, the first being gpscat_result_bound. Indices out of range give
+ * NULL. */
+GPSCAT_C_API size_t gpscat_result_num_resources(const gpscat_analyzer *analyzer);
+GPSCAT_C_API const char *gpscat_result_resource_name(const gpscat_analyzer *analyzer, size_t resource);
+/* NULL if no bound was found for the resource */
+GPSCAT_C_API const char *gpscat_result_resource_bound(const gpscat_analyzer *analyzer, size_t resource);
+
+/* Functions with a body, in module order. Indices out of range give NULL
+ * and 0. */
+GPSCAT_C_API size_t gpscat_result_num_functions(const gpscat_analyzer *analyzer);
+GPSCAT_C_API const char *gpscat_result_function_name(const gpscat_analyzer *analyzer, size_t function);
+/* Only set with the all-functions option, NULL otherwise */
+GPSCAT_C_API const char *gpscat_result_function_bound(const gpscat_analyzer *analyzer, size_t function);
+GPSCAT_C_API const int32_t *gpscat_result_block_costs(const gpscat_analyzer *analyzer, size_t function, size_t *numBlocks);
+/* Empty when the block costs came from the cache */
+GPSCAT_C_API const int32_t *gpscat_result_instruction_costs(const gpscat_analyzer *analyzer, size_t function, size_t *numInstructions);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <gpscat/AssemblyCostModel.h>
+
+#include <llvm/IR/Function.h>
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace gpscat {
+
+// Persistent store of analysis results addressed by content hashes, one
+// file per key. Writes go to a temporary file which is renamed into place,
+// so any number of processes can share one directory.
+class AnalysisCache {
+public:
+    // Keeps the entries in memory, for as long as the cache lives
+    AnalysisCache() = default;
+    AnalysisCache(const std::string &directory, std::uint64_t maxSizeMB);
+
+    bool lookup(const std::string &key, std::string &value);
+    void store(const std::string &key, const std::string &value);
+
+    bool lookupBlockCosts(const std::string &key, std::vector<CostTy> &blockCosts);
+    void storeBlockCosts(const std::string &key, const std::vector<CostTy> &blockCosts);
+
+    // Remove the least recently used entries until the directory fits in
+    // the size limit. In memory, remove the entries which were neither
+    // looked up nor stored since the last evict.
+    void evict();
+
+    static std::string hash(const std::string &data);
+    // Empty if the file cannot be read
+    static std::string hashFile(const std::string &path);
+
+    // Hash of the instructions, types and constants of F, independent of
+    // the names of its values and of debug information. The parameter
+    // names are included since bounds refer to them.
+    static std::string getFunctionHash(const llvm::Function &F);
+
+    // Hash of F together with every function it can call directly or
+    // indirectly through direct calls
+    static std::string getCalleeClosureHash(const llvm::Function &F);
+
+private:
+    std::string getPath(const std::string &key) const;
+
+    std::string directory;
+    std::uint64_t maxSizeBytes = 0;
+
+    // Without a directory
+    std::map<std::string, std::string> entries;
+    std::set<std::string> usedKeys;
+};
+
+} // end namespace gpscat
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <gpscat/AssemblyCostModel.h>
+#include <gpscat/SourceLocation.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace gpscat {
+
+// What an analysis produced, including how far it got when it stopped
+// early, so callers get block costs even when no bound could be solved.
+struct AnalysisResult {
+    enum class Status { Complete, Partial, Failed };
+
+    struct FunctionCost {
+        std::string name;
+        // In the order of the blocks in the function
+        std::vector<CostTy> blockCosts;
+        // Only set when every function is solved on its own
+        std::string bound;
+        // In the order of the instructions before the tick calls were
+        // added; empty when the block costs came from a cache
+        std::vector<CostTy> instructionCosts;
+        // Of the same instructions, into sourceFiles; empty if the input
+        // had no debug info
+        std::vector<SourceLocation> sourceLocations;
+    };
+
+    struct ResourceBound {
+        std::string resource;
+        // Empty when no bound was found
+        std::string bound;
+    };
+
+    Status status = Status::Failed;
+    // The stage the analysis was in when it finished or stopped
+    std::string stage;
+    std::string message;
+    std::vector<FunctionCost> functionCosts;
+    std::vector<std::string> sourceFiles;
+    std::string bound;
+    // Only set when the cost model has several resources, one bound for
+    // each of them, the first being bound
+    std::vector<ResourceBound> resourceBounds;
+    // Mean of the bound over given parameter ranges, when it was asked for
+    std::optional<double> score;
+
+    std::string toJSON() const;
+
+    // The instruction costs summed per function and source line, as
+    // "<function>;<file>:<line> <cost>" lines. This is the collapsed stack
+    // format that flame graph tools read. Costs of instructions without a
+    // location are given to the function alone.
+    std::string toCollapsedStacks() const;
+};
+
+} // end namespace gpscat
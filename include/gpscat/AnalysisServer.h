@@ -0,0 +1,91 @@
+#pragma once
+
+#include <gpscat/AssemblyCostModel.h>
+#include <gpscat/AnalysisResult.h>
+#include <gpscat/Analyzer.h>
+#include <gpscat/IncrementalAnalyzer.h>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace gpscat {
+
+// Answers analysis requests on a Unix domain socket. Cost models are
+// parsed again only when their file changes, and the block costs and
+// bounds of earlier requests stay in memory, so a request only pays for
+// what changed.
+//
+// Protocol, one request per connection:
+//   request:  <option>=<value> ... size=<N>\n
+//             followed by N bytes of bitcode or textual IR
+//   response: the AnalysisResult as one line of JSON
+//
+// Options not given take the defaults of the server: cost-model, arch, O,
+// mcpu, schedule-blocks, function, inline, eager-inline, coalesce-ticks,
+// slice-control, compositional, deadline, and score with
+// range.<variable>=<low>:<high> for every variable of the bound.
+class AnalysisServer {
+public:
+    struct Request {
+        std::string costModelPath;
+        // The deadline starts once the input has arrived
+        Analyzer::Options options;
+        bool score = false;
+        std::map<std::string, std::pair<double, double>> ranges;
+        std::size_t size = 0;
+    };
+
+    AnalysisServer(const std::string &costModelPath, const Analyzer::Options &options, unsigned int numWorkers)
+        : costModelPath(costModelPath), options(options), numWorkers(numWorkers) {}
+    ~AnalysisServer();
+
+    AnalysisServer(const AnalysisServer&) = delete;
+    AnalysisServer &operator=(const AnalysisServer&) = delete;
+
+    // Returns false if the socket could not be created
+    bool listen(const std::string &socketPath);
+
+    // Handles up to numWorkers connections at once until stop is called
+    void serve();
+    void stop();
+
+    // Throws std::invalid_argument when the header is malformed
+    Request parseRequest(const std::string &header) const;
+
+private:
+    // Every worker thread has one IncrementalAnalyzer per cost model and
+    // option set, up to maxAnalyzersPerWorker of the most recently used
+    struct Worker {
+        struct Entry {
+            std::unique_ptr<IncrementalAnalyzer> analyzer;
+            std::uint64_t lastUse = 0;
+        };
+        std::map<std::string, Entry> analyzers;
+        std::uint64_t numUses = 0;
+    };
+
+    void serveConnection(Worker &worker, int connection);
+    AnalysisResult analyze(Worker &worker, const Request &request, const std::string &input);
+    // Returns nullptr if the cost model cannot be read. version is set to
+    // the hash of the content it was read from.
+    std::shared_ptr<const AssemblyCostModel> getCostModel(const std::string &path, std::string &version);
+
+    const std::string costModelPath;
+    const Analyzer::Options options;
+    const unsigned int numWorkers;
+
+    int listenFd = -1;
+    std::string socketPath;
+    std::atomic<bool> stopping{false};
+
+    std::mutex costModelMutex;
+    // Path -> (version, cost model)
+    std::map<std::string, std::pair<std::string, std::shared_ptr<const AssemblyCostModel>>> costModels;
+};
+
+} // end namespace gpscat
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <gpscat/AssemblyCostModel.h>
+#include <gpscat/AnalysisResult.h>
+#include <gpscat/AnalysisCache.h>
+#include <gpscat/CoFloCoWrapper.h>
+#include <gpscat/Deadline.h>
+
+#include <llvm/IR/Module.h>
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace gpscat {
+
+class SolverPool;
+
+// The whole cost analysis of a module behind one call: mapping to the
+// target assembly, instruction and block costs, and the bound. Every
+// instance has its own options, so analyses with different settings can
+// run concurrently in one process. One instance analyzes one module at a
+// time.
+class Analyzer {
+public:
+    struct Options {
+        std::string arch = "wasm32";
+        std::string optLevel = "2";
+        // Processor llc compiles for, its default when empty
+        std::string cpu;
+        // The first resource is the cycles of each block in a simulated
+        // pipeline of the processor, see BlockScheduler
+        bool scheduleBlocks = false;
+        SolverConfiguration configuration;
+        // Workers of configuration.solverWorker shared with other
+        // analyzers. Without one the analyzer starts its own, which are
+        // stopped when the last analyzer using them is destroyed.
+        std::shared_ptr<SolverPool> solverPool;
+        bool coalesceTicks = false;
+        bool sliceControl = false;
+        // Solve the loops of the cost relation system separately, with up
+        // to this many solver processes (0 solves the whole system at once)
+        unsigned int componentJobs = 0;
+        // Race the configurations of getPortfolio, each for portfolioTimeout
+        // seconds, and keep the first finite bound or the tightest one
+        bool portfolio = false;
+        bool portfolioBest = false;
+        unsigned int portfolioTimeout = 60;
+        bool compositional = false;
+        unsigned int compositionalJobs = 1;
+        // Solve every externally visible function instead of one bound
+        bool allFunctions = false;
+        unsigned int functionJobs = 1;
+        // Time budget of the whole analysis, 0 for none
+        unsigned int deadlineSeconds = 0;
+        // Reuse the block costs and bounds stored in this directory
+        std::string cacheDir;
+        unsigned int cacheSizeMB = 1024;
+        bool keepTemporaryFiles = false;
+        // Progress messages (1) and mapping tables (2) go to log
+        std::ostream *log = nullptr;
+        int verbosity = 0;
+    };
+
+    // Throws std::runtime_error when the cost model cannot be read
+    Analyzer(const std::string &costModelPath, const Options &options)
+        : costModelPath(costModelPath), costModel(costModelPath), options(withSolverPool(options)) {}
+    // The cache keys identify the model by its contents
+    Analyzer(const AssemblyCostModel &costModel, const Options &options)
+        : costModel(costModel), options(withSolverPool(options)) {}
+
+    // M is modified: it gets the tick calls of its block costs
+    AnalysisResult analyze(llvm::Module *M);
+    // With cache instead of options.cacheDir, and deadline instead of
+    // options.deadlineSeconds
+    AnalysisResult analyze(llvm::Module *M, AnalysisCache &cache, const Deadline &deadline);
+
+    // Number of functions compiled and bounds solved by the last analyze
+    // call, compositional summaries included
+    unsigned int getNumCompiled() const {
+        return numCompiled;
+    }
+    unsigned int getNumSolved() const {
+        return numSolved;
+    }
+
+    // The key analyze looks the block costs of F up by in the cache, for
+    // the given resource of the cost model
+    std::string getBlockCostKey(const llvm::Function &F, std::size_t resource = 0) const;
+
+    // options with a solverPool for its solverWorker, for analyzers
+    // which are to share the workers
+    static Options withSolverPool(Options options);
+
+private:
+    // Everything besides the function the block costs depend on
+    std::string getCostContext(const llvm::Module &M) const;
+    std::string getBlockCostKey(const std::string &costContext, const std::string &functionHash, std::size_t resource) const;
+
+    void run(llvm::Module *M, AnalysisCache *cache, const Deadline &deadline, AnalysisResult &result);
+    void printProgress(const std::string &message) const;
+
+    const std::string costModelPath;
+    const AssemblyCostModel costModel;
+    const Options options;
+
+    unsigned int numCompiled = 0;
+    unsigned int numSolved = 0;
+};
+
+} // end namespace gpscat
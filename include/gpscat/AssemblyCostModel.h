@@ -1,31 +1,95 @@
 #pragma once
 
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringRef.h>
+
 #include <cstdint>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace gpscat {
 
 using CostTy = std::int32_t;
 
+// Assembly opcodes are interned to dense IDs in the order they were added,
+// so mappings and costs can be kept in flat arrays indexed by them
+using OpcodeID = std::uint32_t;
+
+struct BuiltinCostModel;
+
 class AssemblyCostModel {
 public:
+    static constexpr OpcodeID InvalidOpcode = ~OpcodeID(0);
+    static constexpr std::size_t MaxResources = 8;
+
+    // builtin:<name> selects a cost model compiled into gpscat, anything
+    // else is read as a CSV file with an Opcode column and one column per
+    // resource. Throws std::runtime_error if neither works.
     AssemblyCostModel(const std::string &filename);
 
-    CostTy get(const std::string &instName) const {
-        return costModel.at(instName);
+    static bool isBuiltin(const std::string &filename) {
+        return llvm::StringRef(filename).startswith("builtin:");
     }
 
-    void set(const std::string &instName, const CostTy& cost) {
-        costModel[instName] = cost;
+    // Throws std::out_of_range for unknown opcodes
+    CostTy get(const std::string &instName, std::size_t resource = 0) const {
+        OpcodeID opcode = getOpcodeID(instName);
+        if(opcode == InvalidOpcode)
+            throw std::out_of_range("no cost for opcode " + instName);
+        return costs[resource][opcode];
     }
 
+    // Sets the cost of the first resource, new opcodes cost nothing in
+    // the others
+    void set(const std::string &instName, const CostTy& cost);
+
     bool hasInst(const std::string &instName) const {
-        return costModel.find(instName) != costModel.end();
+        return getOpcodeID(instName) != InvalidOpcode;
+    }
+
+    // InvalidOpcode if the opcode has no cost. Takes a StringRef so that
+    // tokens can be looked up without copying them out of the assembly.
+    OpcodeID getOpcodeID(llvm::StringRef instName) const;
+
+    CostTy getCost(OpcodeID opcode, std::size_t resource = 0) const {
+        return costs[resource][opcode];
+    }
+
+    const std::string &getOpcodeName(OpcodeID opcode) const {
+        return opcodeNames[opcode];
+    }
+
+    std::size_t getNumOpcodes() const {
+        return opcodeNames.size();
+    }
+
+    // Resources are the cost columns of the model, such as time, energy
+    // or gas. Cost comes first when there is such a column, the other
+    // columns follow in their order in the file.
+    std::size_t getNumResources() const {
+        return resourceNames.size();
     }
 
+    const std::string &getResourceName(std::size_t resource) const {
+        return resourceNames[resource];
+    }
+
+    // The model as a CSV file, opcodes in ID order and resources in order
+    std::string toCSV() const;
+
 private:
-    std::unordered_map<std::string, CostTy> costModel;
+    void loadCSV(const std::string &filename);
+
+    // Built-in models are looked up with their perfect hash until set()
+    // changes them, opcodeIDs is only filled for the others
+    const BuiltinCostModel *builtin = nullptr;
+    llvm::StringMap<OpcodeID> opcodeIDs;
+    std::vector<std::string> resourceNames = {"Cost"};
+    // Indexed by OpcodeID
+    std::vector<std::string> opcodeNames;
+    // Indexed by resource, then by OpcodeID
+    std::vector<std::vector<CostTy>> costs = std::vector<std::vector<CostTy>>(1);
 };
 
 } // end namespace gpscat
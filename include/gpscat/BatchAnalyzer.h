@@ -0,0 +1,48 @@
+#pragma once
+
+#include <gpscat/AssemblyCostModel.h>
+#include <gpscat/AnalysisResult.h>
+#include <gpscat/Analyzer.h>
+#include <gpscat/IncrementalAnalyzer.h>
+
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace gpscat {
+
+// Analyzes a corpus of bitcode files in one process. Every worker thread
+// has its own LLVMContext and IncrementalAnalyzer, so functions shared by
+// several inputs are compiled once per worker. The threads share the
+// solver workers, which live as long as the BatchAnalyzer. Every result
+// is appended to a journal, and inputs with a complete result in it are
+// skipped, so an interrupted run continues where it stopped and retries
+// the rest.
+class BatchAnalyzer {
+public:
+    using ResultCallback = std::function<void(const std::string &input, const AnalysisResult &result)>;
+
+    // Every input has options.deadlineSeconds
+    BatchAnalyzer(const AssemblyCostModel &costModel, const Analyzer::Options &options, unsigned int numWorkers)
+        : costModel(costModel), options(Analyzer::withSolverPool(options)), numWorkers(numWorkers) {}
+
+    // onResult is called for each analyzed input, never concurrently
+    void run(const std::vector<std::string> &inputs, const std::string &journalPath, const ResultCallback &onResult);
+
+    // One input path per line; empty lines and lines starting with # are ignored
+    static std::vector<std::string> readManifest(const std::string &path);
+
+    // Inputs with a complete result on a journal line which is not cut short
+    static std::set<std::string> readJournal(const std::string &path);
+
+    // Largest files first, so that no big module is left for the end
+    static std::vector<std::string> getSchedule(const std::vector<std::string> &inputs);
+
+private:
+    const AssemblyCostModel &costModel;
+    const Analyzer::Options options;
+    unsigned int numWorkers;
+};
+
+} // end namespace gpscat
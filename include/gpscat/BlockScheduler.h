@@ -0,0 +1,50 @@
+#pragma once
+
+#include <gpscat/AssemblyCostModel.h>
+
+#include <llvm/ADT/Triple.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class MCAsmInfo;
+class MCInstrAnalysis;
+class MCInstrInfo;
+class MCRegisterInfo;
+class MCSubtargetInfo;
+class Target;
+} // end namespace llvm
+
+namespace gpscat {
+
+// Costs each block of the assembly by simulating the out-of-order
+// pipeline of a processor, the way llvm-mca does. The block is repeated
+// until its cycles per iteration settle. Those cycles are then shared
+// among the instruction IDs of the block in proportion to the latencies
+// of their instructions. Summing the latencies instead would assume that
+// nothing executes in parallel.
+class BlockScheduler {
+public:
+    // The target is looked up like llc does for -march. Throws
+    // std::runtime_error if it is unknown or the processor has no
+    // scheduling model.
+    BlockScheduler(const std::string &arch, const std::string &cpu);
+    ~BlockScheduler();
+
+    // Cycles of every instruction ID in the assembly at path, indexed by
+    // ID. Empty if the assembly cannot be parsed.
+    std::vector<CostTy> schedule(const std::string &path) const;
+
+private:
+    llvm::Triple triple;
+    const llvm::Target *target = nullptr;
+    std::unique_ptr<llvm::MCRegisterInfo> MRI;
+    std::unique_ptr<llvm::MCAsmInfo> MAI;
+    std::unique_ptr<llvm::MCInstrInfo> MII;
+    std::unique_ptr<llvm::MCSubtargetInfo> STI;
+    std::unique_ptr<llvm::MCInstrAnalysis> MIA;
+};
+
+} // end namespace gpscat
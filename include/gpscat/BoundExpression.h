@@ -0,0 +1,53 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gpscat {
+
+// Cost upper bound in the syntax printed by CoFloCo, e.g.
+// 3+nat(V_arg0-1)*max([nat(V_arg1),2])
+class BoundExpression {
+public:
+    class Node {
+    public:
+        enum Kind { Number, Variable, Infinity, Add, Sub, Mul, Div, Pow, Neg, Call };
+
+        Kind kind;
+        double value = 0;
+        // Variable or function name
+        std::string name;
+        std::vector<std::shared_ptr<const Node>> operands;
+    };
+
+    // Throws std::invalid_argument when the expression cannot be parsed
+    static BoundExpression parse(const std::string &str);
+
+    // Variables missing from values take defaultValue
+    double evaluate(const std::map<std::string, double> &values, double defaultValue = 0) const;
+
+    std::set<std::string> getVariables() const;
+
+    // How fast the bound grows as its variables grow together: the degree
+    // of a polynomial, a little more for each log factor, the largest
+    // double for exponentials and infinity when it contains oo
+    double getDegree() const;
+
+    // Mean value over the box given by ranges (variable -> [low, high]),
+    // estimated from numSamples uniformly drawn points with a fixed seed.
+    // Variables without a range take defaultValue.
+    double estimateMean(const std::map<std::string, std::pair<double, double>> &ranges, unsigned int numSamples, double defaultValue = 0) const;
+
+    const Node &getRoot() const {
+        return *root;
+    }
+
+private:
+    std::shared_ptr<const Node> root;
+};
+
+} // end namespace gpscat
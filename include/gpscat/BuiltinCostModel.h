@@ -0,0 +1,144 @@
+#pragma once
+
+#include <gpscat/AssemblyCostModel.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace gpscat {
+
+struct BuiltinCostEntry {
+    std::string_view opcode;
+    CostTy cost;
+};
+
+// A cost model compiled into gpscat from costmodels/<name>.csv. Opcodes
+// are found with a perfect hash: one hash picks a displacement, a second
+// hash with that displacement picks the slot, and one comparison decides.
+struct BuiltinCostModel {
+    std::string_view name;
+    const BuiltinCostEntry *entries;
+    std::size_t numEntries;
+    const std::uint32_t *displacements;
+    std::uint32_t bucketMask;
+    const std::uint16_t *slots;
+    std::uint32_t slotMask;
+
+    // FNV-1a, seeded
+    static constexpr std::uint32_t hash(std::uint32_t seed, std::string_view opcode) {
+        std::uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+        for(char c : opcode) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    // Index of the opcode in entries, or numEntries
+    constexpr std::size_t find(std::string_view opcode) const {
+        std::uint32_t displacement = displacements[hash(0, opcode) & bucketMask];
+        std::size_t index = slots[hash(displacement, opcode) & slotMask];
+        return index < numEntries && entries[index].opcode == opcode ? index : numEntries;
+    }
+};
+
+// Builds the perfect hash of N opcodes at compile time. Buckets are placed
+// largest first, each with the first displacement that moves all its
+// opcodes to free slots. Duplicate opcodes make the construction fail,
+// which stops the compilation.
+template<std::size_t N>
+class PerfectHashTable {
+public:
+    static_assert(N > 0 && N < 0xFFFF, "unsupported number of opcodes");
+
+    static constexpr std::size_t roundUpToPowerOf2(std::size_t n) {
+        std::size_t power = 1;
+        while(power < n)
+            power *= 2;
+        return power;
+    }
+
+    static constexpr std::size_t NumBuckets = roundUpToPowerOf2((N + 1) / 2);
+    // At most half of the slots are used
+    static constexpr std::size_t NumSlots = roundUpToPowerOf2(2 * N);
+    static constexpr std::uint16_t EmptySlot = 0xFFFF;
+    static constexpr std::uint32_t MaxDisplacement = 1u << 16;
+
+    constexpr PerfectHashTable(const BuiltinCostEntry (&entries)[N]) : entries(entries), displacements(), slots() {
+        for(auto &slot : slots)
+            slot = EmptySlot;
+
+        std::array<std::uint32_t, N> bucketOfEntry{};
+        std::array<std::size_t, NumBuckets> bucketSizes{};
+        for(std::size_t i = 0; i < N; ++i) {
+            bucketOfEntry[i] = BuiltinCostModel::hash(0, entries[i].opcode) & (NumBuckets - 1);
+            ++bucketSizes[bucketOfEntry[i]];
+        }
+
+        std::array<bool, NumBuckets> placed{};
+        for(std::size_t round = 0; round < NumBuckets; ++round) {
+            std::size_t bucket = 0, largest = 0;
+            for(std::size_t b = 0; b < NumBuckets; ++b) {
+                if(!placed[b] && bucketSizes[b] >= largest) {
+                    bucket = b;
+                    largest = bucketSizes[b];
+                }
+            }
+            placed[bucket] = true;
+            if(largest == 0)
+                break;
+
+            for(std::uint32_t displacement = 1; ; ++displacement) {
+                if(displacement == MaxDisplacement)
+                    throw std::logic_error("no perfect hash, is an opcode listed twice?");
+                if(tryPlace(bucketOfEntry, bucket, displacement)) {
+                    displacements[bucket] = displacement;
+                    break;
+                }
+            }
+        }
+    }
+
+    constexpr BuiltinCostModel getModel(std::string_view name) const {
+        return {name, entries, N, displacements.data(), NumBuckets - 1, slots.data(), NumSlots - 1};
+    }
+
+private:
+    constexpr std::size_t slotOf(std::uint32_t displacement, std::size_t entry) const {
+        return BuiltinCostModel::hash(displacement, entries[entry].opcode) & (NumSlots - 1);
+    }
+
+    constexpr bool tryPlace(const std::array<std::uint32_t, N> &bucketOfEntry, std::size_t bucket, std::uint32_t displacement) {
+        bool fits = true;
+        for(std::size_t i = 0; i < N && fits; ++i) {
+            if(bucketOfEntry[i] != bucket)
+                continue;
+            std::size_t slot = slotOf(displacement, i);
+            if(slots[slot] == EmptySlot)
+                slots[slot] = static_cast<std::uint16_t>(i);
+            else
+                fits = false;
+        }
+        if(fits)
+            return true;
+
+        // Undo the slots this bucket took
+        for(std::size_t i = 0; i < N; ++i) {
+            if(bucketOfEntry[i] == bucket && slots[slotOf(displacement, i)] == i)
+                slots[slotOf(displacement, i)] = EmptySlot;
+        }
+        return false;
+    }
+
+    const BuiltinCostEntry *entries;
+    std::array<std::uint32_t, NumBuckets> displacements;
+    std::array<std::uint16_t, NumSlots> slots;
+};
+
+// nullptr if there is no built-in cost model of that name
+const BuiltinCostModel *findBuiltinCostModel(std::string_view name);
+
+} // end namespace gpscat
@@ -1,15 +1,65 @@
 #pragma once
 
 #include <gpscat/IRCostCalculator.h>
+#include <gpscat/Deadline.h>
 
 #include <llvm/IR/Module.h>
 
+#include <atomic>
 #include <string>
+#include <vector>
 
 namespace gpscat {
 
+class SolverPool;
+
+// How llvm2kittel and CoFloCo are invoked for one solve
+struct SolverConfiguration {
+    unsigned int numInlines = 0;
+    bool eagerInline = false;
+    std::string functionName;
+    bool solveFast = true;
+    bool computeLowerBounds = false;
+    unsigned int timeoutSeconds = 60;
+    // Solve with persistent worker processes running this program instead
+    // of starting cofloco for every query. The workers belong to the
+    // SolverPool given to the wrapper, an Analyzer has one for all of its
+    // wrappers.
+    std::string solverWorker;
+    unsigned int numSolverWorkers = 1;
+
+    std::string str() const;
+};
+
+// Variations of base which often succeed when base times out or returns oo
+std::vector<SolverConfiguration> getPortfolio(const SolverConfiguration &base);
+
 class CoFloCoWrapper {
 public:
+    CoFloCoWrapper() = default;
+    explicit CoFloCoWrapper(const SolverConfiguration &configuration) : configuration(configuration) {}
+
+    // Kill the running external tool as soon as *cancelled becomes true
+    void setCancellationFlag(const std::atomic<bool> *cancelled) {
+        this->cancelled = cancelled;
+    }
+
+    // Every external tool gets at most the time left until deadline
+    void setDeadline(const Deadline &deadline) {
+        this->deadline = deadline;
+    }
+
+    // Workers of configuration.solverWorker to solve with. Without a pool
+    // every solve starts a worker of its own.
+    void setSolverPool(SolverPool *solverPool) {
+        this->solverPool = solverPool;
+    }
+
+    // Whether a stage was killed or skipped because its time ran out
+    bool hasTimedOut() const {
+        return timedOut;
+    }
+
     void cost2tick(llvm::Module *M, const BlockCostMapType &blockCostMap);
 
     void extractKoatCostRelationSystem(const std::string &bitcodePath, const std::string &koatCRSPath);
@@ -18,9 +68,29 @@ public:
 
     std::string parseCoFloCoOutput(const std::string &path);
     std::string readCRSAndSolveUpperBound(const std::string &CRSFilePath);
+    std::string readCRSAndSolveUpperBoundByComponents(const std::string &CRSFilePath, unsigned int numJobs);
+
+    // Extract and solve with every configuration concurrently. Either
+    // the first finite bound wins and the other solves are cancelled, or
+    // all of them run to completion and the tightest bound is taken.
+    std::string solveUpperBoundWithPortfolio(llvm::Module *M, const std::vector<SolverConfiguration> &configurations, bool stopAtFirstFiniteBound);
+
+    // Extract and solve the bound of each function separately from the same
+    // bitcode, numJobs at a time. Functions without a bound get an empty
+    // string.
+    std::vector<std::string> solveUpperBoundForEachFunction(llvm::Module *M, const std::vector<std::string> &functionNames, unsigned int numJobs);
 
     std::string removeNat(const std::string &exp);
     std::string replaceNatWithMax(const std::string &exp);
+
+private:
+    int runStage(const std::string &program, const std::vector<std::string> &args, const std::string &outputPath, unsigned int timeoutSeconds);
+
+    SolverConfiguration configuration;
+    const std::atomic<bool> *cancelled = nullptr;
+    Deadline deadline;
+    SolverPool *solverPool = nullptr;
+    std::atomic<bool> timedOut{false};
 };
 
 } // end namespace gpscat
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <gpscat/CoFloCoWrapper.h>
+#include <gpscat/Deadline.h>
+
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/InstrTypes.h>
+
+#include <atomic>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gpscat {
+
+// Analyzes a module bottom-up along its call graph instead of inlining:
+// every function is solved once, without inlining, into a bound over its
+// parameters, and each call to it is replaced by tick(bound) in its callers.
+// Functions of recursive call graph cycles, and their callers, get oo.
+class CompositionalAnalyzer {
+public:
+    CompositionalAnalyzer(const SolverConfiguration &configuration, unsigned int numJobs)
+        : configuration(configuration), numJobs(numJobs) {}
+
+    void setDeadline(const Deadline &deadline) {
+        this->deadline = deadline;
+    }
+
+    void setSolverPool(SolverPool *solverPool) {
+        this->solverPool = solverPool;
+    }
+
+    bool hasTimedOut() const {
+        return timedOut;
+    }
+
+    // Summarize entryName and every function it reaches. M must already
+    // carry the tick calls of cost2tick. Calls to summarized functions are
+    // rewritten in a copy; M only gets names for unnamed parameters.
+    // Returns the bound of entryName (main if empty), or an empty string if
+    // it could not be solved.
+    std::string run(llvm::Module *M, const std::string &entryName);
+
+    // Use bound for name instead of solving it, e.g. from an earlier run
+    void addSummary(const std::string &name, const std::string &bound) {
+        summaries[name] = bound;
+    }
+
+    // Bounds of every function summarized so far, over the parameters
+    // named by getBoundVariableName
+    const std::map<std::string, std::string> &getSummaries() const {
+        return summaries;
+    }
+
+    // Replace call by tick(bound), with the parameters of the callee in
+    // bound replaced by the call arguments. bound is computed in i64, and
+    // tick of the module takes an i64 from then on. Returns false and
+    // leaves the call alone when bound cannot be computed.
+    static bool replaceCallBySummary(llvm::CallBase *call, const std::string &bound);
+
+    // replaceCallBySummary for every (call, bound), all or nothing: returns
+    // false and leaves every call alone when one bound cannot be computed
+    static bool replaceCallsBySummaries(const std::vector<std::pair<llvm::CallBase*, std::string>> &calls);
+
+private:
+    std::string summarize(llvm::Module *M, const std::string &entryName);
+    std::vector<llvm::CallBase*> getSummarizedCalls(llvm::Function &F) const;
+    std::string writeFunctionBitcode(llvm::Module *M, llvm::Function *F);
+    std::string solveFunction(const std::string &bitcodePath, const std::string &name);
+
+    SolverConfiguration configuration;
+    unsigned int numJobs;
+    Deadline deadline;
+    SolverPool *solverPool = nullptr;
+    std::atomic<bool> timedOut{false};
+    std::map<std::string, std::string> summaries;
+};
+
+} // end namespace gpscat
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Function.h>
+
+namespace gpscat {
+
+// Removes the computations that can neither influence control flow nor
+// the arguments of calls (including the tick calls inserted by cost2tick).
+// Their results are replaced with undef, which llvm2kittel treats as
+// unknown values, so the extracted cost relation system only carries the
+// variables that matter for the bound.
+class ControlSlicer {
+public:
+    void run(llvm::Module *M);
+
+private:
+    void slice(llvm::Function &F);
+};
+
+} // end namespace gpscat
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace gpscat {
+
+// A Prolog term such as eval_f_bb1_in(V_arg0,V_1+1,B)
+class CostTerm {
+public:
+    std::string name;
+    std::vector<std::string> args;
+
+    static CostTerm parse(const std::string &str);
+    std::string str() const;
+};
+
+// eq(Head, Cost, [Calls], [Constraints]).
+class CostEquation {
+public:
+    CostTerm head;
+    std::string cost;
+    std::vector<CostTerm> calls;
+    std::string constraints;
+
+    std::string str() const;
+};
+
+// Cost equation system in the CoFloCo input format, as produced by cfg2ces.pl
+class CostEquationSystem {
+public:
+    using Component = std::vector<std::string>;
+
+    static CostEquationSystem parse(const std::string &text);
+    static CostEquationSystem readFile(const std::string &path);
+
+    std::string str() const;
+    void writeFile(const std::string &path) const;
+
+    const std::vector<CostEquation> &getEquations() const {
+        return equations;
+    }
+
+    // Name of the equation the bound is computed for
+    std::string getEntryName() const;
+
+    // Strongly connected components of the call graph between equation
+    // names, callees before callers
+    std::vector<Component> getComponents() const;
+    bool isRecursive(const Component &component) const;
+
+    // Names of the component members called from equations outside of it
+    std::vector<std::string> getComponentEntries(const Component &component) const;
+
+    // Head with a variable per argument, as used in input_output_vars
+    CostTerm getFormalHead(const std::string &name) const;
+
+    // The equations reachable from name, with name as the entry
+    CostEquationSystem extract(const std::string &name) const;
+
+    // Replace every call to name made from outside of component by the
+    // bound of name, added to the cost of the calling equation. Only
+    // constant and polynomial bounds can be substituted.
+    bool substituteBound(const std::string &name, const std::string &bound, const Component &component);
+
+    // Drop the equations which cannot be reached from the entry
+    void removeUnreachable();
+
+private:
+    std::set<std::string> getReachable(const std::string &name) const;
+
+    std::string entry;
+    std::vector<std::pair<std::string, std::string>> ioVars;
+    std::vector<std::string> otherClauses;
+    std::vector<CostEquation> equations;
+};
+
+} // end namespace gpscat
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class LLVMContext;
+class Module;
+namespace orc {
+class LLJIT;
+} // end namespace orc
+} // end namespace llvm
+
+namespace gpscat {
+
+// Runs a function of a module that cost2tick annotated under a JIT on the
+// host, with a tick that adds up the costs it is called with. The module
+// is compiled for the host whatever its target, so only code that does not
+// depend on the target can be run.
+class CostExecutor {
+public:
+    // Takes over the module and its context. Throws std::runtime_error if
+    // the function is missing, has parameters other than integers, or the
+    // module cannot be compiled for the host.
+    CostExecutor(std::unique_ptr<llvm::LLVMContext> context, std::unique_ptr<llvm::Module> M, const std::string &functionName);
+    ~CostExecutor();
+
+    std::size_t getNumParameters() const {
+        return numParameters;
+    }
+
+    // Cost the ticks of one call with these arguments add up to. Each call
+    // runs in a child process, so the function may crash or write to
+    // memory it should not. Empty if the call does not return, within
+    // timeoutSeconds unless that is 0.
+    std::optional<std::int64_t> run(const std::vector<std::int64_t> &args, unsigned int timeoutSeconds) const;
+
+private:
+    std::unique_ptr<llvm::orc::LLJIT> jit;
+    std::size_t numParameters = 0;
+    std::int64_t *counter = nullptr;
+    void (*entry)(const std::int64_t*) = nullptr;
+};
+
+} // end namespace gpscat
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace gpscat {
+
+// Fits the costs of a model to measured kernels by ordinary least
+// squares, for gpscat-calibrate. The value of each observation is the sum
+// of its counts times the costs of their variables.
+
+// One measurement: pairs of variable and count, and the measured value
+struct CostObservation {
+    std::vector<std::pair<std::size_t, unsigned int>> counts;
+    double value;
+};
+
+struct CostFit {
+    // Zero for variables no observation counts
+    std::vector<double> costs;
+    // Half width of the 95% confidence interval of each cost
+    std::vector<double> halfWidths;
+    std::vector<bool> observed;
+    // Degrees of freedom of the residuals: observations less observed
+    // variables
+    std::size_t degreesOfFreedom = 0;
+};
+
+// The residual variance is RSS / (m - p) for m observations and p
+// observed variables, and the intervals are the quantiles of Student's t
+// with m - p degrees of freedom times the standard errors. Returns false
+// if there are not more observations than observed variables or the
+// observed variables cannot be told apart.
+bool fitCosts(const std::vector<CostObservation> &observations, std::size_t numVariables, CostFit &fit);
+
+// The 97.5% quantile of Student's t distribution
+double getStudentQuantile975(std::size_t degreesOfFreedom);
+
+} // end namespace gpscat
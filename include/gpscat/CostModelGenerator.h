@@ -0,0 +1,78 @@
+#pragma once
+
+#include <llvm/ADT/Triple.h>
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class MCAsmInfo;
+class MCInstPrinter;
+class MCInstrInfo;
+class MCRegisterInfo;
+class MCSubtargetInfo;
+class Target;
+} // end namespace llvm
+
+namespace gpscat {
+
+// Derives a cost model from the scheduling model LLVM has for a
+// processor, so that targets without a hand-written cost table can be
+// analyzed. Opcodes are keyed by the mnemonic llc prints for them.
+class CostModelGenerator {
+public:
+    enum class Aggregate { Median, Max, Min };
+
+    struct Options {
+        // How the costs of opcodes printed with the same mnemonic are
+        // combined
+        Aggregate aggregate = Aggregate::Median;
+        // Factor applied to cycles before rounding them up to integer costs
+        unsigned int scale = 1;
+
+        std::ostream *log = nullptr;
+        int verbosity = 0;
+    };
+
+    struct Entry {
+        std::string mnemonic;
+        std::int64_t latency;
+        std::int64_t throughput;
+    };
+
+    // The target is looked up like llc does for -march and -mtriple, with
+    // the default triple when triple is empty. Throws std::runtime_error if
+    // it is unknown, cannot print instructions or the processor has no
+    // scheduling model.
+    CostModelGenerator(const std::string &arch, const std::string &triple, const std::string &cpu, const std::string &features);
+    ~CostModelGenerator();
+
+    // One entry per mnemonic, sorted by mnemonic
+    std::vector<Entry> generate(const Options &options);
+
+    // Mnemonics of the last generate which got no entry because none of
+    // their opcodes has a scheduling class that the opcode alone resolves
+    const std::vector<std::string> &getUnscheduledMnemonics() const {
+        return unscheduledMnemonics;
+    }
+
+    // The Cost column holds the latency, or the reciprocal throughput
+    // without latencyFirst; the other one gets its own column
+    static std::string toCSV(const std::vector<Entry> &entries, bool latencyFirst);
+
+private:
+    llvm::Triple triple;
+    const llvm::Target *target = nullptr;
+    std::unique_ptr<llvm::MCRegisterInfo> MRI;
+    std::unique_ptr<llvm::MCAsmInfo> MAI;
+    std::unique_ptr<llvm::MCInstrInfo> MII;
+    std::unique_ptr<llvm::MCSubtargetInfo> STI;
+    std::unique_ptr<llvm::MCInstPrinter> printer;
+
+    std::vector<std::string> unscheduledMnemonics;
+};
+
+} // end namespace gpscat
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+namespace gpscat {
+
+// A point in time by which a whole analysis has to be finished. Every
+// stage asks for the time left instead of using its own budget.
+class Deadline {
+public:
+    // Never expires
+    Deadline() = default;
+
+    // 0 seconds means no deadline
+    static Deadline after(unsigned int seconds) {
+        Deadline deadline;
+        if(seconds) {
+            deadline.isSet = true;
+            deadline.time = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+        }
+        return deadline;
+    }
+
+    bool expired() const {
+        return isSet && std::chrono::steady_clock::now() >= time;
+    }
+
+    // Seconds left, rounded up; 0 if there is no deadline
+    unsigned int remainingSeconds() const {
+        if(!isSet)
+            return 0;
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(time - std::chrono::steady_clock::now()).count();
+        return remaining <= 0 ? 1 : static_cast<unsigned int>((remaining + 999) / 1000);
+    }
+
+    // Timeout of a stage whose own budget is timeoutSeconds (0 is unlimited)
+    unsigned int clamp(unsigned int timeoutSeconds) const {
+        if(!isSet)
+            return timeoutSeconds;
+        return timeoutSeconds ? std::min(timeoutSeconds, remainingSeconds()) : remainingSeconds();
+    }
+
+private:
+    bool isSet = false;
+    std::chrono::steady_clock::time_point time;
+};
+
+} // end namespace gpscat
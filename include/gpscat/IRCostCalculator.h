@@ -3,7 +3,6 @@
 #include <gpscat/AssemblyCostModel.h>
 #include <gpscat/MappingExtractor.h>
 
-#include <llvm/IR/InstVisitor.h>
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/Instruction.h>
 
@@ -12,45 +11,43 @@
 
 namespace gpscat {
 
-using InstCostMapType = std::unordered_map<llvm::Instruction*, CostTy>;
 using BlockCostMapType = std::unordered_map<llvm::BasicBlock*, CostTy>;
 
-class IRCostCalculator : public llvm::InstVisitor<IRCostCalculator> {
+class IRCostCalculator {
 public:
     IRCostCalculator() = delete;
-    IRCostCalculator(llvm::Module *M, const AssemblyCostModel &costModel, const IRAsmMapType &IRAsmMap)
-                        : costModel(costModel), IRAsmMap(IRAsmMap) {
-        visit(M);
-    }
-
-    void visitInstruction(llvm::Instruction &I);
+    // Scheduled costs, indexed by instruction ID, replace the costs of the
+    // first resource when given
+    IRCostCalculator(llvm::Module *M, const AssemblyCostModel &costModel, const IRAsmMapping &mapping,
+                     const std::vector<CostTy> &scheduledCosts = {});
 
-    CostTy getInstCost(llvm::Instruction *I) const {
-        auto it = instCostMap.find(I);
-        return it == instCostMap.end() ? 0 : it->second;
-    }
-    CostTy getBlockCost(llvm::BasicBlock *BB) const {
-        auto it = blockCostMap.find(BB);
-        return it == blockCostMap.end() ? 0 : it->second;
+    std::size_t getNumResources() const {
+        return numResources;
     }
 
-    const InstCostMapType &getInstCostMap() const {
-        return instCostMap;
-    }
-    const BlockCostMapType &getBlockCostMap() const {
-        return blockCostMap;
+    // Instructions are looked up by the ID IRLocator gave them. An ID which
+    // several instructions of M carry counts for the first of them only.
+    CostTy getInstCost(const llvm::Instruction *I, std::size_t resource = 0) const {
+        const llvm::DebugLoc &loc = I->getDebugLoc();
+        return loc && loc.getLine() < numIDs && instructions[loc.getLine()] == I ? instCosts[resource * numIDs + loc.getLine()] : 0;
     }
+    CostTy getBlockCost(const llvm::BasicBlock *BB, std::size_t resource = 0) const;
+
+    BlockCostMapType getBlockCostMap(std::size_t resource = 0) const;
 
     void generateInstCostMetadata(llvm::Module *M) const;
     void generateBlockCostMetadata(llvm::Module *M) const;
 
 private:
-    // notice that they are references!
-    const AssemblyCostModel &costModel;
-    const IRAsmMapType &IRAsmMap;
-
-    InstCostMapType instCostMap;
-    BlockCostMapType blockCostMap;
+    llvm::Module *M;
+    std::size_t numResources;
+    std::size_t numIDs;
+
+    // The costs of every instruction ID for the first resource, then for
+    // the second, and so on
+    std::vector<CostTy> instCosts;
+    // The instruction of M each ID belongs to
+    std::vector<const llvm::Instruction*> instructions;
 };
 
 } // end namespace gpscat
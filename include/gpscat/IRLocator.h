@@ -1,12 +1,38 @@
 #pragma once
 
+#include <gpscat/SourceLocation.h>
+
 #include <llvm/IR/Module.h>
 
+#include <string>
+#include <vector>
+
 namespace gpscat {
 
+// Gives every instruction of the defined functions an ID, dense from 1 in
+// module order, as the line of its debug location. llc writes the lines
+// into the assembly, which is how MappingExtractor finds the instructions
+// an IR instruction became. Existing debug info is removed. Nothing but
+// one subprogram per function and the locations is created.
 class IRLocator {
 public:
     void run(llvm::Module *M);
+
+    // The locations the instructions had in the source before run
+    // replaced them, indexed by ID
+    const std::vector<SourceLocation> &getSourceLocations() const {
+        return sourceLocations;
+    }
+
+    // Files the source locations refer to, empty if the module had no
+    // debug info
+    const std::vector<std::string> &getSourceFiles() const {
+        return sourceFiles;
+    }
+
+private:
+    std::vector<SourceLocation> sourceLocations;
+    std::vector<std::string> sourceFiles;
 };
 
 } // end namespace gpscat
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <gpscat/AssemblyCostModel.h>
+#include <gpscat/AnalysisCache.h>
+#include <gpscat/AnalysisResult.h>
+#include <gpscat/Analyzer.h>
+#include <gpscat/Deadline.h>
+
+#include <llvm/IR/Module.h>
+
+namespace gpscat {
+
+// Analyzes successive versions of a module, keeping the results of the
+// earlier ones: only functions whose IR changed are compiled and mapped
+// again, and only bounds which depend on them are solved again. Results
+// stay in memory, or in options.cacheDir if it is set.
+class IncrementalAnalyzer {
+public:
+    // With forgetRemovedFunctions, the results of functions which are not
+    // in the module analyzed last are forgotten, changed ones included.
+    // Off when unrelated modules share functions, as the inputs of a batch
+    // do.
+    IncrementalAnalyzer(const AssemblyCostModel &costModel, const Analyzer::Options &options, bool forgetRemovedFunctions = true)
+        : analyzer(costModel, options), cache(options.cacheDir.empty() ? AnalysisCache() : AnalysisCache(options.cacheDir, options.cacheSizeMB)),
+          deadlineSeconds(options.deadlineSeconds), evictAfterAnalysis(forgetRemovedFunctions || !options.cacheDir.empty()) {}
+
+    // M is modified: it gets the tick calls of its block costs. Each
+    // analysis has options.deadlineSeconds unless a deadline is given.
+    AnalysisResult analyze(llvm::Module *M) {
+        return analyze(M, Deadline::after(deadlineSeconds));
+    }
+    AnalysisResult analyze(llvm::Module *M, const Deadline &deadline);
+
+    // Number of functions compiled and solved by the last analyze call
+    unsigned int getNumCompiled() const {
+        return analyzer.getNumCompiled();
+    }
+    unsigned int getNumSolved() const {
+        return analyzer.getNumSolved();
+    }
+
+private:
+    Analyzer analyzer;
+    AnalysisCache cache;
+    unsigned int deadlineSeconds;
+    // In memory this forgets removed functions, a directory is kept within
+    // its size limit
+    bool evictAfterAnalysis;
+};
+
+} // end namespace gpscat
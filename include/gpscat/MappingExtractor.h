@@ -1,27 +1,54 @@
 #pragma once
 
 #include <gpscat/AssemblyCostModel.h>
-#include <gpscat/AssemblyInstruction.h>
 
+#include <llvm/ADT/ArrayRef.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Instruction.h>
 
 #include <cstdint>
-#include <unordered_map>
+#include <string>
 #include <vector>
 
 namespace gpscat {
 
+// Line numbers given by IRLocator, dense from 1 to the number of instructions
 using InstructionID = std::uint32_t;
-using InstIDPtrMapType = std::unordered_map<InstructionID, llvm::Instruction*>;
 
-using IRIDAsmMapType = std::unordered_map<InstructionID, std::vector<AssemblyInstruction>>;
-using IRAsmMapType = std::unordered_map<llvm::Instruction*, std::vector<AssemblyInstruction>>;
+// Assembly opcodes of each instruction, in the order llc emitted them.
+// All opcodes of a module live in one array, the ones of instruction ID
+// being opcodes[offsets[ID]] up to opcodes[offsets[ID + 1]].
+class IRAsmMapping {
+public:
+    llvm::ArrayRef<OpcodeID> getOpcodes(InstructionID ID) const {
+        if(ID + 1 >= offsets.size())
+            return {};
+        return llvm::makeArrayRef(opcodes.data() + offsets[ID], opcodes.data() + offsets[ID + 1]);
+    }
+
+    // Instructions without a location have no opcodes
+    llvm::ArrayRef<OpcodeID> getOpcodes(const llvm::Instruction *I) const {
+        const llvm::DebugLoc &loc = I->getDebugLoc();
+        return loc ? getOpcodes(loc.getLine()) : llvm::ArrayRef<OpcodeID>();
+    }
+
+    // One past the largest instruction ID with opcodes
+    InstructionID getNumIDs() const {
+        return offsets.empty() ? 0 : static_cast<InstructionID>(offsets.size() - 1);
+    }
+
+private:
+    friend class MappingExtractor;
+
+    std::vector<std::uint32_t> offsets;
+    std::vector<OpcodeID> opcodes;
+};
 
 class MappingExtractor {
 public:
-    IRIDAsmMapType extractMapping(const std::string &path, const AssemblyCostModel &costModel);
-    IRAsmMapType extractMapping(const std::string &path, const AssemblyCostModel &costModel, llvm::Module* M);
+    IRAsmMapping extractMapping(const std::string &path, const AssemblyCostModel &costModel);
+    // Also reports instruction IDs of the assembly which are not in M
+    IRAsmMapping extractMapping(const std::string &path, const AssemblyCostModel &costModel, llvm::Module* M);
 };
 
 } // end namespace gpscat
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gpscat {
+
+// Limits applied to every child process, 0 means unlimited
+struct ResourceLimits {
+    unsigned int memoryLimitMB = 0;
+    unsigned int cpuLimitSeconds = 0;
+};
+
+// Starts every external tool of the process. Children run in their own
+// process group with RLIMIT_AS and RLIMIT_CPU applied, and are only
+// admitted while the number of running children and the sum of their
+// memory limits stay within the global budget. On SIGINT or SIGTERM
+// every process group is killed before the process terminates.
+class ProcessSupervisor {
+public:
+    static ProcessSupervisor &get();
+
+    // maxChildren and memoryBudgetMB of 0 are unlimited. Children reserve
+    // their memory limit from the budget, so a budget needs a memory limit
+    // per child: without one, false is returned and nothing is changed.
+    bool configure(unsigned int maxChildren, unsigned int memoryBudgetMB, const ResourceLimits &childLimits);
+
+    void installSignalHandlers();
+
+    // Runs program to completion with its stdout redirected to outputPath
+    // (unless empty). The child is killed after timeoutSeconds (0 waits
+    // forever), counted from the call including the wait for admission,
+    // or as soon as *cancelled becomes true. Returns the exit code, or -1
+    // if the program could not be started or was killed.
+    int run(const std::string &program, const std::vector<std::string> &args, const std::string &outputPath,
+            unsigned int timeoutSeconds, const std::atomic<bool> *cancelled = nullptr);
+
+    // For children which are not started by run, such as solver workers.
+    // Like fork, but the child gets its process group and limits before
+    // 0 is returned to it, and the group is registered before the parent
+    // gets the pid. Returns -1 if fork fails or every slot to register a
+    // group is taken, in which case the child has been killed.
+    pid_t forkChild();
+    void unregisterProcessGroup(pid_t pgid);
+    static void killProcessGroup(pid_t pgid);
+
+    unsigned int getNumRunning() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return numRunning;
+    }
+
+private:
+    ProcessSupervisor() = default;
+
+    void prepareChild() const;
+    bool registerProcessGroup(pid_t pgid);
+
+    mutable std::mutex mutex;
+    std::condition_variable admissionCondition;
+    unsigned int maxChildren = 0;
+    unsigned int memoryBudgetMB = 0;
+    ResourceLimits childLimits;
+
+    unsigned int numRunning = 0;
+    unsigned int reservedMemoryMB = 0;
+};
+
+} // end namespace gpscat
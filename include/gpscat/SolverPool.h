@@ -0,0 +1,53 @@
+#pragma once
+
+#include <gpscat/Subprocess.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gpscat {
+
+// Keeps solver worker processes alive across queries, so that the
+// interpreter startup and program load are paid only once per worker.
+//
+// Protocol, one line each way:
+//   request:  <path of the cost equation system>[\t<argument>]...
+//   response: ok <cost upper bound>
+//             error <message>
+//
+// The arguments of a request are cofloco options of that query alone,
+// such as -solve_fast. A worker which crashes, answers garbage or does
+// not answer within the timeout is killed and replaced by a fresh one on
+// its next use.
+class SolverPool {
+public:
+    SolverPool(const std::string &program, const std::vector<std::string> &args, unsigned int numWorkers, unsigned int timeoutSeconds);
+
+    // Returns the bound, or an empty string if the query failed. A
+    // timeout of 0 uses the timeout of the pool.
+    std::string solve(const std::string &CRSFilePath, unsigned int timeoutSeconds = 0, const std::vector<std::string> &queryArgs = {});
+
+    unsigned int getNumRecycledWorkers() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return numRecycledWorkers;
+    }
+
+private:
+    std::size_t acquire();
+    void release(std::size_t slot);
+
+    const std::string program;
+    const std::vector<std::string> args;
+    const unsigned int timeoutSeconds;
+
+    mutable std::mutex mutex;
+    std::condition_variable idleCondition;
+    std::vector<std::unique_ptr<Subprocess>> workers;
+    std::vector<std::size_t> idleSlots;
+    unsigned int numRecycledWorkers = 0;
+};
+
+} // end namespace gpscat
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+namespace gpscat {
+
+// Where an instruction came from in the program source, according to the
+// debug info the input had. The file is an index into a table of file
+// names kept next to the locations. Line 0 means the instruction had no
+// location.
+struct SourceLocation {
+    std::uint32_t file = 0;
+    std::uint32_t line = 0;
+};
+
+} // end namespace gpscat
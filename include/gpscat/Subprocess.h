@@ -0,0 +1,38 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+namespace gpscat {
+
+// A child process whose stdin and stdout are connected to us, for
+// exchanging line-based messages with long-running helper programs.
+class Subprocess {
+public:
+    Subprocess(const std::string &program, const std::vector<std::string> &args);
+    ~Subprocess();
+
+    Subprocess(const Subprocess&) = delete;
+    Subprocess &operator=(const Subprocess&) = delete;
+
+    bool isRunning();
+
+    bool writeLine(const std::string &line);
+    // Returns false on timeout, end of file or error
+    bool readLine(std::string &line, unsigned int timeoutSeconds);
+
+    void kill();
+
+    pid_t getPid() const {
+        return pid;
+    }
+
+private:
+    pid_t pid = -1;
+    int fd = -1;
+    std::string buffer;
+};
+
+} // end namespace gpscat
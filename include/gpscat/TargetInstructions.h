@@ -0,0 +1,44 @@
+#pragma once
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/MC/MCInst.h>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class MCInstPrinter;
+class MCInstrInfo;
+class MCRegisterInfo;
+class MCSubtargetInfo;
+} // end namespace llvm
+
+namespace gpscat {
+
+// Helpers of the tools that derive cost models from the MC layer of a
+// target, where opcodes are only known by number.
+
+// An instance of the opcode with placeholder operands: the first register
+// of each register class and zero immediates
+llvm::MCInst createPlaceholder(unsigned int opcode, const llvm::MCInstrInfo &MII, const llvm::MCRegisterInfo &MRI);
+
+// The instruction as the printer writes it, on one line without
+// surrounding whitespace
+std::string printInstruction(const llvm::MCInst &inst, llvm::MCInstPrinter &printer, const llvm::MCSubtargetInfo &STI);
+
+// The first token of a printed instruction, which is what
+// MappingExtractor looks up in a cost model
+llvm::StringRef getMnemonic(llvm::StringRef text);
+
+// Calls produce for 0 up to count - 1 in a child process and returns the
+// lines it produced. Printers and instructions may crash on placeholder
+// operands, so when the child dies the index it was at gets an empty
+// line and a new child continues with the next one. A call of produce
+// which takes longer than timeoutSeconds (0 for no limit) kills the child
+// the same way. The lines must not contain newlines.
+std::vector<std::string> runIsolated(std::size_t count, const std::function<std::string(std::size_t)> &produce,
+                                     unsigned int timeoutSeconds = 0);
+
+} // end namespace gpscat
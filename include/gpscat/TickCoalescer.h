@@ -0,0 +1,25 @@
+#pragma once
+
+#include <gpscat/IRCostCalculator.h>
+
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/Analysis/LoopInfo.h>
+
+namespace gpscat {
+
+// Moves block costs onto as few blocks as possible without changing the
+// cost of any path, so that cost2tick emits fewer tick calls and the
+// extracted cost relation system carries fewer cost terms.
+class TickCoalescer {
+public:
+    BlockCostMapType run(llvm::Module *M, const BlockCostMapType &blockCostMap);
+
+private:
+    bool coalesceChains(llvm::Function &F, BlockCostMapType &costs);
+    bool coalesceBranchArms(llvm::Function &F, BlockCostMapType &costs);
+    bool coalesceIntoLoopHeaders(llvm::LoopInfo &LI, const llvm::DominatorTree &DT, BlockCostMapType &costs);
+};
+
+} // end namespace gpscat
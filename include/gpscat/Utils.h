@@ -1,6 +1,7 @@
 #pragma once
 
 #include <llvm/IR/Module.h>
+#include <llvm/Support/ErrorOr.h>
 
 #include <vector>
 #include <string>
@@ -13,4 +14,13 @@ void writeBitcodeFile(llvm::Module *M, const std::string &path);
 
 std::vector<std::string> split(const std::string &str);
 
+// llvm::sys::findProgramByName, but the PATH is searched only once per
+// program for the lifetime of the process
+llvm::ErrorOr<std::string> findProgram(const std::string &name);
+
+// The variable a bound of the solver names parameter arg by: V_ and its
+// name with '.' replaced by '_', as llvm2kittel writes it. Unnamed
+// parameters are taken as arg<number>.
+std::string getBoundVariableName(const llvm::Argument &arg);
+
 } // end namespace gpscat
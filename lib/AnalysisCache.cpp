@@ -0,0 +1,325 @@
+#include <gpscat/AnalysisCache.h>
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Metadata.h>
+#include <llvm/IR/Operator.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <utime.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+namespace gpscat {
+
+AnalysisCache::AnalysisCache(const std::string &directory, std::uint64_t maxSizeMB)
+    : directory(directory), maxSizeBytes(maxSizeMB * 1024 * 1024) {
+    llvm::sys::fs::create_directories(directory);
+}
+
+std::string AnalysisCache::getPath(const std::string &key) const {
+    return directory + "/" + key;
+}
+
+bool AnalysisCache::lookup(const std::string &key, std::string &value) {
+    if(directory.empty()) {
+        auto it = entries.find(key);
+        if(it == entries.end())
+            return false;
+        value = it->second;
+        usedKeys.insert(key);
+        return true;
+    }
+
+    std::string path = getPath(key);
+    std::ifstream inputFile(path);
+    if(!inputFile)
+        return false;
+
+    std::stringstream buffer;
+    buffer << inputFile.rdbuf();
+    value = buffer.str();
+
+    // The modification time doubles as the last use for eviction
+    ::utime(path.c_str(), nullptr);
+    return true;
+}
+
+void AnalysisCache::store(const std::string &key, const std::string &value) {
+    if(directory.empty()) {
+        entries[key] = value;
+        usedKeys.insert(key);
+        return;
+    }
+
+    // Readers either see the old entry, the new one or none, never a
+    // partially written file
+    int fd;
+    llvm::SmallString<128> tmpPath;
+    if(llvm::sys::fs::createUniqueFile(getPath(key) + "-%%%%%%.tmp", fd, tmpPath))
+        return;
+    {
+        llvm::raw_fd_ostream tmpFileStream(fd, true);
+        tmpFileStream << value;
+    }
+    if(llvm::sys::fs::rename(tmpPath, getPath(key)))
+        llvm::sys::fs::remove(tmpPath);
+}
+
+bool AnalysisCache::lookupBlockCosts(const std::string &key, std::vector<CostTy> &blockCosts) {
+    std::string value;
+    if(!lookup(key, value))
+        return false;
+
+    std::istringstream iss(value);
+    blockCosts.clear();
+    CostTy cost;
+    while(iss >> cost)
+        blockCosts.push_back(cost);
+    return true;
+}
+
+void AnalysisCache::storeBlockCosts(const std::string &key, const std::vector<CostTy> &blockCosts) {
+    std::string value;
+    for(CostTy cost : blockCosts)
+        value += std::to_string(cost) + "\n";
+    store(key, value);
+}
+
+void AnalysisCache::evict() {
+    if(directory.empty()) {
+        for(auto it = entries.begin(); it != entries.end();)
+            it = usedKeys.count(it->first) ? std::next(it) : entries.erase(it);
+        usedKeys.clear();
+        return;
+    }
+
+    using Clock = std::chrono::system_clock;
+
+    std::vector<std::tuple<Clock::time_point, std::uint64_t, std::string>> entries; // (last use, size, path)
+    std::uint64_t totalSize = 0;
+
+    std::error_code ec;
+    for(llvm::sys::fs::directory_iterator it(directory, ec), end; it != end && !ec; it.increment(ec)) {
+        llvm::sys::fs::file_status status;
+        if(llvm::sys::fs::status(it->path(), status) || status.type() != llvm::sys::fs::file_type::regular_file)
+            continue;
+
+        // Temporary files belong to a running writer, unless it died long ago
+        if(llvm::StringRef(it->path()).endswith(".tmp")) {
+            if(Clock::now() - status.getLastModificationTime() > std::chrono::hours(1))
+                llvm::sys::fs::remove(it->path());
+            continue;
+        }
+
+        entries.emplace_back(status.getLastModificationTime(), status.getSize(), it->path());
+        totalSize += status.getSize();
+    }
+
+    std::sort(entries.begin(), entries.end());
+    for(const auto &entry : entries) {
+        if(totalSize <= maxSizeBytes)
+            break;
+        // Another process may have removed it already
+        llvm::sys::fs::remove(std::get<2>(entry));
+        totalSize -= std::get<1>(entry);
+    }
+}
+
+std::string AnalysisCache::hash(const std::string &data) {
+    llvm::MD5 md5;
+    md5.update(data);
+    llvm::MD5::MD5Result result;
+    md5.final(result);
+    return std::string(result.digest().str());
+}
+
+std::string AnalysisCache::hashFile(const std::string &path) {
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if(!buffer)
+        return std::string();
+    return hash((*buffer)->getBuffer().str());
+}
+
+// What the opcode and operands leave out but changes the generated code
+// or the bound
+static void printFlags(const llvm::Instruction &I, llvm::raw_ostream &os) {
+    if(auto *op = llvm::dyn_cast<llvm::OverflowingBinaryOperator>(&I)) {
+        if(op->hasNoUnsignedWrap()) os << " nuw";
+        if(op->hasNoSignedWrap()) os << " nsw";
+    }
+    if(auto *op = llvm::dyn_cast<llvm::PossiblyExactOperator>(&I))
+        if(op->isExact())
+            os << " exact";
+    if(llvm::isa<llvm::FPMathOperator>(&I)) {
+        os << ' ';
+        I.getFastMathFlags().print(os);
+    }
+    if(auto *load = llvm::dyn_cast<llvm::LoadInst>(&I))
+        os << (load->isVolatile() ? " volatile" : "") << " align" << load->getAlignment()
+           << " order" << static_cast<int>(load->getOrdering());
+    if(auto *store = llvm::dyn_cast<llvm::StoreInst>(&I))
+        os << (store->isVolatile() ? " volatile" : "") << " align" << store->getAlignment()
+           << " order" << static_cast<int>(store->getOrdering());
+    if(auto *alloca = llvm::dyn_cast<llvm::AllocaInst>(&I))
+        os << " align" << alloca->getAlignment();
+    if(auto *call = llvm::dyn_cast<llvm::CallBase>(&I)) {
+        os << " cc" << call->getCallingConv() << ' ';
+        call->getAttributes().print(os);
+        if(auto *callInst = llvm::dyn_cast<llvm::CallInst>(&I))
+            os << (callInst->isTailCall() ? " tail" : "");
+    }
+}
+
+std::string AnalysisCache::getFunctionHash(const llvm::Function &F) {
+    std::string text;
+    llvm::raw_string_ostream os(text);
+
+    // Values are referred to by their position instead of their name
+    std::map<const llvm::Value*, unsigned int> slots;
+    unsigned int nextSlot = 0;
+    for(auto &&arg : F.args())
+        slots[&arg] = nextSlot++;
+    for(auto &&BB : F) {
+        slots[&BB] = nextSlot++;
+        for(auto &&I : BB)
+            slots[&I] = nextSlot++;
+    }
+
+    F.getFunctionType()->print(os);
+    for(auto &&arg : F.args())
+        os << ' ' << arg.getName();
+    // Attributes like optnone change the code llc generates
+    os << " cc" << F.getCallingConv() << ' ';
+    F.getAttributes().print(os);
+    os << '\n';
+
+    // Globals the function reads, directly or inside constant expressions
+    std::set<const llvm::GlobalVariable*> globals;
+    std::vector<const llvm::Constant*> constants;
+
+    for(auto &&BB : F) {
+        os << "bb" << slots[&BB] << ":\n";
+        for(auto &&I : BB) {
+            if(llvm::isa<llvm::DbgInfoIntrinsic>(I))
+                continue;
+
+            os << '%' << slots[&I] << " = " << I.getOpcodeName() << ' ';
+            I.getType()->print(os);
+            if(auto *cmp = llvm::dyn_cast<llvm::CmpInst>(&I))
+                os << " pred" << cmp->getPredicate();
+            if(auto *alloca = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+                os << ' ';
+                alloca->getAllocatedType()->print(os);
+            }
+            if(auto *gep = llvm::dyn_cast<llvm::GetElementPtrInst>(&I)) {
+                os << ' ';
+                gep->getSourceElementType()->print(os);
+                if(gep->isInBounds())
+                    os << " inbounds";
+            }
+            printFlags(I, os);
+
+            for(const llvm::Value *operand : I.operand_values()) {
+                os << ", ";
+                auto slot = slots.find(operand);
+                if(slot != slots.end()) {
+                    os << '%' << slot->second;
+                    continue;
+                }
+
+                if(auto *GV = llvm::dyn_cast<llvm::GlobalValue>(operand))
+                    os << '@' << GV->getName();
+                else if(llvm::isa<llvm::MetadataAsValue>(operand))
+                    os << "metadata";
+                else
+                    operand->print(os);
+                if(auto *constant = llvm::dyn_cast<llvm::Constant>(operand))
+                    constants.push_back(constant);
+            }
+
+            // Which value comes from which predecessor
+            if(auto *phi = llvm::dyn_cast<llvm::PHINode>(&I))
+                for(const llvm::BasicBlock *incoming : phi->blocks())
+                    os << ", from bb" << slots[incoming];
+            os << '\n';
+        }
+    }
+
+    while(!constants.empty()) {
+        const llvm::Constant *constant = constants.back();
+        constants.pop_back();
+        if(auto *GV = llvm::dyn_cast<llvm::GlobalVariable>(constant)) {
+            globals.insert(GV);
+            continue;
+        }
+        if(llvm::isa<llvm::GlobalValue>(constant))
+            continue;
+        for(const llvm::Value *operand : constant->operand_values())
+            if(auto *operandConstant = llvm::dyn_cast<llvm::Constant>(operand))
+                constants.push_back(operandConstant);
+    }
+
+    // Ordered by name, so the hash does not depend on the use order
+    std::map<std::string, const llvm::GlobalVariable*> orderedGlobals;
+    for(const llvm::GlobalVariable *GV : globals)
+        orderedGlobals[GV->getName().str()] = GV;
+    for(const auto &global : orderedGlobals) {
+        const llvm::GlobalVariable *GV = global.second;
+        os << '@' << global.first << (GV->isConstant() ? " constant " : " global ");
+        if(GV->hasInitializer())
+            GV->getInitializer()->print(os);
+        os << '\n';
+    }
+
+    return hash(os.str());
+}
+
+std::string AnalysisCache::getCalleeClosureHash(const llvm::Function &F) {
+    std::set<const llvm::Function*> visited = {&F};
+    std::vector<const llvm::Function*> worklist = {&F};
+    while(!worklist.empty()) {
+        const llvm::Function *current = worklist.back();
+        worklist.pop_back();
+        for(auto &&BB : *current) {
+            for(auto &&I : BB) {
+                auto *call = llvm::dyn_cast<llvm::CallBase>(&I);
+                if(!call)
+                    continue;
+                const llvm::Function *callee = call->getCalledFunction();
+                if(callee && !callee->isDeclaration() && visited.insert(callee).second)
+                    worklist.push_back(callee);
+            }
+        }
+    }
+
+    // Ordered by name, so the hash does not depend on the call order
+    std::map<std::string, const llvm::Function*> closure;
+    for(const llvm::Function *function : visited)
+        closure[function->getName().str()] = function;
+
+    std::string data = F.getName().str() + "\n";
+    for(const auto &function : closure)
+        data += function.first + " " + getFunctionHash(*function.second) + "\n";
+    return hash(data);
+}
+
+} // end namespace gpscat
@@ -0,0 +1,100 @@
+#include <gpscat/AnalysisResult.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace gpscat {
+
+static std::string quote(const std::string &str) {
+    std::string quoted = "\"";
+    for(char c : str) {
+        switch(c) {
+        case '"': quoted += "\\\""; break;
+        case '\\': quoted += "\\\\"; break;
+        case '\n': quoted += "\\n"; break;
+        case '\t': quoted += "\\t"; break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                quoted += escaped;
+            }
+            else {
+                quoted += c;
+            }
+        }
+    }
+    return quoted + "\"";
+}
+
+std::string AnalysisResult::toJSON() const {
+    static const char *statusNames[] = {"complete", "partial", "failed"};
+
+    std::string json = "{\"status\":" + quote(statusNames[static_cast<int>(status)]);
+    json += ",\"stage\":" + quote(stage);
+    if(!message.empty())
+        json += ",\"message\":" + quote(message);
+
+    json += ",\"functions\":[";
+    for(std::size_t i = 0; i < functionCosts.size(); ++i) {
+        json += (i ? ",{\"name\":" : "{\"name\":") + quote(functionCosts[i].name) + ",\"blockCosts\":[";
+        for(std::size_t j = 0; j < functionCosts[i].blockCosts.size(); ++j)
+            json += (j ? "," : "") + std::to_string(functionCosts[i].blockCosts[j]);
+        json += "]";
+        if(!functionCosts[i].instructionCosts.empty()) {
+            json += ",\"instructionCosts\":[";
+            for(std::size_t j = 0; j < functionCosts[i].instructionCosts.size(); ++j)
+                json += (j ? "," : "") + std::to_string(functionCosts[i].instructionCosts[j]);
+            json += "]";
+        }
+        if(!functionCosts[i].bound.empty())
+            json += ",\"bound\":" + quote(functionCosts[i].bound);
+        json += "}";
+    }
+    json += "]";
+
+    json += ",\"bound\":" + (bound.empty() ? std::string("null") : quote(bound));
+    if(!resourceBounds.empty()) {
+        json += ",\"resourceBounds\":{";
+        for(std::size_t i = 0; i < resourceBounds.size(); ++i)
+            json += (i ? "," : "") + quote(resourceBounds[i].resource) + ":" + (resourceBounds[i].bound.empty() ? std::string("null") : quote(resourceBounds[i].bound));
+        json += "}";
+    }
+    if(score) {
+        // JSON has no infinity
+        char number[32];
+        std::snprintf(number, sizeof(number), "%.17g", *score);
+        json += ",\"score\":" + (std::isfinite(*score) ? std::string(number) : std::string("null"));
+    }
+    return json + "}";
+}
+
+std::string AnalysisResult::toCollapsedStacks() const {
+    std::string stacks;
+    for(const auto &functionCost : functionCosts) {
+        // (file, line) -> cost, line 0 for no location
+        std::map<std::pair<std::uint32_t, std::uint32_t>, std::int64_t> lineCosts;
+        for(std::size_t i = 0; i < functionCost.instructionCosts.size(); ++i) {
+            SourceLocation location;
+            if(i < functionCost.sourceLocations.size() && functionCost.sourceLocations[i].file < sourceFiles.size())
+                location = functionCost.sourceLocations[i];
+            lineCosts[{location.line ? location.file : 0, location.line}] += functionCost.instructionCosts[i];
+        }
+
+        for(const auto &lineCost : lineCosts) {
+            if(!lineCost.second)
+                continue;
+            stacks += functionCost.name;
+            if(lineCost.first.second)
+                stacks += ";" + sourceFiles[lineCost.first.first] + ":" + std::to_string(lineCost.first.second);
+            stacks += " " + std::to_string(lineCost.second) + "\n";
+        }
+    }
+    return stacks;
+}
+
+} // end namespace gpscat
@@ -0,0 +1,344 @@
+#include <gpscat/AnalysisServer.h>
+#include <gpscat/AnalysisCache.h>
+#include <gpscat/BoundExpression.h>
+#include <gpscat/Deadline.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+namespace gpscat {
+
+// A client which stops sending does not hold its worker longer than this
+static const unsigned int receiveTimeoutSeconds = 30;
+static const std::size_t maxHeaderSize = 64 * 1024;
+static const std::size_t maxInputSize = 1024 * 1024 * 1024;
+static const unsigned int numScoreSamples = 10000;
+// Each analyzer keeps the block costs of every function it has seen
+static const std::size_t maxAnalyzersPerWorker = 16;
+
+static unsigned long long parseNumber(const std::string &key, const std::string &value) {
+    if(value.empty() || value.size() > 18 || value.find_first_not_of("0123456789") != std::string::npos)
+        throw std::invalid_argument("Invalid value of " + key + ": " + value);
+    return std::stoull(value);
+}
+
+static bool parseFlag(const std::string &key, const std::string &value) {
+    if(value == "1" || value == "true")
+        return true;
+    if(value == "0" || value == "false")
+        return false;
+    throw std::invalid_argument("Invalid value of " + key + ": " + value);
+}
+
+static std::pair<double, double> parseRange(const std::string &key, const std::string &value) {
+    auto colon = value.find(':');
+    if(colon == std::string::npos)
+        throw std::invalid_argument("Invalid value of " + key + ": " + value);
+
+    std::pair<double, double> range;
+    try {
+        std::size_t end = 0;
+        range.first = std::stod(value.substr(0, colon), &end);
+        if(end != colon)
+            throw std::invalid_argument(value);
+        range.second = std::stod(value.substr(colon + 1), &end);
+        if(end != value.size() - colon - 1)
+            throw std::invalid_argument(value);
+    }
+    catch(const std::logic_error&) {
+        throw std::invalid_argument("Invalid value of " + key + ": " + value);
+    }
+
+    if(range.first > range.second)
+        throw std::invalid_argument("Lower bound is greater than upper bound in " + key);
+    return range;
+}
+
+// Everything an IncrementalAnalyzer keeps depends on the cost model and,
+// for the bounds, on how the solver is configured
+static std::string getAnalyzerKey(const AnalysisServer::Request &request) {
+    const auto &options = request.options;
+    return request.costModelPath + "\n"s + options.arch + "\n"s + options.optLevel + "\n"s + options.cpu + "\n"s
+         + std::to_string(options.scheduleBlocks) + " "s + options.configuration.str() + "\n"s + options.configuration.functionName + "\n"s
+         + std::to_string(options.configuration.timeoutSeconds) + " "s + std::to_string(options.coalesceTicks) + " "s
+         + std::to_string(options.sliceControl) + " "s + std::to_string(options.compositional) + " "s
+         + std::to_string(options.compositionalJobs);
+}
+
+AnalysisServer::~AnalysisServer() {
+    if(listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+}
+
+bool AnalysisServer::listen(const std::string &path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path is too long: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+
+    // Tools the analyzers start must not inherit the sockets, or a
+    // client would wait for the end of its response as long as they run
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(fd < 0) {
+        std::cerr << "Cannot create socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // A socket file nobody accepts on was left behind by a killed server
+    struct stat status;
+    if(lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+        if(connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+            std::cerr << "Another server is listening on " << path << std::endl;
+            close(fd);
+            return false;
+        }
+        unlink(path.c_str());
+    }
+
+    // Requests name files for the server to read, so only our user may
+    // send them. The socket is created with that mode rather than changed
+    // after bind, when others could already have connected.
+    mode_t mask = umask(S_IXUSR | S_IRWXG | S_IRWXO);
+    int bindResult = bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    umask(mask);
+    if(bindResult != 0 || ::listen(fd, SOMAXCONN) != 0) {
+        std::cerr << "Cannot listen on " << path << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        return false;
+    }
+
+    listenFd = fd;
+    socketPath = path;
+    return true;
+}
+
+void AnalysisServer::serve() {
+    if(listenFd < 0)
+        return;
+
+    std::vector<std::thread> threads;
+    for(unsigned int i = 0; i < std::max(numWorkers, 1u); ++i) {
+        threads.emplace_back([this]() {
+            Worker worker;
+            while(!stopping) {
+                int connection = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+                if(connection < 0) {
+                    if(stopping)
+                        break;
+                    // Out of descriptors or an aborted connection, try again
+                    if(errno != EINTR && errno != ECONNABORTED)
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    continue;
+                }
+                serveConnection(worker, connection);
+                close(connection);
+            }
+        });
+    }
+    for(auto &thread : threads)
+        thread.join();
+}
+
+void AnalysisServer::stop() {
+    stopping = true;
+    // Wakes up the workers blocked in accept
+    if(listenFd >= 0)
+        shutdown(listenFd, SHUT_RDWR);
+}
+
+AnalysisServer::Request AnalysisServer::parseRequest(const std::string &header) const {
+    Request request;
+    request.costModelPath = costModelPath;
+    request.options = options;
+
+    bool hasSize = false;
+    for(const auto &token : split(header)) {
+        // A flag without a value is set
+        auto equals = token.find('=');
+        std::string key = token.substr(0, equals);
+        std::string value = equals == std::string::npos ? "1"s : token.substr(equals + 1);
+
+        if(key == "size") {
+            request.size = parseNumber(key, value);
+            hasSize = true;
+        }
+        else if(key == "cost-model") request.costModelPath = value;
+        else if(key == "arch") request.options.arch = value;
+        else if(key == "O") request.options.optLevel = value;
+        else if(key == "mcpu") request.options.cpu = value;
+        else if(key == "schedule-blocks") request.options.scheduleBlocks = parseFlag(key, value);
+        else if(key == "function") request.options.configuration.functionName = value;
+        else if(key == "inline") request.options.configuration.numInlines = parseNumber(key, value);
+        else if(key == "eager-inline") request.options.configuration.eagerInline = parseFlag(key, value);
+        else if(key == "coalesce-ticks") request.options.coalesceTicks = parseFlag(key, value);
+        else if(key == "slice-control") request.options.sliceControl = parseFlag(key, value);
+        else if(key == "compositional") request.options.compositional = parseFlag(key, value);
+        else if(key == "deadline") request.options.deadlineSeconds = parseNumber(key, value);
+        else if(key == "score") request.score = parseFlag(key, value);
+        else if(key.compare(0, 6, "range.") == 0 && key.size() > 6) request.ranges[key.substr(6)] = parseRange(key, value);
+        else throw std::invalid_argument("Unknown option: " + key);
+    }
+
+    if(!hasSize)
+        throw std::invalid_argument("The request has no size");
+    if(request.size > maxInputSize)
+        throw std::invalid_argument("The input is too large");
+    return request;
+}
+
+void AnalysisServer::serveConnection(Worker &worker, int connection) {
+    timeval timeout = {receiveTimeoutSeconds, 0};
+    setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    // Nobody is left to answer when the client hangs up or stalls
+    std::string data;
+    char buffer[4096];
+    std::size_t newline;
+    while((newline = data.find('\n')) == std::string::npos) {
+        if(data.size() > maxHeaderSize)
+            return;
+        ssize_t received = recv(connection, buffer, sizeof(buffer), 0);
+        if(received <= 0)
+            return;
+        data.append(buffer, received);
+    }
+
+    AnalysisResult result;
+    result.stage = "request";
+    try {
+        Request request = parseRequest(data.substr(0, newline));
+
+        std::string input = data.substr(newline + 1, request.size);
+        std::size_t size = input.size();
+        input.resize(request.size);
+        while(size < request.size) {
+            ssize_t received = recv(connection, &input[size], request.size - size, 0);
+            if(received <= 0)
+                return;
+            size += received;
+        }
+
+        result = analyze(worker, request, input);
+    }
+    catch(const std::invalid_argument &e) {
+        result.message = e.what();
+    }
+
+    std::string response = result.toJSON() + "\n"s;
+    std::size_t sent = 0;
+    while(sent < response.size()) {
+        ssize_t n = send(connection, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n <= 0)
+            return;
+        sent += n;
+    }
+}
+
+std::shared_ptr<const AssemblyCostModel> AnalysisServer::getCostModel(const std::string &path, std::string &version) {
+    // Builtin models never change
+    version = AssemblyCostModel::isBuiltin(path) ? path : AnalysisCache::hashFile(path);
+
+    std::lock_guard<std::mutex> lock(costModelMutex);
+    auto it = costModels.find(path);
+    if(it != costModels.end() && it->second.first == version)
+        return it->second.second;
+
+    try {
+        auto costModel = std::make_shared<const AssemblyCostModel>(path);
+        costModels[path] = {version, costModel};
+        return costModel;
+    }
+    catch(const std::exception &e) {
+        costModels.erase(path);
+        std::cerr << "Cannot read cost model " << path << ": " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+AnalysisResult AnalysisServer::analyze(Worker &worker, const Request &request, const std::string &input) {
+    // The deadline starts once the input has arrived
+    Deadline deadline = Deadline::after(request.options.deadlineSeconds);
+    AnalysisResult result;
+
+    // The analyzers only keep hashes and costs, never IR, so every request
+    // gets a fresh context instead of one that grows forever
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseIR(llvm::MemoryBufferRef(input, "request"), err, context);
+    if(!M) {
+        result.stage = "parse";
+        result.message = err.getMessage().str();
+        return result;
+    }
+
+    std::string costModelVersion;
+    std::shared_ptr<const AssemblyCostModel> costModel = getCostModel(request.costModelPath, costModelVersion);
+    if(!costModel) {
+        result.stage = "cost-model";
+        result.message = "cannot read cost model " + request.costModelPath;
+        return result;
+    }
+
+    std::string key = getAnalyzerKey(request) + "\n"s + costModelVersion;
+    if(!worker.analyzers.count(key) && worker.analyzers.size() >= maxAnalyzersPerWorker) {
+        auto leastRecent = std::min_element(worker.analyzers.begin(), worker.analyzers.end(), [](const auto &a, const auto &b) {
+            return a.second.lastUse < b.second.lastUse;
+        });
+        worker.analyzers.erase(leastRecent);
+    }
+
+    auto &entry = worker.analyzers[key];
+    if(!entry.analyzer)
+        entry.analyzer = std::make_unique<IncrementalAnalyzer>(*costModel, request.options);
+    entry.lastUse = ++worker.numUses;
+    result = entry.analyzer->analyze(M.get(), deadline);
+
+    if(request.score && result.status == AnalysisResult::Status::Complete) {
+        try {
+            BoundExpression bound = BoundExpression::parse(result.bound);
+            bool bounded = true;
+            for(const auto &variable : bound.getVariables())
+                bounded &= request.ranges.count(variable) > 0;
+            if(bounded)
+                result.score = bound.estimateMean(request.ranges, numScoreSamples);
+            else
+                result.message = "some variables of the bound have no range";
+        }
+        catch(const std::invalid_argument &e) {
+            result.message = e.what();
+        }
+    }
+    return result;
+}
+
+} // end namespace gpscat
@@ -0,0 +1,565 @@
+#include <gpscat/Analyzer.h>
+#include <gpscat/BlockScheduler.h>
+#include <gpscat/CompositionalAnalyzer.h>
+#include <gpscat/ControlSlicer.h>
+#include <gpscat/IRCostCalculator.h>
+#include <gpscat/IRLocator.h>
+#include <gpscat/MappingExtractor.h>
+#include <gpscat/ProcessSupervisor.h>
+#include <gpscat/SolverPool.h>
+#include <gpscat/TickCoalescer.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Function.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/ValueMapper.h>
+
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace std::literals;
+
+namespace gpscat {
+
+namespace {
+
+// Removes the temporary files of an analysis however it ends
+class TemporaryFiles {
+public:
+    explicit TemporaryFiles(bool keep) : keep(keep) {}
+
+    ~TemporaryFiles() {
+        if(!keep)
+            for(const auto &path : paths)
+                llvm::sys::fs::remove(path);
+    }
+
+    std::string create(const std::string &suffix) {
+        paths.push_back(getTemporaryFilePath("gpscat-cost", suffix));
+        return paths.back();
+    }
+
+private:
+    bool keep;
+    std::vector<std::string> paths;
+};
+
+} // end anonymous namespace
+
+void Analyzer::printProgress(const std::string &message) const {
+    if(options.log && options.verbosity >= 1)
+        *options.log << message << std::endl;
+}
+
+Analyzer::Options Analyzer::withSolverPool(Options options) {
+    if(!options.solverPool && !options.configuration.solverWorker.empty())
+        options.solverPool = std::make_shared<SolverPool>(options.configuration.solverWorker, std::vector<std::string>(),
+                                                          options.configuration.numSolverWorkers, 60);
+    return options;
+}
+
+AnalysisResult Analyzer::analyze(llvm::Module *M) {
+    AnalysisResult result;
+    std::unique_ptr<AnalysisCache> cache;
+    if(!options.cacheDir.empty())
+        cache = std::make_unique<AnalysisCache>(options.cacheDir, options.cacheSizeMB);
+
+    run(M, cache.get(), Deadline::after(options.deadlineSeconds), result);
+
+    if(cache)
+        cache->evict();
+    return result;
+}
+
+AnalysisResult Analyzer::analyze(llvm::Module *M, AnalysisCache &cache, const Deadline &deadline) {
+    AnalysisResult result;
+    run(M, &cache, deadline, result);
+    return result;
+}
+
+std::string Analyzer::getBlockCostKey(const llvm::Function &F, std::size_t resource) const {
+    return getBlockCostKey(getCostContext(*F.getParent()), AnalysisCache::getFunctionHash(F), resource);
+}
+
+std::string Analyzer::getCostContext(const llvm::Module &M) const {
+    // Built-in models have no file, their contents identify them
+    std::string costModelHash = costModelPath.empty() || AssemblyCostModel::isBuiltin(costModelPath) ? AnalysisCache::hash(costModel.toCSV())
+                                                                                                    : AnalysisCache::hashFile(costModelPath);
+    std::string costContext = costModelHash + " -arch="s + options.arch + " -O"s + options.optLevel;
+    if(!options.cpu.empty()) costContext += " -mcpu="s + options.cpu;
+    if(options.scheduleBlocks) costContext += " -schedule-blocks"s;
+    // llc takes both from the module, and the function hashes omit them
+    costContext += " -triple="s + M.getTargetTriple() + " -datalayout="s + M.getDataLayoutStr();
+    return costContext;
+}
+
+std::string Analyzer::getBlockCostKey(const std::string &costContext, const std::string &functionHash, std::size_t resource) const {
+    // The first resource keeps the keys of single resource models
+    std::string resourceContext = resource ? " resource="s + costModel.getResourceName(resource) : ""s;
+    return AnalysisCache::hash("costs "s + costContext + resourceContext + " "s + functionHash);
+}
+
+void Analyzer::run(llvm::Module *M, AnalysisCache *cache, const Deadline &deadline, AnalysisResult &result) {
+    numCompiled = numSolved = 0;
+    TemporaryFiles temporaryFiles(options.keepTemporaryFiles);
+
+    // Each function is solved once, with the plain configuration
+    const std::size_t numResources = costModel.getNumResources();
+    if(options.allFunctions && (options.portfolio || options.compositional || options.componentJobs || numResources > 1)) {
+        result.stage = "options";
+        result.message = "-all-functions cannot be combined with -portfolio, -compositional, -component-jobs or a cost model of several resources";
+        return;
+    }
+
+    auto checkDeadline = [&deadline, &result](const std::string &stage) -> bool {
+        result.stage = stage;
+        if(!deadline.expired())
+            return true;
+        result.status = AnalysisResult::Status::Partial;
+        result.message = "deadline expired";
+        return false;
+    };
+
+    // Unchanged functions take their block costs and bound from the cache,
+    // so that neither llc nor the solver has to run for them again
+    std::vector<BlockCostMapType> blockCostMaps(numResources);
+    std::vector<std::map<const llvm::Function*, std::string>> blockCostKeys(numResources);
+    // Functions without block costs in the cache for some resource
+    std::set<const llvm::Function*> uncached;
+    std::string boundKey;
+    std::string costContext = cache ? getCostContext(*M) : std::string();
+    for(auto &&F : *M) {
+        if(F.isDeclaration())
+            continue;
+        if(!cache) {
+            uncached.insert(&F);
+            continue;
+        }
+
+        std::string functionHash = AnalysisCache::getFunctionHash(F);
+        std::vector<std::vector<CostTy>> functionBlockCosts(numResources);
+        for(std::size_t resource = 0; resource < numResources; ++resource) {
+            blockCostKeys[resource][&F] = getBlockCostKey(costContext, functionHash, resource);
+            if(!cache->lookupBlockCosts(blockCostKeys[resource][&F], functionBlockCosts[resource]) || functionBlockCosts[resource].size() != F.size())
+                uncached.insert(&F);
+        }
+        if(uncached.count(&F))
+            continue;
+        for(std::size_t resource = 0; resource < numResources; ++resource) {
+            std::size_t i = 0;
+            for(auto &&B : F)
+                blockCostMaps[resource][&B] = functionBlockCosts[resource][i++];
+        }
+    }
+    // Function name -> key of its compositional summary
+    std::map<std::string, std::string> summaryKeys;
+    if(cache) {
+        const auto &configuration = options.configuration;
+        std::string solverContext = configuration.str();
+        if(options.coalesceTicks) solverContext += " -coalesce-ticks"s;
+        if(options.sliceControl) solverContext += " -slice-control"s;
+
+        // A summary stays valid as long as neither the function nor
+        // anything it calls has changed
+        if(options.compositional)
+            for(auto &&F : *M)
+                if(!F.isDeclaration())
+                    summaryKeys[F.getName().str()] = AnalysisCache::hash("summary "s + costContext + " "s + solverContext + " "s + AnalysisCache::getCalleeClosureHash(F));
+
+        // The bound also depends on every function the entry can reach
+        solverContext += " -function="s + configuration.functionName;
+        if(options.componentJobs) solverContext += " -component-jobs"s;
+        if(options.compositional) solverContext += " -compositional"s;
+        if(options.portfolio) solverContext += " -portfolio"s + (options.portfolioBest ? "-best"s : ""s) + " -portfolio-timeout="s + std::to_string(options.portfolioTimeout);
+
+        std::string codeHash;
+        llvm::Function *entry = configuration.functionName.empty() ? nullptr : M->getFunction(configuration.functionName);
+        if(entry && !entry->isDeclaration()) {
+            codeHash = AnalysisCache::getCalleeClosureHash(*entry);
+        }
+        else {
+            // Without a function, any function may be part of the analysis
+            for(auto &&F : *M)
+                if(!F.isDeclaration())
+                    codeHash += F.getName().str() + " "s + AnalysisCache::getFunctionHash(F) + "\n"s;
+        }
+        boundKey = AnalysisCache::hash("bound "s + costContext + " "s + solverContext + " "s + codeHash);
+    }
+
+    std::map<const llvm::Function*, std::vector<CostTy>> instructionCosts;
+    std::map<const llvm::Function*, std::vector<SourceLocation>> sourceLocations;
+    if(!uncached.empty()) {
+        if(cache && uncached.size() < blockCostKeys[0].size())
+            printProgress("Using cached LLVM IR block level costs of "s + std::to_string(blockCostKeys[0].size() - uncached.size()) + " functions."s);
+
+        // Cached functions are only declared, so llc compiles the others
+        // alone. The copy also keeps the mapping information out of M.
+        llvm::ValueToValueMapTy VMap;
+        std::unique_ptr<llvm::Module> compiledModule = llvm::CloneModule(*M, VMap, [&uncached](const llvm::GlobalValue *GV) {
+            auto *F = llvm::dyn_cast<llvm::Function>(GV);
+            return !F || uncached.count(F);
+        });
+        llvm::Module *compiled = compiledModule.get();
+
+        // Use IRLocator to create LLVM IR to ASM mapping information
+        printProgress("Creating LLVM IR to ASM mapping information.");
+        if(!checkDeadline("locate")) return;
+
+        IRLocator irLocator;
+        irLocator.run(compiled);
+
+        // Compile this module into target language
+        printProgress("Compiling into target language.");
+        if(!checkDeadline("compile")) return;
+
+        std::string mappingBitcodePath = temporaryFiles.create("map.bc");
+        std::string mappingAsmPath = temporaryFiles.create("map.s");
+        writeBitcodeFile(compiled, mappingBitcodePath);
+
+        llvm::ErrorOr<std::string> llcPath = findProgram("llc");
+        if(std::error_code ec = llcPath.getError()) {
+            result.message = "llc: "s + ec.message();
+            return;
+        }
+        std::vector<std::string> llcArguments = {mappingBitcodePath, "-o"s, mappingAsmPath, "-march="s + options.arch, "-O"s + options.optLevel};
+        if(!options.cpu.empty())
+            llcArguments.push_back("-mcpu="s + options.cpu);
+        ProcessSupervisor::get().run(llcPath.get(), llcArguments, std::string(), deadline.clamp(0));
+        numCompiled = uncached.size();
+
+        // Extract LLVM IR to ASM mapping
+        printProgress("Extract mapping information.");
+        if(!checkDeadline("map")) return;
+
+        MappingExtractor mappingExtractor;
+        const IRAsmMapping mapping = mappingExtractor.extractMapping(mappingAsmPath, costModel, compiled);
+
+        // Print mapping
+        if(options.log && options.verbosity >= 2) {
+            std::ostream &log = *options.log;
+            log << "\n--------LLVM IR to Assembly mapping--------\n";
+            // print LLVM IR instructions by their original order
+            uint32_t lineNumber = 0;
+            for(auto &&F : *compiled) {
+                for(auto &&B : F) {
+                    for(auto &&I : B) {
+                        lineNumber++;
+                        log << lineNumber << '\t';
+
+                        auto &&instOpcodeName = std::string(I.getOpcodeName());
+                        instOpcodeName.resize(20, ' ');
+                        log << instOpcodeName << '\t';
+
+                        for(OpcodeID opcode : mapping.getOpcodes(&I))
+                            log << costModel.getOpcodeName(opcode) << ' ';
+                        log << '\n';
+                    }
+                }
+            }
+            log.flush();
+        }
+
+        std::vector<CostTy> scheduledCosts;
+        if(options.scheduleBlocks) {
+            printProgress("Scheduling assembly blocks.");
+            if(!checkDeadline("schedule")) return;
+
+            try {
+                scheduledCosts = BlockScheduler(options.arch, options.cpu).schedule(mappingAsmPath);
+            }
+            catch(const std::runtime_error &e) {
+                result.message = e.what();
+                return;
+            }
+            if(scheduledCosts.empty()) {
+                result.message = "the assembly could not be scheduled";
+                return;
+            }
+        }
+
+        // Calculate LLVM IR block level costs
+        printProgress("Calculating LLVM IR block level costs.");
+
+        IRCostCalculator irCostCalculator(compiled, costModel, mapping, scheduledCosts);
+
+        // The IDs lead back to where the instructions are in the source
+        result.sourceFiles = irLocator.getSourceFiles();
+        const std::vector<SourceLocation> &locations = irLocator.getSourceLocations();
+        for(auto &&F : *M) {
+            if(!uncached.count(&F))
+                continue;
+            for(auto &&B : F) {
+                auto *compiledBlock = llvm::cast<llvm::BasicBlock>(VMap[&B]);
+                for(std::size_t resource = 0; resource < numResources; ++resource)
+                    blockCostMaps[resource][&B] = irCostCalculator.getBlockCost(compiledBlock, resource);
+
+                for(auto &&I : *compiledBlock) {
+                    instructionCosts[&F].push_back(irCostCalculator.getInstCost(&I));
+                    if(!result.sourceFiles.empty()) {
+                        const llvm::DebugLoc &loc = I.getDebugLoc();
+                        sourceLocations[&F].push_back(loc && loc.getLine() < locations.size() ? locations[loc.getLine()] : SourceLocation());
+                    }
+                }
+            }
+        }
+
+        if(options.log && options.verbosity >= 2) {
+            std::ostream &log = *options.log;
+
+            // Print inst cost
+            log << "\n--------Instruction cost--------\n";
+            uint32_t lineNumber = 0;
+            for(auto &&F : *compiled) {
+                for(auto &&B : F) {
+                    for(auto &&I : B) {
+                        lineNumber++;
+
+                        auto &&instOpcodeName = std::string(I.getOpcodeName());
+                        instOpcodeName.resize(20, ' ');
+                        log << lineNumber << '\t' << instOpcodeName << '\t'
+                            << irCostCalculator.getInstCost(&I) << '\n';
+                    }
+                }
+            }
+
+            // Print block cost
+            log << "\n--------Block cost--------\n";
+            lineNumber = 0;
+            for(auto &&F : *compiled) {
+                for(auto &&B : F) {
+                    lineNumber++;
+                    log << lineNumber << '\t'
+                        << irCostCalculator.getBlockCost(&B) << '\n';
+                }
+            }
+            log.flush();
+        }
+    }
+    else {
+        printProgress("Using cached LLVM IR block level costs.");
+    }
+
+    for(auto &&F : *M) {
+        if(F.isDeclaration())
+            continue;
+        auto getBlockCosts = [&F](const BlockCostMapType &blockCostMap) {
+            std::vector<CostTy> blockCosts;
+            for(auto &&B : F) {
+                auto it = blockCostMap.find(&B);
+                blockCosts.push_back(it == blockCostMap.end() ? 0 : it->second);
+            }
+            return blockCosts;
+        };
+
+        AnalysisResult::FunctionCost functionCost{F.getName().str(), getBlockCosts(blockCostMaps[0]), std::string(), std::move(instructionCosts[&F]),
+                                                  std::move(sourceLocations[&F])};
+        if(cache && uncached.count(&F)) {
+            for(std::size_t resource = 0; resource < numResources; ++resource)
+                cache->storeBlockCosts(blockCostKeys[resource][&F], resource ? getBlockCosts(blockCostMaps[resource]) : functionCost.blockCosts);
+        }
+        result.functionCosts.push_back(std::move(functionCost));
+    }
+
+    // Call upperbound solver to calculate LLVM IR function level cost
+    printProgress("Calculating LLVM IR function level cost.");
+
+    CoFloCoWrapper coflocoWrapper(options.configuration);
+    coflocoWrapper.setDeadline(deadline);
+    coflocoWrapper.setSolverPool(options.solverPool.get());
+
+    auto annotate = [this, &coflocoWrapper](llvm::Module *module, const BlockCostMapType &blockCostMap) {
+        if(options.coalesceTicks) {
+            TickCoalescer tickCoalescer;
+            coflocoWrapper.cost2tick(module, tickCoalescer.run(module, blockCostMap));
+        }
+        else {
+            coflocoWrapper.cost2tick(module, blockCostMap);
+        }
+
+        if(options.sliceControl) {
+            ControlSlicer controlSlicer;
+            controlSlicer.run(module);
+        }
+    };
+
+    // Every other resource is solved from a copy of the module with the
+    // ticks of its own block costs. Only the copies are written here, as
+    // the module must not be touched while it is being solved.
+    struct ResourceSolve {
+        std::string key;
+        std::string bitcodePath;
+        std::string bound;
+        std::future<std::string> task;
+    };
+    std::vector<ResourceSolve> resourceSolves(numResources - 1);
+    for(std::size_t i = 0; i < resourceSolves.size(); ++i) {
+        auto &resourceSolve = resourceSolves[i];
+        if(cache) {
+            resourceSolve.key = AnalysisCache::hash(boundKey + " resource="s + costModel.getResourceName(i + 1));
+            if(cache->lookup(resourceSolve.key, resourceSolve.bound) && !resourceSolve.bound.empty())
+                continue;
+        }
+
+        llvm::ValueToValueMapTy VMap;
+        std::unique_ptr<llvm::Module> resourceModule = llvm::CloneModule(*M, VMap);
+        BlockCostMapType resourceBlockCostMap;
+        for(const auto &blockCost : blockCostMaps[i + 1])
+            resourceBlockCostMap[llvm::cast<llvm::BasicBlock>(VMap[blockCost.first])] = blockCost.second;
+        annotate(resourceModule.get(), resourceBlockCostMap);
+
+        resourceSolve.bitcodePath = temporaryFiles.create("resource.bc");
+        writeBitcodeFile(resourceModule.get(), resourceSolve.bitcodePath);
+    }
+
+    printProgress("\tAnnotating cost information.");
+    if(options.sliceControl)
+        printProgress("\tSlicing control-irrelevant computations.");
+    annotate(M, blockCostMaps[0]);
+
+    if(!checkDeadline("solve")) return;
+
+    // Only external tools run for the other resources, concurrently with
+    // the solve of the first one
+    if(!resourceSolves.empty())
+        printProgress("\tSolving the cost upperbounds of "s + std::to_string(resourceSolves.size()) + " more resources."s);
+    for(auto &resourceSolve : resourceSolves) {
+        if(resourceSolve.bitcodePath.empty())
+            continue;
+        std::string koatCRSPath = temporaryFiles.create("resource.koat");
+        std::string crsPath = temporaryFiles.create("resource.ces");
+        ++numSolved;
+        resourceSolve.task = std::async(std::launch::async, [this, &deadline, bitcodePath = resourceSolve.bitcodePath, koatCRSPath, crsPath]() {
+            CoFloCoWrapper wrapper(options.configuration);
+            wrapper.setDeadline(deadline);
+            wrapper.setSolverPool(options.solverPool.get());
+            wrapper.extractKoatCostRelationSystem(bitcodePath, koatCRSPath);
+            wrapper.convertToCoFloCoFormat(koatCRSPath, crsPath);
+            return options.componentJobs ? wrapper.readCRSAndSolveUpperBoundByComponents(crsPath, options.componentJobs)
+                                         : wrapper.readCRSAndSolveUpperBound(crsPath);
+        });
+    }
+
+    std::string costUpperBound;
+    bool solverTimedOut = false;
+
+    if(options.allFunctions) {
+        // Everything up to here is shared, only the solving is per function
+        std::vector<std::string> functionNames;
+        for(auto &&F : *M)
+            if(!F.isDeclaration() && !F.hasLocalLinkage())
+                functionNames.push_back(F.getName().str());
+
+        printProgress("\tSolving the cost upperbounds of "s + std::to_string(functionNames.size()) + " functions."s);
+        auto bounds = coflocoWrapper.solveUpperBoundForEachFunction(M, functionNames, options.functionJobs);
+        numSolved += functionNames.size();
+
+        bool allSolved = true;
+        for(std::size_t i = 0; i < functionNames.size(); ++i) {
+            allSolved &= !bounds[i].empty();
+            for(auto &functionCost : result.functionCosts)
+                if(functionCost.name == functionNames[i])
+                    functionCost.bound = bounds[i];
+        }
+
+        if(allSolved) {
+            result.status = AnalysisResult::Status::Complete;
+        }
+        else {
+            result.status = coflocoWrapper.hasTimedOut() ? AnalysisResult::Status::Partial : AnalysisResult::Status::Failed;
+            result.message = coflocoWrapper.hasTimedOut() ? "solver timed out" : "no bound was found for some functions";
+        }
+        return;
+    }
+
+    bool boundCached = cache && cache->lookup(boundKey, costUpperBound) && !costUpperBound.empty();
+    if(boundCached) {
+        printProgress("\tUsing cached cost upperbound.");
+    }
+    else if(options.portfolio) {
+        auto configurations = getPortfolio(options.configuration);
+        for(auto &configuration : configurations)
+            configuration.timeoutSeconds = options.portfolioTimeout;
+
+        printProgress("\tSolving cost upperbound with a portfolio of:");
+        for(const auto &configuration : configurations)
+            printProgress("\t\t"s + configuration.str());
+        costUpperBound = coflocoWrapper.solveUpperBoundWithPortfolio(M, configurations, !options.portfolioBest);
+        ++numSolved;
+    }
+    else if(options.compositional) {
+        printProgress("\tSolving functions bottom-up along the call graph.");
+        CompositionalAnalyzer compositionalAnalyzer(options.configuration, options.compositionalJobs);
+        compositionalAnalyzer.setDeadline(deadline);
+        compositionalAnalyzer.setSolverPool(options.solverPool.get());
+        std::set<std::string> cachedSummaries;
+        for(const auto &summaryKey : summaryKeys) {
+            std::string summary;
+            if(cache->lookup(summaryKey.second, summary) && !summary.empty()) {
+                compositionalAnalyzer.addSummary(summaryKey.first, summary);
+                cachedSummaries.insert(summaryKey.first);
+            }
+        }
+
+        costUpperBound = compositionalAnalyzer.run(M, options.configuration.functionName);
+        solverTimedOut = compositionalAnalyzer.hasTimedOut();
+
+        // Failed solves are tried again next time
+        for(const auto &summary : compositionalAnalyzer.getSummaries()) {
+            printProgress("\t\t"s + summary.first + ": "s + (summary.second.empty() ? "failed"s : summary.second));
+            if(cachedSummaries.count(summary.first))
+                continue;
+            ++numSolved;
+            if(!summary.second.empty() && summaryKeys.count(summary.first))
+                cache->store(summaryKeys[summary.first], summary.second);
+        }
+    }
+    else {
+        std::string crsPath = temporaryFiles.create("tmp.ces");
+
+        printProgress("\tExtracting cost relation system.");
+        coflocoWrapper.extractCostRelationSystem(M, crsPath);
+
+        printProgress("\tSolving cost upperbound.");
+        costUpperBound = options.componentJobs ? coflocoWrapper.readCRSAndSolveUpperBoundByComponents(crsPath, options.componentJobs)
+                                               : coflocoWrapper.readCRSAndSolveUpperBound(crsPath);
+        ++numSolved;
+    }
+
+    solverTimedOut |= coflocoWrapper.hasTimedOut();
+
+    if(!resourceSolves.empty()) {
+        result.resourceBounds.push_back({costModel.getResourceName(0), costUpperBound});
+        for(std::size_t i = 0; i < resourceSolves.size(); ++i) {
+            auto &resourceSolve = resourceSolves[i];
+            if(resourceSolve.task.valid()) {
+                resourceSolve.bound = resourceSolve.task.get();
+                if(cache && !resourceSolve.bound.empty())
+                    cache->store(resourceSolve.key, resourceSolve.bound);
+            }
+            result.resourceBounds.push_back({costModel.getResourceName(i + 1), resourceSolve.bound});
+        }
+    }
+
+    if(costUpperBound.empty()) {
+        result.status = solverTimedOut ? AnalysisResult::Status::Partial : AnalysisResult::Status::Failed;
+        result.message = solverTimedOut ? "solver timed out" : "no bound was found";
+        return;
+    }
+
+    if(cache && !boundCached)
+        cache->store(boundKey, costUpperBound);
+
+    result.status = AnalysisResult::Status::Complete;
+    result.bound = costUpperBound;
+}
+
+} // end namespace gpscat
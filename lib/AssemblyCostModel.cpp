@@ -1,18 +1,147 @@
 #include <gpscat/AssemblyCostModel.h>
-#include <csv-parser/csv.hpp>
+#include <gpscat/BuiltinCostModel.h>
 
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
 #include <string>
-#include <fstream>
 
 namespace gpscat {
 
+namespace {
+
+// Quoted fields may not contain commas, no cost model needs them
+llvm::StringRef unquote(llvm::StringRef field) {
+    field = field.trim();
+    if(field.size() >= 2 && field.front() == '"' && field.back() == '"')
+        field = field.drop_front().drop_back();
+    return field;
+}
+
+} // end anonymous namespace
+
 AssemblyCostModel::AssemblyCostModel(const std::string &filename) {
-    // When the filename is invalid, csv::CSVReader will throw a std::runtime_error
-    csv::CSVReader reader(filename);
+    if(!isBuiltin(filename)) {
+        loadCSV(filename);
+        return;
+    }
+
+    std::string name = filename.substr(std::string("builtin:").size());
+    builtin = findBuiltinCostModel(name);
+    if(!builtin)
+        throw std::runtime_error("unknown built-in cost model " + name);
+
+    // Entries are in the order of the CSV file, their index is the OpcodeID
+    opcodeNames.reserve(builtin->numEntries);
+    costs.assign(1, std::vector<CostTy>());
+    costs[0].reserve(builtin->numEntries);
+    for(std::size_t i = 0; i < builtin->numEntries; ++i) {
+        opcodeNames.emplace_back(builtin->entries[i].opcode);
+        costs[0].push_back(builtin->entries[i].cost);
+    }
+}
+
+void AssemblyCostModel::loadCSV(const std::string &filename) {
+    auto buffer = llvm::MemoryBuffer::getFile(filename);
+    if(!buffer)
+        throw std::runtime_error("cannot read " + filename + ": " + buffer.getError().message());
+
+    llvm::SmallVector<llvm::StringRef, 128> lines;
+    (*buffer)->getBuffer().split(lines, '\n');
+
+    // Column of the opcode and of every resource
+    std::size_t opcodeColumn = ~std::size_t(0);
+    std::vector<std::size_t> resourceColumns;
+    llvm::SmallVector<llvm::StringRef, 8> fields;
+    bool header = true;
+    for(std::size_t lineNum = 1; lineNum <= lines.size(); ++lineNum) {
+        llvm::StringRef line = lines[lineNum - 1].trim();
+        if(line.empty())
+            continue;
+
+        fields.clear();
+        line.split(fields, ',');
+        if(header) {
+            resourceNames.clear();
+            for(std::size_t i = 0; i < fields.size(); ++i) {
+                llvm::StringRef name = unquote(fields[i]);
+                if(name == "Opcode") {
+                    opcodeColumn = i;
+                    continue;
+                }
+                resourceNames.insert(name == "Cost" ? resourceNames.begin() : resourceNames.end(), name.str());
+                resourceColumns.insert(name == "Cost" ? resourceColumns.begin() : resourceColumns.end(), i);
+            }
+            if(opcodeColumn >= fields.size() || resourceColumns.empty())
+                throw std::runtime_error(filename + ": no Opcode and cost columns");
+            if(resourceColumns.size() > MaxResources)
+                throw std::runtime_error(filename + ": more than " + std::to_string(MaxResources) + " cost columns");
+            costs.assign(resourceColumns.size(), std::vector<CostTy>());
+            header = false;
+            continue;
+        }
+
+        if(fields.size() <= std::max(opcodeColumn, *std::max_element(resourceColumns.begin(), resourceColumns.end())))
+            throw std::runtime_error(filename + ":" + std::to_string(lineNum) + ": missing columns");
+
+        OpcodeID opcode = getOpcodeID(unquote(fields[opcodeColumn]));
+        if(opcode == InvalidOpcode) {
+            opcode = static_cast<OpcodeID>(opcodeNames.size());
+            opcodeIDs[unquote(fields[opcodeColumn])] = opcode;
+            opcodeNames.push_back(unquote(fields[opcodeColumn]).str());
+            for(auto &resourceCosts : costs)
+                resourceCosts.push_back(0);
+        }
+        for(std::size_t resource = 0; resource < resourceColumns.size(); ++resource) {
+            if(unquote(fields[resourceColumns[resource]]).getAsInteger(10, costs[resource][opcode]))
+                throw std::runtime_error(filename + ":" + std::to_string(lineNum) + ": invalid " + resourceNames[resource]);
+        }
+    }
+    if(header)
+        throw std::runtime_error(filename + ": empty cost model");
+}
+
+OpcodeID AssemblyCostModel::getOpcodeID(llvm::StringRef instName) const {
+    if(builtin) {
+        std::size_t index = builtin->find(std::string_view(instName.data(), instName.size()));
+        return index == builtin->numEntries ? InvalidOpcode : static_cast<OpcodeID>(index);
+    }
+    auto it = opcodeIDs.find(instName);
+    return it == opcodeIDs.end() ? InvalidOpcode : it->second;
+}
+
+void AssemblyCostModel::set(const std::string &instName, const CostTy& cost) {
+    // A changed built-in model is looked up like one read from a file
+    if(builtin) {
+        for(OpcodeID opcode = 0; opcode < opcodeNames.size(); ++opcode)
+            opcodeIDs[opcodeNames[opcode]] = opcode;
+        builtin = nullptr;
+    }
+
+    auto inserted = opcodeIDs.try_emplace(instName, static_cast<OpcodeID>(opcodeNames.size()));
+    if(inserted.second) {
+        opcodeNames.push_back(instName);
+        for(auto &resourceCosts : costs)
+            resourceCosts.push_back(0);
+    }
+    costs[0][inserted.first->second] = cost;
+}
 
-    for(csv::CSVRow& row : reader) {
-        costModel[row["Opcode"].get<>()] = row["Cost"].get<CostTy>();
+std::string AssemblyCostModel::toCSV() const {
+    std::string csv = "Opcode";
+    for(const auto &name : resourceNames)
+        csv += "," + name;
+    csv += "\n";
+    for(OpcodeID opcode = 0; opcode < opcodeNames.size(); ++opcode) {
+        csv += opcodeNames[opcode];
+        for(const auto &resourceCosts : costs)
+            csv += "," + std::to_string(resourceCosts[opcode]);
+        csv += "\n";
     }
+    return csv;
 }
 
 } // end namespace gpscat
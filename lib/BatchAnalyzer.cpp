@@ -0,0 +1,135 @@
+#include <gpscat/BatchAnalyzer.h>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gpscat {
+
+// Whether json is one object whose braces and brackets are all closed, so
+// that a line cut short right after an inner object is not taken for done
+static bool isCompleteObject(const std::string &json) {
+    if(json.empty() || json.front() != '{')
+        return false;
+
+    int depth = 0;
+    bool inString = false;
+    for(std::size_t i = 0; i < json.size(); ++i) {
+        char c = json[i];
+        if(inString) {
+            if(c == '\\')
+                ++i;
+            else if(c == '"')
+                inString = false;
+        }
+        else if(c == '"')
+            inString = true;
+        else if(c == '{' || c == '[')
+            ++depth;
+        else if((c == '}' || c == ']') && --depth == 0)
+            return i + 1 == json.size();
+    }
+    return false;
+}
+
+std::vector<std::string> BatchAnalyzer::readManifest(const std::string &path) {
+    std::vector<std::string> inputs;
+    std::ifstream manifest(path);
+    std::string line;
+    while(std::getline(manifest, line)) {
+        auto begin = line.find_first_not_of(" \t\r");
+        if(begin == std::string::npos || line[begin] == '#')
+            continue;
+        auto end = line.find_last_not_of(" \t\r");
+        inputs.push_back(line.substr(begin, end - begin + 1));
+    }
+    return inputs;
+}
+
+std::set<std::string> BatchAnalyzer::readJournal(const std::string &path) {
+    // <input>\t<result as JSON>; the last line may be cut short when the
+    // run was killed while writing it. Results which are not complete,
+    // such as those of a deadline, are analyzed again.
+    static const std::string complete = "{\"status\":\"complete\"";
+    std::set<std::string> done;
+    std::ifstream journal(path);
+    std::string line;
+    while(std::getline(journal, line)) {
+        auto tab = line.find('\t');
+        if(tab != std::string::npos && line.compare(tab + 1, complete.size(), complete) == 0 && isCompleteObject(line.substr(tab + 1)))
+            done.insert(line.substr(0, tab));
+    }
+    return done;
+}
+
+std::vector<std::string> BatchAnalyzer::getSchedule(const std::vector<std::string> &inputs) {
+    std::map<std::string, std::uint64_t> sizes;
+    for(const auto &input : inputs) {
+        std::uint64_t size = 0;
+        llvm::sys::fs::file_size(input, size);
+        sizes[input] = size;
+    }
+
+    std::vector<std::string> schedule(inputs);
+    std::stable_sort(schedule.begin(), schedule.end(), [&sizes](const std::string &a, const std::string &b) {
+        return sizes[a] > sizes[b];
+    });
+    return schedule;
+}
+
+void BatchAnalyzer::run(const std::vector<std::string> &inputs, const std::string &journalPath, const ResultCallback &onResult) {
+    std::set<std::string> done = readJournal(journalPath);
+    std::vector<std::string> pending;
+    for(const auto &input : getSchedule(inputs))
+        if(!done.count(input))
+            pending.push_back(input);
+
+    std::ofstream journal(journalPath, std::ios::app);
+    std::mutex journalMutex;
+    std::atomic<std::size_t> nextInput(0);
+
+    // Workers take the next input as soon as they are done with one, so
+    // the big inputs at the front of the schedule start first
+    std::vector<std::thread> workers;
+    for(unsigned int i = 0; i < std::max(numWorkers, 1u) && i < pending.size(); ++i) {
+        workers.emplace_back([&]() {
+            llvm::LLVMContext context;
+            // Functions of one input are reused for the next ones
+            IncrementalAnalyzer analyzer(costModel, options, false);
+
+            for(std::size_t j = nextInput++; j < pending.size(); j = nextInput++) {
+                AnalysisResult result;
+                llvm::SMDiagnostic err;
+                std::unique_ptr<llvm::Module> M = llvm::parseIRFile(pending[j], err, context);
+                if(M) {
+                    result = analyzer.analyze(M.get());
+                }
+                else {
+                    result.stage = "parse";
+                    result.message = err.getMessage().str();
+                }
+
+                std::lock_guard<std::mutex> lock(journalMutex);
+                journal << pending[j] << '\t' << result.toJSON() << std::endl;
+                onResult(pending[j], result);
+            }
+        });
+    }
+    for(auto &worker : workers)
+        worker.join();
+}
+
+} // end namespace gpscat
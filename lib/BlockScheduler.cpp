@@ -0,0 +1,227 @@
+#include <gpscat/BlockScheduler.h>
+#include <gpscat/MappingExtractor.h>
+
+#include <llvm/MC/MCAsmInfo.h>
+#include <llvm/MC/MCContext.h>
+#include <llvm/MC/MCInst.h>
+#include <llvm/MC/MCInstrAnalysis.h>
+#include <llvm/MC/MCInstrInfo.h>
+#include <llvm/MC/MCObjectFileInfo.h>
+#include <llvm/MC/MCParser/MCAsmParser.h>
+#include <llvm/MC/MCParser/MCTargetAsmParser.h>
+#include <llvm/MC/MCRegisterInfo.h>
+#include <llvm/MC/MCSchedule.h>
+#include <llvm/MC/MCStreamer.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/MC/MCTargetOptions.h>
+#include <llvm/MCA/Context.h>
+#include <llvm/MCA/InstrBuilder.h>
+#include <llvm/MCA/Pipeline.h>
+#include <llvm/MCA/SourceMgr.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetRegistry.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace gpscat {
+
+namespace {
+
+// Blocks are repeated this often, unless that would simulate more than
+// MaxSimulatedInstructions instructions
+constexpr unsigned int MaxIterations = 100;
+constexpr std::size_t MaxSimulatedInstructions = 10000;
+
+struct LocatedInst {
+    llvm::MCInst inst;
+    InstructionID ID;
+};
+
+using AsmBlock = std::vector<LocatedInst>;
+
+// Collects the instructions the assembly parser emits, split into blocks
+// at labels and after branches, each with the .loc line before it
+class BlockRecorder final : public llvm::MCStreamer {
+public:
+    BlockRecorder(llvm::MCContext &context, const llvm::MCInstrInfo &MII) : llvm::MCStreamer(context), MII(MII) {}
+
+    const std::vector<AsmBlock> &getBlocks() const {
+        return blocks;
+    }
+
+    void EmitLabel(llvm::MCSymbol *symbol, llvm::SMLoc loc) override {
+        llvm::MCStreamer::EmitLabel(symbol, loc);
+        endBlock();
+    }
+
+    void EmitDwarfLocDirective(unsigned fileNo, unsigned line, unsigned column, unsigned flags, unsigned isa,
+                               unsigned discriminator, llvm::StringRef fileName) override {
+        llvm::MCStreamer::EmitDwarfLocDirective(fileNo, line, column, flags, isa, discriminator, fileName);
+        currentID = line;
+    }
+
+    void EmitInstruction(const llvm::MCInst &inst, const llvm::MCSubtargetInfo &, bool) override {
+        if(blocks.empty())
+            blocks.emplace_back();
+        blocks.back().push_back({inst, currentID});
+
+        // Fall-through blocks have no label
+        if(MII.get(inst.getOpcode()).isTerminator())
+            endBlock();
+    }
+
+    // Symbols and data are of no interest
+    bool EmitSymbolAttribute(llvm::MCSymbol *, llvm::MCSymbolAttr) override {
+        return true;
+    }
+    void EmitCommonSymbol(llvm::MCSymbol *, std::uint64_t, unsigned) override {}
+    void EmitZerofill(llvm::MCSection *, llvm::MCSymbol *, std::uint64_t, unsigned, llvm::SMLoc) override {}
+
+private:
+    void endBlock() {
+        if(!blocks.empty() && !blocks.back().empty())
+            blocks.emplace_back();
+    }
+
+    const llvm::MCInstrInfo &MII;
+    std::vector<AsmBlock> blocks;
+    InstructionID currentID = 0;
+};
+
+void initializeTargets() {
+    static std::once_flag once;
+    std::call_once(once, []() {
+        llvm::InitializeAllTargetInfos();
+        llvm::InitializeAllTargetMCs();
+        llvm::InitializeAllAsmParsers();
+    });
+}
+
+} // end anonymous namespace
+
+BlockScheduler::BlockScheduler(const std::string &arch, const std::string &cpu) : triple(llvm::sys::getDefaultTargetTriple()) {
+    initializeTargets();
+
+    std::string error;
+    target = llvm::TargetRegistry::lookupTarget(arch, triple, error);
+    if(!target)
+        throw std::runtime_error(error);
+
+    MRI.reset(target->createMCRegInfo(triple.getTriple()));
+    if(MRI)
+        MAI.reset(target->createMCAsmInfo(*MRI, triple.getTriple()));
+    MII.reset(target->createMCInstrInfo());
+    STI.reset(target->createMCSubtargetInfo(triple.getTriple(), cpu, ""));
+    if(!MRI || !MAI || !MII || !STI || !target->hasMCAsmParser())
+        throw std::runtime_error("Target " + triple.getTriple() + " cannot parse assembly");
+    if(!STI->getSchedModel().hasInstrSchedModel())
+        throw std::runtime_error("Processor " + (cpu.empty() ? std::string("generic") : cpu) + " of " + triple.getTriple() + " has no scheduling model");
+    MIA.reset(target->createMCInstrAnalysis(MII.get()));
+}
+
+BlockScheduler::~BlockScheduler() = default;
+
+std::vector<CostTy> BlockScheduler::schedule(const std::string &path) const {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path);
+    if(!buffer) {
+        std::cerr << "Cannot read " << path << ": " << buffer.getError().message() << std::endl;
+        return {};
+    }
+
+    llvm::SourceMgr sourceMgr;
+    sourceMgr.AddNewSourceBuffer(std::move(buffer.get()), llvm::SMLoc());
+
+    llvm::MCObjectFileInfo MOFI;
+    llvm::MCContext context(MAI.get(), MRI.get(), &MOFI, &sourceMgr);
+    MOFI.InitMCObjectFileInfo(triple, false, context);
+
+    BlockRecorder recorder(context, *MII);
+    std::unique_ptr<llvm::MCAsmParser> parser(llvm::createMCAsmParser(sourceMgr, context, recorder, *MAI));
+    llvm::MCTargetOptions targetOptions;
+    std::unique_ptr<llvm::MCTargetAsmParser> targetParser(target->createMCAsmParser(*STI, *parser, *MII, targetOptions));
+    if(!targetParser) {
+        std::cerr << "Target " << triple.getTriple() << " cannot parse assembly" << std::endl;
+        return {};
+    }
+    parser->setTargetParser(*targetParser);
+    if(parser->Run(false)) {
+        std::cerr << "Cannot parse " << path << std::endl;
+        return {};
+    }
+
+    std::vector<CostTy> costs;
+    auto addCost = [&costs](InstructionID ID, CostTy cost) {
+        if(ID >= costs.size())
+            costs.resize(static_cast<std::size_t>(ID) + 1, 0);
+        costs[ID] += cost;
+    };
+
+    const llvm::MCSchedModel &schedModel = STI->getSchedModel();
+    llvm::mca::InstrBuilder builder(*STI, *MII, *MRI, MIA.get());
+    for(const AsmBlock &block : recorder.getBlocks()) {
+        std::vector<std::unique_ptr<llvm::mca::Instruction>> instructions;
+        std::vector<InstructionID> IDs;
+        std::vector<unsigned int> latencies;
+        for(const LocatedInst &located : block) {
+            // Calls and returns leave the block, the pipeline would only
+            // warn that it ignores them
+            const llvm::MCInstrDesc &desc = MII->get(located.inst.getOpcode());
+            if(!desc.isCall() && !desc.isReturn()) {
+                llvm::Expected<std::unique_ptr<llvm::mca::Instruction>> instruction = builder.createInstruction(located.inst);
+                if(instruction) {
+                    latencies.push_back(std::max(1u, instruction.get()->getDesc().MaxLatency));
+                    IDs.push_back(located.ID);
+                    instructions.push_back(std::move(instruction.get()));
+                    continue;
+                }
+                llvm::consumeError(instruction.takeError());
+            }
+
+            // Instructions the pipeline does not model cost their latency,
+            // as far as the opcode alone tells it
+            const llvm::MCSchedClassDesc *schedClass = schedModel.getSchedClassDesc(desc.getSchedClass());
+            addCost(located.ID, schedClass && schedClass->isValid() && !schedClass->isVariant()
+                                    ? std::max(1, llvm::MCSchedModel::computeInstrLatency(*STI, *schedClass)) : 1);
+        }
+        if(instructions.empty())
+            continue;
+
+        unsigned int iterations = static_cast<unsigned int>(std::clamp<std::size_t>(MaxSimulatedInstructions / instructions.size(), 1, MaxIterations));
+        llvm::mca::Context mca(*MRI, *STI);
+        llvm::mca::PipelineOptions pipelineOptions(0, 0, 0, 0, true);
+        llvm::mca::SourceMgr source(instructions, iterations);
+        std::unique_ptr<llvm::mca::Pipeline> pipeline = mca.createDefaultPipeline(pipelineOptions, builder, source);
+
+        unsigned int totalLatency = 0;
+        for(unsigned int latency : latencies)
+            totalLatency += latency;
+
+        double cycles = totalLatency;
+        llvm::Expected<unsigned> totalCycles = pipeline->run();
+        if(totalCycles)
+            cycles = static_cast<double>(totalCycles.get()) / iterations;
+        else
+            llvm::consumeError(totalCycles.takeError());
+
+        // Rounding the running sum keeps the block at the cycles rounded up
+        unsigned int latencySum = 0;
+        CostTy assigned = 0;
+        for(std::size_t i = 0; i < instructions.size(); ++i) {
+            latencySum += latencies[i];
+            CostTy upTo = static_cast<CostTy>(std::ceil(cycles * latencySum / totalLatency));
+            addCost(IDs[i], upTo - assigned);
+            assigned = upTo;
+        }
+    }
+    return costs;
+}
+
+} // end namespace gpscat
@@ -0,0 +1,335 @@
+#include <gpscat/BoundExpression.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gpscat {
+
+using NodePtr = std::shared_ptr<const BoundExpression::Node>;
+using Node = BoundExpression::Node;
+
+namespace {
+
+// Recursive descent parser:
+//   expr   := term (('+' | '-') term)*
+//   term   := unary (('*' | '/') unary)*
+//   unary  := '-' unary | power
+//   power  := atom ('^' unary)?
+//   atom   := number | 'oo' | name | name '(' args ')' | '(' expr ')' | '[' args ']'
+class Parser {
+public:
+    Parser(const std::string &str) : str(str) {}
+
+    NodePtr parse() {
+        NodePtr node = parseExpression();
+        skipSpaces();
+        if(pos != str.size())
+            fail("unexpected character");
+        return node;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string &reason) const {
+        throw std::invalid_argument("Cannot parse bound \"" + str + "\": " + reason + " at position " + std::to_string(pos));
+    }
+
+    void skipSpaces() {
+        while(pos < str.size() && std::isspace(static_cast<unsigned char>(str[pos])))
+            ++pos;
+    }
+
+    bool consume(char c) {
+        skipSpaces();
+        if(pos < str.size() && str[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    static NodePtr makeNode(Node::Kind kind, std::vector<NodePtr> operands = {}) {
+        auto node = std::make_shared<Node>();
+        node->kind = kind;
+        node->operands = std::move(operands);
+        return node;
+    }
+
+    NodePtr parseExpression() {
+        NodePtr node = parseTerm();
+        while(true) {
+            if(consume('+'))
+                node = makeNode(Node::Add, {node, parseTerm()});
+            else if(consume('-'))
+                node = makeNode(Node::Sub, {node, parseTerm()});
+            else
+                return node;
+        }
+    }
+
+    NodePtr parseTerm() {
+        NodePtr node = parseUnary();
+        while(true) {
+            if(consume('*'))
+                node = makeNode(Node::Mul, {node, parseUnary()});
+            else if(consume('/'))
+                node = makeNode(Node::Div, {node, parseUnary()});
+            else
+                return node;
+        }
+    }
+
+    NodePtr parseUnary() {
+        if(consume('-'))
+            return makeNode(Node::Neg, {parseUnary()});
+        NodePtr node = parseAtom();
+        if(consume('^'))
+            return makeNode(Node::Pow, {node, parseUnary()});
+        return node;
+    }
+
+    std::vector<NodePtr> parseArguments(char closing) {
+        std::vector<NodePtr> arguments;
+        if(consume(closing))
+            return arguments;
+        do {
+            arguments.push_back(parseExpression());
+        } while(consume(','));
+        if(!consume(closing))
+            fail(std::string("expected '") + closing + "'");
+        return arguments;
+    }
+
+    NodePtr parseAtom() {
+        skipSpaces();
+        if(pos >= str.size())
+            fail("unexpected end");
+
+        char c = str[pos];
+        if(c == '(') {
+            ++pos;
+            NodePtr node = parseExpression();
+            if(!consume(')'))
+                fail("expected ')'");
+            return node;
+        }
+        if(c == '[') {
+            // max([a,b]) takes a list, which is flattened into the call
+            ++pos;
+            auto node = std::make_shared<Node>();
+            node->kind = Node::Call;
+            node->name = "[]";
+            node->operands = parseArguments(']');
+            return node;
+        }
+        if(std::isdigit(static_cast<unsigned char>(c))) {
+            std::size_t end = pos;
+            while(end < str.size() && (std::isdigit(static_cast<unsigned char>(str[end])) || str[end] == '.'))
+                ++end;
+            auto node = std::make_shared<Node>();
+            node->kind = Node::Number;
+            node->value = std::stod(str.substr(pos, end - pos));
+            pos = end;
+            return node;
+        }
+        if(std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            std::size_t end = pos;
+            while(end < str.size() && (std::isalnum(static_cast<unsigned char>(str[end])) || str[end] == '_'))
+                ++end;
+            std::string name = str.substr(pos, end - pos);
+            pos = end;
+
+            auto node = std::make_shared<Node>();
+            if(consume('(')) {
+                node->kind = Node::Call;
+                node->name = name;
+                for(const auto &argument : parseArguments(')')) {
+                    if(argument->kind == Node::Call && argument->name == "[]")
+                        node->operands.insert(node->operands.end(), argument->operands.begin(), argument->operands.end());
+                    else
+                        node->operands.push_back(argument);
+                }
+            }
+            else if(name == "oo") {
+                node->kind = Node::Infinity;
+            }
+            else {
+                node->kind = Node::Variable;
+                node->name = name;
+            }
+            return node;
+        }
+
+        fail("unexpected character");
+    }
+
+    const std::string &str;
+    std::size_t pos = 0;
+};
+
+double evaluateNode(const Node &node, const std::map<std::string, double> &values, double defaultValue) {
+    auto operand = [&](std::size_t i) {
+        return evaluateNode(*node.operands.at(i), values, defaultValue);
+    };
+
+    switch(node.kind) {
+    case Node::Number:
+        return node.value;
+    case Node::Variable: {
+        auto it = values.find(node.name);
+        return it == values.end() ? defaultValue : it->second;
+    }
+    case Node::Infinity:
+        return std::numeric_limits<double>::infinity();
+    case Node::Add:
+        return operand(0) + operand(1);
+    case Node::Sub:
+        return operand(0) - operand(1);
+    case Node::Mul:
+        return operand(0) * operand(1);
+    case Node::Div:
+        return operand(0) / operand(1);
+    case Node::Pow:
+        return std::pow(operand(0), operand(1));
+    case Node::Neg:
+        return -operand(0);
+    case Node::Call:
+        break;
+    }
+
+    std::vector<double> arguments;
+    for(std::size_t i = 0; i < node.operands.size(); ++i)
+        arguments.push_back(operand(i));
+    if(arguments.empty())
+        throw std::invalid_argument("Function without arguments in bound: " + node.name);
+
+    if(node.name == "nat")
+        return std::max(arguments[0], 0.0);
+    if(node.name == "max")
+        return *std::max_element(arguments.begin(), arguments.end());
+    if(node.name == "min")
+        return *std::min_element(arguments.begin(), arguments.end());
+    if(node.name == "pow" && arguments.size() == 2)
+        return std::pow(arguments[0], arguments[1]);
+    if(node.name == "log")
+        return arguments.size() == 2 ? std::log(arguments[1]) / std::log(arguments[0]) : std::log2(arguments[0]);
+
+    throw std::invalid_argument("Unknown function in bound: " + node.name);
+}
+
+// Grows slower than any power, so n*log(n) stays below n^2
+const double logDegree = 1e-6;
+const double exponentialDegree = std::numeric_limits<double>::max();
+
+double getNodeDegree(const Node &node) {
+    auto operand = [&](std::size_t i) {
+        return getNodeDegree(*node.operands.at(i));
+    };
+    auto pow = [&](const Node &base, const Node &exponent) {
+        double baseDegree = getNodeDegree(base), exponentDegree = getNodeDegree(exponent);
+        if(std::isinf(baseDegree) || std::isinf(exponentDegree))
+            return std::numeric_limits<double>::infinity();
+        if(exponentDegree > 0)
+            return exponentialDegree;
+        if(exponent.kind == Node::Number)
+            return std::min(baseDegree * std::max(exponent.value, 0.0), exponentialDegree);
+        return baseDegree > 0 ? exponentialDegree : 0.0;
+    };
+
+    switch(node.kind) {
+    case Node::Number:
+        return 0;
+    case Node::Variable:
+        return 1;
+    case Node::Infinity:
+        return std::numeric_limits<double>::infinity();
+    case Node::Add:
+    case Node::Sub:
+        return std::max(operand(0), operand(1));
+    case Node::Mul: {
+        double lhs = operand(0), rhs = operand(1);
+        if(std::isinf(lhs) || std::isinf(rhs))
+            return std::numeric_limits<double>::infinity();
+        return std::min(lhs + rhs, exponentialDegree);
+    }
+    case Node::Div:
+        return operand(0);
+    case Node::Pow:
+        return pow(*node.operands.at(0), *node.operands.at(1));
+    case Node::Neg:
+        return operand(0);
+    case Node::Call:
+        break;
+    }
+
+    if(node.operands.empty())
+        return 0;
+    if(node.name == "pow" && node.operands.size() == 2)
+        return pow(*node.operands[0], *node.operands[1]);
+    if(node.name == "log") {
+        // log(2^n) grows like n
+        double degree = operand(node.operands.size() - 1);
+        if(degree == exponentialDegree)
+            return 1;
+        return degree > 0 && !std::isinf(degree) ? logDegree : degree;
+    }
+
+    std::vector<double> degrees;
+    for(std::size_t i = 0; i < node.operands.size(); ++i)
+        degrees.push_back(operand(i));
+    if(node.name == "min")
+        return *std::min_element(degrees.begin(), degrees.end());
+    // nat, max and the like
+    return *std::max_element(degrees.begin(), degrees.end());
+}
+
+void collectVariables(const Node &node, std::set<std::string> &variables) {
+    if(node.kind == Node::Variable)
+        variables.insert(node.name);
+    for(const auto &operand : node.operands)
+        collectVariables(*operand, variables);
+}
+
+} // end anonymous namespace
+
+BoundExpression BoundExpression::parse(const std::string &str) {
+    BoundExpression expression;
+    expression.root = Parser(str).parse();
+    return expression;
+}
+
+double BoundExpression::evaluate(const std::map<std::string, double> &values, double defaultValue) const {
+    return evaluateNode(*root, values, defaultValue);
+}
+
+std::set<std::string> BoundExpression::getVariables() const {
+    std::set<std::string> variables;
+    collectVariables(*root, variables);
+    return variables;
+}
+
+double BoundExpression::getDegree() const {
+    return getNodeDegree(*root);
+}
+
+double BoundExpression::estimateMean(const std::map<std::string, std::pair<double, double>> &ranges, unsigned int numSamples, double defaultValue) const {
+    std::mt19937 generator(0);
+    std::map<std::string, double> values;
+    double sum = 0;
+    for(unsigned int i = 0; i < std::max(numSamples, 1u); ++i) {
+        for(const auto &range : ranges)
+            values[range.first] = std::uniform_real_distribution<double>(range.second.first, range.second.second)(generator);
+        sum += evaluate(values, defaultValue);
+    }
+    return sum / std::max(numSamples, 1u);
+}
+
+} // end namespace gpscat
@@ -0,0 +1,33 @@
+#include <gpscat/BuiltinCostModel.h>
+
+#include <iterator>
+
+namespace gpscat {
+
+namespace {
+
+// BuiltinCostModels.def is generated from costmodels/*.csv by
+// cmake/GenerateBuiltinCostModels.cmake
+#define BUILTIN_COST_MODEL(NAME, ...) \
+    constexpr BuiltinCostEntry NAME##Entries[] = {__VA_ARGS__}; \
+    constexpr PerfectHashTable<std::size(NAME##Entries)> NAME##Table(NAME##Entries);
+#include <gpscat/BuiltinCostModels.def>
+#undef BUILTIN_COST_MODEL
+
+constexpr BuiltinCostModel builtinCostModels[] = {
+#define BUILTIN_COST_MODEL(NAME, ...) NAME##Table.getModel(#NAME),
+#include <gpscat/BuiltinCostModels.def>
+#undef BUILTIN_COST_MODEL
+};
+
+} // end anonymous namespace
+
+const BuiltinCostModel *findBuiltinCostModel(std::string_view name) {
+    for(const auto &model : builtinCostModels) {
+        if(model.name == name)
+            return &model;
+    }
+    return nullptr;
+}
+
+} // end namespace gpscat
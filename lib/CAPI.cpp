@@ -0,0 +1,254 @@
+#include <gpscat-c/Analyzer.h>
+#include <gpscat/Analyzer.h>
+#include <gpscat/AnalysisResult.h>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <exception>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+struct gpscat_analyzer {
+    gpscat::Analyzer::Options options;
+    std::unique_ptr<gpscat::Analyzer> analyzer;
+    gpscat::AnalysisResult result;
+    std::string json;
+    std::string error;
+};
+
+namespace {
+
+int fail(gpscat_analyzer *analyzer, int code, const std::string &message) {
+    analyzer->error = message;
+    return code;
+}
+
+// No exception may leave a C function
+template<typename Body>
+int guard(gpscat_analyzer *analyzer, Body body) {
+    try {
+        analyzer->error.clear();
+        return body();
+    }
+    catch(const std::exception &e) {
+        return fail(analyzer, GPSCAT_ERROR_INTERNAL, e.what());
+    }
+    catch(...) {
+        return fail(analyzer, GPSCAT_ERROR_INTERNAL, "unknown error");
+    }
+}
+
+bool parseNumber(const std::string &value, unsigned int &number) {
+    if(value.empty() || value.size() > 9 || value.find_first_not_of("0123456789") != std::string::npos)
+        return false;
+    number = static_cast<unsigned int>(std::stoul(value));
+    return true;
+}
+
+bool parseFlag(const std::string &value, bool &flag) {
+    if(value != "0" && value != "1")
+        return false;
+    flag = value == "1";
+    return true;
+}
+
+const gpscat::AnalysisResult::FunctionCost *getFunctionCost(const gpscat_analyzer *analyzer, size_t function) {
+    if(!analyzer || function >= analyzer->result.functionCosts.size())
+        return nullptr;
+    return &analyzer->result.functionCosts[function];
+}
+
+const gpscat::AnalysisResult::ResourceBound *getResourceBound(const gpscat_analyzer *analyzer, size_t resource) {
+    if(!analyzer || resource >= analyzer->result.resourceBounds.size())
+        return nullptr;
+    return &analyzer->result.resourceBounds[resource];
+}
+
+} // end anonymous namespace
+
+extern "C" {
+
+gpscat_analyzer *gpscat_analyzer_create(void) {
+    try {
+        auto analyzer = std::make_unique<gpscat_analyzer>();
+        analyzer->json = analyzer->result.toJSON();
+        return analyzer.release();
+    }
+    catch(const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void gpscat_analyzer_free(gpscat_analyzer *analyzer) {
+    delete analyzer;
+}
+
+int gpscat_analyzer_set_option(gpscat_analyzer *analyzer, const char *name, const char *value) {
+    if(!analyzer)
+        return GPSCAT_ERROR_INVALID_ARGUMENT;
+    if(!name || !value)
+        return fail(analyzer, GPSCAT_ERROR_INVALID_ARGUMENT, "option without name or value");
+    if(analyzer->analyzer)
+        return fail(analyzer, GPSCAT_ERROR_STATE, "options must be set before the cost model is loaded");
+
+    return guard(analyzer, [analyzer, name, value]() {
+        std::string key(name), v(value);
+        auto &options = analyzer->options;
+        auto &configuration = options.configuration;
+
+        bool valid = true;
+        if(key == "arch") options.arch = v;
+        else if(key == "O") options.optLevel = v;
+        else if(key == "mcpu") options.cpu = v;
+        else if(key == "schedule-blocks") valid = parseFlag(v, options.scheduleBlocks);
+        else if(key == "function") configuration.functionName = v;
+        else if(key == "inline") valid = parseNumber(v, configuration.numInlines);
+        else if(key == "eager-inline") valid = parseFlag(v, configuration.eagerInline);
+        else if(key == "coalesce-ticks") valid = parseFlag(v, options.coalesceTicks);
+        else if(key == "slice-control") valid = parseFlag(v, options.sliceControl);
+        else if(key == "component-jobs") valid = parseNumber(v, options.componentJobs);
+        else if(key == "compositional") valid = parseFlag(v, options.compositional);
+        else if(key == "compositional-jobs") valid = parseNumber(v, options.compositionalJobs);
+        else if(key == "all-functions") valid = parseFlag(v, options.allFunctions);
+        else if(key == "function-jobs") valid = parseNumber(v, options.functionJobs);
+        else if(key == "deadline") valid = parseNumber(v, options.deadlineSeconds);
+        else if(key == "cache-dir") options.cacheDir = v;
+        else if(key == "cache-size") valid = parseNumber(v, options.cacheSizeMB);
+        else if(key == "solver-worker") configuration.solverWorker = v;
+        else if(key == "solver-workers") valid = parseNumber(v, configuration.numSolverWorkers);
+        else return fail(analyzer, GPSCAT_ERROR_INVALID_ARGUMENT, "unknown option " + key);
+
+        if(!valid)
+            return fail(analyzer, GPSCAT_ERROR_INVALID_ARGUMENT, "invalid value of " + key + ": " + v);
+        return static_cast<int>(GPSCAT_OK);
+    });
+}
+
+int gpscat_analyzer_load_cost_model(gpscat_analyzer *analyzer, const char *path) {
+    if(!analyzer)
+        return GPSCAT_ERROR_INVALID_ARGUMENT;
+    if(!path)
+        return fail(analyzer, GPSCAT_ERROR_INVALID_ARGUMENT, "no cost model path");
+    if(analyzer->analyzer)
+        return fail(analyzer, GPSCAT_ERROR_STATE, "a cost model is already loaded");
+
+    return guard(analyzer, [analyzer, path]() {
+        // The CSV reader throws std::runtime_error for unreadable files
+        try {
+            analyzer->analyzer = std::make_unique<gpscat::Analyzer>(path, analyzer->options);
+        }
+        catch(const std::runtime_error &e) {
+            return fail(analyzer, GPSCAT_ERROR_COST_MODEL, e.what());
+        }
+        return static_cast<int>(GPSCAT_OK);
+    });
+}
+
+int gpscat_analyzer_analyze(gpscat_analyzer *analyzer, const char *data, size_t size) {
+    if(!analyzer)
+        return GPSCAT_ERROR_INVALID_ARGUMENT;
+    if(!data && size)
+        return fail(analyzer, GPSCAT_ERROR_INVALID_ARGUMENT, "no input");
+    if(!analyzer->analyzer)
+        return fail(analyzer, GPSCAT_ERROR_STATE, "no cost model is loaded");
+
+    return guard(analyzer, [analyzer, data, size]() {
+        gpscat::AnalysisResult &result = analyzer->result;
+        result = gpscat::AnalysisResult();
+
+        // The module lives only as long as the call
+        llvm::LLVMContext context;
+        llvm::SMDiagnostic err;
+        std::unique_ptr<llvm::Module> M = llvm::parseIR(llvm::MemoryBufferRef(llvm::StringRef(data, size), "input"), err, context);
+        if(M) {
+            result = analyzer->analyzer->analyze(M.get());
+        }
+        else {
+            result.stage = "parse";
+            result.message = err.getMessage().str();
+        }
+
+        analyzer->json = result.toJSON();
+        return static_cast<int>(GPSCAT_OK);
+    });
+}
+
+const char *gpscat_analyzer_get_error(const gpscat_analyzer *analyzer) {
+    return analyzer ? analyzer->error.c_str() : "";
+}
+
+int gpscat_result_status(const gpscat_analyzer *analyzer) {
+    if(!analyzer)
+        return GPSCAT_STATUS_FAILED;
+    switch(analyzer->result.status) {
+    case gpscat::AnalysisResult::Status::Complete: return GPSCAT_STATUS_COMPLETE;
+    case gpscat::AnalysisResult::Status::Partial: return GPSCAT_STATUS_PARTIAL;
+    default: return GPSCAT_STATUS_FAILED;
+    }
+}
+
+const char *gpscat_result_stage(const gpscat_analyzer *analyzer) {
+    return analyzer ? analyzer->result.stage.c_str() : "";
+}
+
+const char *gpscat_result_message(const gpscat_analyzer *analyzer) {
+    return analyzer ? analyzer->result.message.c_str() : "";
+}
+
+const char *gpscat_result_bound(const gpscat_analyzer *analyzer) {
+    return analyzer && !analyzer->result.bound.empty() ? analyzer->result.bound.c_str() : nullptr;
+}
+
+const char *gpscat_result_json(const gpscat_analyzer *analyzer) {
+    return analyzer ? analyzer->json.c_str() : "";
+}
+
+size_t gpscat_result_num_resources(const gpscat_analyzer *analyzer) {
+    return analyzer ? analyzer->result.resourceBounds.size() : 0;
+}
+
+const char *gpscat_result_resource_name(const gpscat_analyzer *analyzer, size_t resource) {
+    const auto *resourceBound = getResourceBound(analyzer, resource);
+    return resourceBound ? resourceBound->resource.c_str() : nullptr;
+}
+
+const char *gpscat_result_resource_bound(const gpscat_analyzer *analyzer, size_t resource) {
+    const auto *resourceBound = getResourceBound(analyzer, resource);
+    return resourceBound && !resourceBound->bound.empty() ? resourceBound->bound.c_str() : nullptr;
+}
+
+size_t gpscat_result_num_functions(const gpscat_analyzer *analyzer) {
+    return analyzer ? analyzer->result.functionCosts.size() : 0;
+}
+
+const char *gpscat_result_function_name(const gpscat_analyzer *analyzer, size_t function) {
+    const auto *functionCost = getFunctionCost(analyzer, function);
+    return functionCost ? functionCost->name.c_str() : nullptr;
+}
+
+const char *gpscat_result_function_bound(const gpscat_analyzer *analyzer, size_t function) {
+    const auto *functionCost = getFunctionCost(analyzer, function);
+    return functionCost && !functionCost->bound.empty() ? functionCost->bound.c_str() : nullptr;
+}
+
+const int32_t *gpscat_result_block_costs(const gpscat_analyzer *analyzer, size_t function, size_t *numBlocks) {
+    const auto *functionCost = getFunctionCost(analyzer, function);
+    if(numBlocks)
+        *numBlocks = functionCost ? functionCost->blockCosts.size() : 0;
+    return functionCost ? functionCost->blockCosts.data() : nullptr;
+}
+
+const int32_t *gpscat_result_instruction_costs(const gpscat_analyzer *analyzer, size_t function, size_t *numInstructions) {
+    const auto *functionCost = getFunctionCost(analyzer, function);
+    if(numInstructions)
+        *numInstructions = functionCost ? functionCost->instructionCosts.size() : 0;
+    return functionCost ? functionCost->instructionCosts.data() : nullptr;
+}
+
+} // extern "C"
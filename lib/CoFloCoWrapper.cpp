@@ -1,30 +1,84 @@
 #include <gpscat/CoFloCoWrapper.h>
+#include <gpscat/CostEquationSystem.h>
+#include <gpscat/BoundExpression.h>
+#include <gpscat/SolverPool.h>
+#include <gpscat/ProcessSupervisor.h>
 #include <gpscat/Utils.h>
 
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Constant.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instructions.h>
 #include <llvm/IR/Type.h>
-#include <llvm/Support/Program.h>
-#include <llvm/Support/CommandLine.h>
 #include <llvm/Support/FileSystem.h>
 
 #include <vector>
 #include <string>
+#include <map>
+#include <memory>
+#include <set>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <limits>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 #include <iostream>
 #include <cassert>
 #include <system_error>
 
-static llvm::cl::opt<unsigned int> numInlines("inline", llvm::cl::desc("Maximum number of function inline steps"), llvm::cl::init(0));
-static llvm::cl::opt<bool> eagerInline("eager-inline", llvm::cl::desc("Exhaustively inline (acyclic call hierarchies only)"));
-static llvm::cl::opt<std::string> functionName("function", llvm::cl::desc("Entry function for the cost analysis"), llvm::cl::init(std::string()));
-
 using namespace std::literals;
 
 namespace gpscat {
 
+std::string SolverConfiguration::str() const {
+    std::string s = eagerInline ? "eager-inline"s : "inline="s + std::to_string(numInlines);
+    s += solveFast ? " solve_fast"s : " full"s;
+    if(computeLowerBounds)
+        s += " compute_lbs"s;
+    return s;
+}
+
+std::vector<SolverConfiguration> getPortfolio(const SolverConfiguration &base) {
+    std::vector<SolverConfiguration> portfolio = {base};
+
+    auto add = [&portfolio](const SolverConfiguration &configuration) {
+        for(const auto &existing : portfolio)
+            if(existing.str() == configuration.str())
+                return;
+        portfolio.push_back(configuration);
+    };
+
+    SolverConfiguration full = base;
+    full.solveFast = false;
+    add(full);
+
+    SolverConfiguration lowerBounds = full;
+    lowerBounds.computeLowerBounds = true;
+    add(lowerBounds);
+
+    for(unsigned int depth : {10u, 1000u}) {
+        SolverConfiguration inlined = base;
+        inlined.eagerInline = false;
+        inlined.numInlines = depth;
+        add(inlined);
+    }
+
+    SolverConfiguration eager = base;
+    eager.eagerInline = true;
+    add(eager);
+
+    return portfolio;
+}
+
 void CoFloCoWrapper::cost2tick(llvm::Module *M, const BlockCostMapType &blockCostMap) {
     // Rename existing "tick" function
     
@@ -47,37 +101,45 @@ void CoFloCoWrapper::cost2tick(llvm::Module *M, const BlockCostMapType &blockCos
     }
 }
 
+int CoFloCoWrapper::runStage(const std::string &program, const std::vector<std::string> &args, const std::string &outputPath, unsigned int timeoutSeconds) {
+    if(deadline.expired()) {
+        timedOut = true;
+        return -1;
+    }
+
+    int exitCode = ProcessSupervisor::get().run(program, args, outputPath, deadline.clamp(timeoutSeconds), cancelled);
+    if(exitCode == -1 && !(cancelled && *cancelled))
+        timedOut = true;
+    return exitCode;
+}
+
 void CoFloCoWrapper::extractKoatCostRelationSystem(const std::string &bitcodePath, const std::string &koatCRSPath) {
     // Use llvm2kittel to extract cost relations
-    llvm::ErrorOr<std::string> llvm2kittelPath = llvm::sys::findProgramByName("llvm2kittel");
+    llvm::ErrorOr<std::string> llvm2kittelPath = findProgram("llvm2kittel");
     if(std::error_code ec = llvm2kittelPath.getError()) {
         std::cerr << ec << std::endl
                   << ec.message() << std::endl;
         return;
     }
 
-    std::vector<std::string> args = {"llvm2kittel"s, bitcodePath, "-complexity-tuples"s, "-division-constraint"s, "exact"s, "-increase-strength"s, "-select-is-control"};
-    if(numInlines) {
-        args.push_back("-inline="s + std::to_string(numInlines));
+    std::vector<std::string> args = {bitcodePath, "-complexity-tuples"s, "-division-constraint"s, "exact"s, "-increase-strength"s, "-select-is-control"};
+    if(configuration.numInlines) {
+        args.push_back("-inline="s + std::to_string(configuration.numInlines));
         args.push_back("-inline-voids");
     }
-    if(eagerInline) {
+    if(configuration.eagerInline) {
         args.push_back("-eager-inline"s);
     }
-    if(!functionName.empty()) {
-        args.push_back("-function="s + functionName);
+    if(!configuration.functionName.empty()) {
+        args.push_back("-function="s + configuration.functionName);
     }
 
-    llvm::sys::ExecuteAndWait(llvm2kittelPath.get(),
-                              std::vector<llvm::StringRef>(std::begin(args), std::end(args)),
-                              llvm::None,
-                              {llvm::Optional<llvm::StringRef>(llvm::None), llvm::Optional<llvm::StringRef>(koatCRSPath), llvm::Optional<llvm::StringRef>(llvm::None)},
-                              60);
+    runStage(llvm2kittelPath.get(), args, koatCRSPath, configuration.timeoutSeconds);
 }
 
 void CoFloCoWrapper::convertToCoFloCoFormat(const std::string &koatCRSPath, const std::string &outputPath) {
     // Step 1: koat2cfg
-    llvm::ErrorOr<std::string> koat2cfgPath = llvm::sys::findProgramByName("koat2cfg.pl");
+    llvm::ErrorOr<std::string> koat2cfgPath = findProgram("koat2cfg.pl");
     if(std::error_code ec = koat2cfgPath.getError()) {
         std::cerr << ec << std::endl
                   << ec.message() << std::endl;
@@ -85,19 +147,17 @@ void CoFloCoWrapper::convertToCoFloCoFormat(const std::string &koatCRSPath, cons
     }
 
     std::string cfgPath = getTemporaryFilePath("gpscat", "tmp.koat.cfg");
-    llvm::sys::ExecuteAndWait(koat2cfgPath.get(),
-                              {"koat2cfg.pl"s, koatCRSPath, "tick_cost"s, "-o"s, cfgPath});
+    runStage(koat2cfgPath.get(), {koatCRSPath, "tick_cost"s, "-o"s, cfgPath}, std::string(), 0);
 
     // Step 2: cfg2ces
-    llvm::ErrorOr<std::string> cfg2cesPath = llvm::sys::findProgramByName("cfg2ces.pl");
+    llvm::ErrorOr<std::string> cfg2cesPath = findProgram("cfg2ces.pl");
     if(std::error_code ec = cfg2cesPath.getError()) {
         std::cerr << ec << std::endl
                   << ec.message() << std::endl;
         return;
     }
 
-    llvm::sys::ExecuteAndWait(cfg2cesPath.get(),
-                              {"cfg2ces.pl"s, cfgPath, "-o"s, outputPath});
+    runStage(cfg2cesPath.get(), {cfgPath, "-o"s, outputPath}, std::string(), 0);
 
     // Remove temporary file
     llvm::sys::fs::remove(cfgPath);
@@ -135,19 +195,39 @@ std::string CoFloCoWrapper::parseCoFloCoOutput(const std::string &path) {
 }
 
 std::string CoFloCoWrapper::readCRSAndSolveUpperBound(const std::string &path) {
-    llvm::ErrorOr<std::string> coflocoPath = llvm::sys::findProgramByName("cofloco");
+    // Workers get the options of every query with it, as one pool serves
+    // all configurations
+    std::vector<std::string> solverArgs = {"-compute_lbs"s, configuration.computeLowerBounds ? "yes"s : "no"s};
+    if(configuration.solveFast)
+        solverArgs.push_back("-solve_fast"s);
+
+    if(!configuration.solverWorker.empty()) {
+        if(deadline.expired()) {
+            timedOut = true;
+            return std::string();
+        }
+        std::unique_ptr<SolverPool> ownSolverPool;
+        if(!solverPool)
+            ownSolverPool = std::make_unique<SolverPool>(configuration.solverWorker, std::vector<std::string>(), 1, 60);
+        SolverPool &pool = solverPool ? *solverPool : *ownSolverPool;
+        auto &&bound = pool.solve(path, deadline.clamp(configuration.timeoutSeconds), solverArgs);
+        if(bound.empty() && deadline.expired())
+            timedOut = true;
+        return bound;
+    }
+
+    llvm::ErrorOr<std::string> coflocoPath = findProgram("cofloco");
     if(std::error_code ec = coflocoPath.getError()) {
         std::cerr << ec << std::endl
                   << ec.message() << std::endl;
         return std::string();
     }
 
+    std::vector<std::string> args = {"-i"s, path, "-v"s, "0"s};
+    args.insert(args.end(), solverArgs.begin(), solverArgs.end());
+
     std::string coflocoOutputPath = getTemporaryFilePath("gpscat", "cofloco");
-    llvm::sys::ExecuteAndWait(coflocoPath.get(),
-                              {"cofloco"s, "-i"s, path, "-v"s, "0"s, "-compute_lbs"s, "no"s, "-solve_fast"s},
-                              llvm::None,
-                              {llvm::Optional<llvm::StringRef>(llvm::None), llvm::Optional<llvm::StringRef>(coflocoOutputPath), llvm::Optional<llvm::StringRef>(llvm::None)},
-                              60);
+    runStage(coflocoPath.get(), args, coflocoOutputPath, configuration.timeoutSeconds);
 
     auto &&parsedOutput = parseCoFloCoOutput(coflocoOutputPath);
 
@@ -157,6 +237,239 @@ std::string CoFloCoWrapper::readCRSAndSolveUpperBound(const std::string &path) {
     return parsedOutput;
 }
 
+std::string CoFloCoWrapper::readCRSAndSolveUpperBoundByComponents(const std::string &path, unsigned int numJobs) {
+    CostEquationSystem ces = CostEquationSystem::readFile(path);
+    ces.removeUnreachable();
+    if(ces.getEquations().empty())
+        return readCRSAndSolveUpperBound(path);
+
+    const std::string entryName = ces.getEntryName();
+
+    const auto components = ces.getComponents();
+    std::map<std::string, std::size_t> componentOf;
+    for(std::size_t i = 0; i < components.size(); ++i)
+        for(const auto &name : components[i])
+            componentOf[name] = i;
+
+    std::vector<std::set<std::size_t>> calleeComponents(components.size());
+    for(const auto &eq : ces.getEquations()) {
+        for(const auto &call : eq.calls) {
+            std::size_t caller = componentOf[eq.head.name], callee = componentOf[call.name];
+            if(caller != callee)
+                calleeComponents[caller].insert(callee);
+        }
+    }
+
+    // Solve the loops bottom-up in waves: every recursive component whose
+    // callees are all done is solved concurrently in its own CoFloCo
+    // process, then its bound replaces the calls made to it by its parents.
+    std::vector<bool> done(components.size(), false);
+    done[componentOf[entryName]] = true;
+    while(true) {
+        std::vector<std::size_t> ready;
+        for(std::size_t i = 0; i < components.size(); ++i) {
+            if(done[i])
+                continue;
+            bool calleesDone = std::all_of(calleeComponents[i].begin(), calleeComponents[i].end(), [&done](std::size_t callee) {
+                return done[callee];
+            });
+            if(calleesDone)
+                ready.push_back(i);
+        }
+        if(ready.empty())
+            break;
+
+        std::vector<std::pair<std::size_t, std::string>> subproblems;
+        for(std::size_t i : ready) {
+            done[i] = true;
+            if(!ces.isRecursive(components[i]))
+                continue;
+            for(const auto &name : ces.getComponentEntries(components[i]))
+                subproblems.emplace_back(i, name);
+        }
+
+        std::vector<std::string> bounds(subproblems.size());
+        for(std::size_t begin = 0; begin < subproblems.size(); begin += std::max(numJobs, 1u)) {
+            std::size_t end = std::min<std::size_t>(subproblems.size(), begin + std::max(numJobs, 1u));
+            std::vector<std::future<std::string>> tasks;
+            for(std::size_t j = begin; j < end; ++j) {
+                std::string subproblemPath = getTemporaryFilePath("gpscat", "scc.ces");
+                ces.extract(subproblems[j].second).writeFile(subproblemPath);
+                tasks.push_back(std::async(std::launch::async, [this, subproblemPath]() {
+                    auto &&bound = readCRSAndSolveUpperBound(subproblemPath);
+                    llvm::sys::fs::remove(subproblemPath);
+                    return bound;
+                }));
+            }
+            for(std::size_t j = begin; j < end; ++j)
+                bounds[j] = tasks[j - begin].get();
+        }
+
+        // Bounds which are not polynomials (nat, max, oo) are left to the
+        // final solve together with the equations they summarize
+        for(std::size_t j = 0; j < subproblems.size(); ++j) {
+            if(!bounds[j].empty())
+                ces.substituteBound(subproblems[j].second, bounds[j], components[subproblems[j].first]);
+        }
+    }
+
+    ces.removeUnreachable();
+    std::string reducedPath = getTemporaryFilePath("gpscat", "reduced.ces");
+    ces.writeFile(reducedPath);
+
+    auto &&bound = readCRSAndSolveUpperBound(reducedPath);
+
+    // Remove temporary file
+    llvm::sys::fs::remove(reducedPath);
+
+    return bound;
+}
+
+// Bounds are compared by how fast they grow, and bounds of the same
+// degree by their values when every parameter is 10^6, 10^3 and then 10,
+// so that one point can neither hide a higher degree nor a larger leading
+// factor. oo and bounds which cannot be parsed rank after every finite
+// bound, failed solves are not usable at all.
+struct BoundRank {
+    bool usable = false;
+    double degree = std::numeric_limits<double>::infinity();
+    std::vector<double> values;
+
+    bool isFinite() const {
+        return usable && std::isfinite(degree);
+    }
+
+    bool operator<(const BoundRank &other) const {
+        return std::tie(degree, values) < std::tie(other.degree, other.values);
+    }
+};
+
+static BoundRank rankBound(const std::string &bound) {
+    BoundRank rank;
+    if(bound.empty())
+        return rank;
+    rank.usable = true;
+    try {
+        BoundExpression expression = BoundExpression::parse(bound);
+        rank.degree = expression.getDegree();
+        for(double point : {1e6, 1e3, 10.0}) {
+            double value = expression.evaluate({}, point);
+            rank.values.push_back(std::isnan(value) ? std::numeric_limits<double>::infinity() : value);
+        }
+    }
+    catch(const std::invalid_argument&) {
+        rank.degree = std::numeric_limits<double>::infinity();
+        rank.values.clear();
+    }
+    return rank;
+}
+
+std::string CoFloCoWrapper::solveUpperBoundWithPortfolio(llvm::Module *M, const std::vector<SolverConfiguration> &configurations, bool stopAtFirstFiniteBound) {
+    std::string bitcodePath = getTemporaryFilePath("gpscat", "tmp.bc");
+    writeBitcodeFile(M, bitcodePath);
+
+    std::atomic<bool> portfolioCancelled(false);
+    std::mutex mutex;
+    std::condition_variable finishedCondition;
+    std::vector<std::string> bounds(configurations.size());
+    std::size_t numFinished = 0;
+    bool finiteBoundFound = false;
+
+    std::vector<std::thread> solvers;
+    for(std::size_t i = 0; i < configurations.size(); ++i) {
+        solvers.emplace_back([&, i]() {
+            CoFloCoWrapper wrapper(configurations[i]);
+            wrapper.setCancellationFlag(&portfolioCancelled);
+            wrapper.setDeadline(deadline);
+            wrapper.setSolverPool(solverPool);
+
+            std::string koatCRSPath = getTemporaryFilePath("gpscat", "tmp.koat");
+            std::string CRSPath = getTemporaryFilePath("gpscat", "tmp.ces");
+            wrapper.extractKoatCostRelationSystem(bitcodePath, koatCRSPath);
+            wrapper.convertToCoFloCoFormat(koatCRSPath, CRSPath);
+            std::string bound = portfolioCancelled ? std::string() : wrapper.readCRSAndSolveUpperBound(CRSPath);
+
+            // Remove temporary files
+            llvm::sys::fs::remove(koatCRSPath);
+            llvm::sys::fs::remove(CRSPath);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            bounds[i] = portfolioCancelled ? std::string() : bound;
+            ++numFinished;
+            finiteBoundFound |= rankBound(bounds[i]).isFinite();
+            finishedCondition.notify_all();
+        });
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finishedCondition.wait(lock, [&]() {
+            return numFinished == configurations.size() || (stopAtFirstFiniteBound && finiteBoundFound);
+        });
+        portfolioCancelled = true;
+    }
+    for(auto &solver : solvers)
+        solver.join();
+
+    // Remove temporary file
+    llvm::sys::fs::remove(bitcodePath);
+
+    std::string bestBound;
+    BoundRank bestRank;
+    if(deadline.expired())
+        timedOut = true;
+    for(const auto &bound : bounds) {
+        BoundRank rank = rankBound(bound);
+        if(rank.usable && (!bestRank.usable || rank < bestRank)) {
+            bestBound = bound;
+            bestRank = rank;
+        }
+    }
+    return bestBound;
+}
+
+std::vector<std::string> CoFloCoWrapper::solveUpperBoundForEachFunction(llvm::Module *M, const std::vector<std::string> &functionNames, unsigned int numJobs) {
+    std::string bitcodePath = getTemporaryFilePath("gpscat", "tmp.bc");
+    writeBitcodeFile(M, bitcodePath);
+
+    std::vector<std::string> bounds(functionNames.size());
+    std::atomic<std::size_t> nextFunction(0);
+
+    std::vector<std::thread> solvers;
+    for(unsigned int i = 0; i < std::max(numJobs, 1u) && i < functionNames.size(); ++i) {
+        solvers.emplace_back([&]() {
+            for(std::size_t j = nextFunction++; j < functionNames.size(); j = nextFunction++) {
+                SolverConfiguration functionConfiguration = configuration;
+                functionConfiguration.functionName = functionNames[j];
+                CoFloCoWrapper wrapper(functionConfiguration);
+                wrapper.setCancellationFlag(cancelled);
+                wrapper.setDeadline(deadline);
+                wrapper.setSolverPool(solverPool);
+
+                std::string koatCRSPath = getTemporaryFilePath("gpscat", "tmp.koat");
+                std::string CRSPath = getTemporaryFilePath("gpscat", "tmp.ces");
+                wrapper.extractKoatCostRelationSystem(bitcodePath, koatCRSPath);
+                wrapper.convertToCoFloCoFormat(koatCRSPath, CRSPath);
+                bounds[j] = wrapper.readCRSAndSolveUpperBound(CRSPath);
+
+                // Remove temporary files
+                llvm::sys::fs::remove(koatCRSPath);
+                llvm::sys::fs::remove(CRSPath);
+
+                if(wrapper.hasTimedOut())
+                    timedOut = true;
+            }
+        });
+    }
+    for(auto &solver : solvers)
+        solver.join();
+
+    // Remove temporary file
+    llvm::sys::fs::remove(bitcodePath);
+
+    return bounds;
+}
+
 std::string CoFloCoWrapper::removeNat(const std::string &exp) {
     // Replace all occurrences of nat(x) with (x)
     std::string newExp;
@@ -0,0 +1,453 @@
+#include <gpscat/CompositionalAnalyzer.h>
+#include <gpscat/BoundExpression.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/Analysis/CallGraph.h>
+#include <llvm/ADT/SCCIterator.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/ValueMapper.h>
+#include <llvm/Support/FileSystem.h>
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gpscat {
+
+namespace {
+
+// Emits the i64 computation of a bound with IRBuilder. Returns nullptr for
+// bounds which cannot be computed: oo, unknown variables or functions,
+// non-constant divisors and exponents. Arithmetic that overflows makes the
+// whole bound INT64_MAX, so that it stays an upper bound.
+class BoundMaterializer {
+public:
+    BoundMaterializer(llvm::IRBuilder<> &builder, llvm::Module *M, const std::map<std::string, llvm::Value*> &variables)
+        : builder(builder), M(M), variables(variables), int64Ty(builder.getInt64Ty()), overflow(builder.getFalse()) {}
+
+    llvm::Value *materializeBound(const BoundExpression::Node &node) {
+        llvm::Value *bound = materialize(node);
+        if(!bound)
+            return nullptr;
+        llvm::Constant *max = builder.getInt64(std::numeric_limits<int64_t>::max());
+        if(auto *constant = llvm::dyn_cast<llvm::ConstantInt>(overflow))
+            return constant->isOne() ? max : bound;
+        return builder.CreateSelect(overflow, max, bound);
+    }
+
+private:
+    llvm::Value *materialize(const BoundExpression::Node &node) {
+        using Node = BoundExpression::Node;
+
+        switch(node.kind) {
+        case Node::Number:
+            return getConstant(std::ceil(node.value));
+        case Node::Variable: {
+            auto it = variables.find(node.name);
+            if(it == variables.end() || !it->second->getType()->isIntegerTy() || it->second->getType()->getIntegerBitWidth() > 64)
+                return nullptr;
+            return builder.CreateSExtOrTrunc(it->second, int64Ty);
+        }
+        case Node::Infinity:
+            return nullptr;
+        case Node::Add:
+        case Node::Sub:
+        case Node::Mul: {
+            llvm::Value *lhs = materialize(*node.operands[0]);
+            llvm::Value *rhs = lhs ? materialize(*node.operands[1]) : nullptr;
+            if(!rhs)
+                return nullptr;
+            if(node.kind == Node::Add)
+                return createChecked(llvm::Intrinsic::sadd_with_overflow, lhs, rhs);
+            if(node.kind == Node::Sub)
+                return createChecked(llvm::Intrinsic::ssub_with_overflow, lhs, rhs);
+            return createChecked(llvm::Intrinsic::smul_with_overflow, lhs, rhs);
+        }
+        case Node::Div: {
+            // Round up, so that the result stays an upper bound
+            const Node &divisor = *node.operands[1];
+            if(divisor.kind != Node::Number || divisor.value < 1 || divisor.value != std::floor(divisor.value))
+                return nullptr;
+            llvm::Value *dividend = materialize(*node.operands[0]);
+            llvm::Value *d = dividend ? getConstant(divisor.value) : nullptr;
+            if(!d)
+                return nullptr;
+            return builder.CreateSDiv(createChecked(llvm::Intrinsic::sadd_with_overflow, dividend, builder.CreateSub(d, builder.getInt64(1))), d);
+        }
+        case Node::Pow:
+            return materializePow(*node.operands[0], *node.operands[1]);
+        case Node::Neg: {
+            llvm::Value *operand = materialize(*node.operands[0]);
+            return operand ? createChecked(llvm::Intrinsic::ssub_with_overflow, builder.getInt64(0), operand) : nullptr;
+        }
+        case Node::Call:
+            break;
+        }
+
+        if(node.operands.empty())
+            return nullptr;
+        if(node.name == "pow" && node.operands.size() == 2)
+            return materializePow(*node.operands[0], *node.operands[1]);
+
+        std::vector<llvm::Value*> operands;
+        for(const auto &operand : node.operands) {
+            operands.push_back(materialize(*operand));
+            if(!operands.back())
+                return nullptr;
+        }
+
+        if(node.name == "nat")
+            return createMax(operands[0], builder.getInt64(0));
+        // log(b, x) <= nat(x) for every base b >= 2
+        if(node.name == "log")
+            return createMax(operands.back(), builder.getInt64(0));
+        if(node.name == "max" || node.name == "min") {
+            llvm::Value *result = operands[0];
+            for(std::size_t i = 1; i < operands.size(); ++i) {
+                llvm::Value *isGreater = builder.CreateICmpSGT(operands[i], result);
+                result = node.name == "max" ? builder.CreateSelect(isGreater, operands[i], result)
+                                            : builder.CreateSelect(isGreater, result, operands[i]);
+            }
+            return result;
+        }
+
+        return nullptr;
+    }
+
+    llvm::Value *getConstant(double value) {
+        // 2^63 is the first double above INT64_MAX
+        if(value < -9223372036854775808.0 || value >= 9223372036854775808.0)
+            return nullptr;
+        return builder.getInt64(static_cast<uint64_t>(static_cast<int64_t>(value)));
+    }
+
+    llvm::Value *createMax(llvm::Value *a, llvm::Value *b) {
+        return builder.CreateSelect(builder.CreateICmpSGT(a, b), a, b);
+    }
+
+    // Adds whether the operation overflowed to overflow. Constants are
+    // folded, like IRBuilder does for plain arithmetic.
+    llvm::Value *createChecked(llvm::Intrinsic::ID id, llvm::Value *lhs, llvm::Value *rhs) {
+        auto *a = llvm::dyn_cast<llvm::ConstantInt>(lhs);
+        auto *b = llvm::dyn_cast<llvm::ConstantInt>(rhs);
+        if(a && b) {
+            bool overflowed = false;
+            llvm::APInt result = id == llvm::Intrinsic::sadd_with_overflow ? a->getValue().sadd_ov(b->getValue(), overflowed)
+                               : id == llvm::Intrinsic::ssub_with_overflow ? a->getValue().ssub_ov(b->getValue(), overflowed)
+                                                                          : a->getValue().smul_ov(b->getValue(), overflowed);
+            if(overflowed)
+                overflow = builder.getTrue();
+            return builder.getInt(result);
+        }
+
+        // The block has no function yet, the declaration is taken from M
+        llvm::Function *intrinsic = llvm::Intrinsic::getDeclaration(M, id, {int64Ty});
+        llvm::Value *result = builder.CreateCall(intrinsic, {lhs, rhs});
+        overflow = builder.CreateOr(overflow, builder.CreateExtractValue(result, 1));
+        return builder.CreateExtractValue(result, 0);
+    }
+
+    llvm::Value *materializePow(const BoundExpression::Node &base, const BoundExpression::Node &exponent) {
+        if(exponent.kind != BoundExpression::Node::Number || exponent.value < 0 || exponent.value > 16 || exponent.value != std::floor(exponent.value))
+            return nullptr;
+        llvm::Value *b = materialize(base);
+        if(!b)
+            return nullptr;
+        llvm::Value *result = builder.getInt64(1);
+        for(int i = 0; i < static_cast<int>(exponent.value); ++i)
+            result = createChecked(llvm::Intrinsic::smul_with_overflow, result, b);
+        return result;
+    }
+
+    llvm::IRBuilder<> &builder;
+    llvm::Module *M;
+    const std::map<std::string, llvm::Value*> &variables;
+    llvm::Type *int64Ty;
+    // Whether any operation so far overflowed, an i1
+    llvm::Value *overflow;
+};
+
+// Summaries are computed in i64, so tick takes an i64 in the modules they
+// are applied to. The ticks cost2tick inserted are widened.
+llvm::Function *getWideTick(llvm::Module *M) {
+    llvm::LLVMContext &context = M->getContext();
+    llvm::Type *int64Ty = llvm::Type::getInt64Ty(context);
+    llvm::Function *tick = M->getFunction("tick");
+    if(tick && tick->getFunctionType()->getNumParams() == 1 && tick->getFunctionType()->getParamType(0) == int64Ty)
+        return tick;
+
+    llvm::FunctionType *tickType = llvm::FunctionType::get(llvm::Type::getVoidTy(context), {int64Ty}, false);
+    llvm::Function *wideTick = llvm::Function::Create(tickType, llvm::Function::ExternalLinkage, "", M);
+    if(tick) {
+        std::vector<llvm::CallInst*> calls;
+        for(llvm::User *user : tick->users())
+            if(auto *call = llvm::dyn_cast<llvm::CallInst>(user))
+                calls.push_back(call);
+        for(llvm::CallInst *call : calls) {
+            llvm::IRBuilder<> builder(call);
+            builder.CreateCall(wideTick, {builder.CreateSExtOrTrunc(call->getArgOperand(0), int64Ty)});
+            call->eraseFromParent();
+        }
+        if(!tick->use_empty())
+            tick->replaceAllUsesWith(llvm::ConstantExpr::getBitCast(wideTick, tick->getType()));
+        tick->eraseFromParent();
+    }
+    wideTick->setName("tick");
+    return wideTick;
+}
+
+// The computation of the cost of a call, built before anything of the
+// caller is changed
+struct CallSummary {
+    llvm::CallBase *call;
+    std::unique_ptr<llvm::BasicBlock> computation;
+    llvm::Value *cost;
+};
+
+// Build the computation in a detached block, so that nothing is left behind
+// in the caller when the bound turns out not to be computable
+bool materializeSummary(llvm::CallBase *call, const std::string &bound, CallSummary &summary) {
+    llvm::Function *callee = call->getCalledFunction();
+    if(!callee)
+        return false;
+
+    BoundExpression expression;
+    try {
+        expression = BoundExpression::parse(bound);
+    }
+    catch(const std::invalid_argument&) {
+        return false;
+    }
+
+    std::map<std::string, llvm::Value*> variables;
+    for(auto &&arg : callee->args())
+        variables[getBoundVariableName(arg)] = call->getArgOperand(arg.getArgNo());
+
+    summary.call = call;
+    summary.computation.reset(llvm::BasicBlock::Create(call->getContext()));
+    llvm::IRBuilder<> builder(summary.computation.get());
+    summary.cost = BoundMaterializer(builder, call->getModule(), variables).materializeBound(expression.getRoot());
+    return summary.cost != nullptr;
+}
+
+void applySummary(CallSummary &summary) {
+    llvm::CallBase *call = summary.call;
+    llvm::Function *tickFunc = getWideTick(call->getModule());
+    if(!llvm::isa<llvm::ConstantInt>(summary.cost) || !llvm::cast<llvm::ConstantInt>(summary.cost)->isZero())
+        llvm::CallInst::Create(tickFunc->getFunctionType(), tickFunc, {summary.cost}, "", summary.computation.get());
+
+    call->getParent()->getInstList().splice(call->getIterator(), summary.computation->getInstList());
+
+    // The return value of the callee is unknown to the caller, as it is
+    // when llvm2kittel does not inline a call
+    if(auto *invoke = llvm::dyn_cast<llvm::InvokeInst>(call)) {
+        llvm::BranchInst::Create(invoke->getNormalDest(), invoke);
+        invoke->getUnwindDest()->removePredecessor(invoke->getParent());
+    }
+    if(!call->getType()->isVoidTy())
+        call->replaceAllUsesWith(llvm::UndefValue::get(call->getType()));
+    call->eraseFromParent();
+}
+
+} // end anonymous namespace
+
+bool CompositionalAnalyzer::replaceCallBySummary(llvm::CallBase *call, const std::string &bound) {
+    return replaceCallsBySummaries({{call, bound}});
+}
+
+bool CompositionalAnalyzer::replaceCallsBySummaries(const std::vector<std::pair<llvm::CallBase*, std::string>> &calls) {
+    // Every computation is built before the first call is replaced
+    std::vector<CallSummary> summaries(calls.size());
+    for(std::size_t i = 0; i < calls.size(); ++i)
+        if(!materializeSummary(calls[i].first, calls[i].second, summaries[i]))
+            return false;
+
+    for(CallSummary &summary : summaries)
+        applySummary(summary);
+    return true;
+}
+
+std::vector<llvm::CallBase*> CompositionalAnalyzer::getSummarizedCalls(llvm::Function &F) const {
+    // Calls to functions with a body; declarations and indirect calls are
+    // left to llvm2kittel as before
+    std::vector<llvm::CallBase*> calls;
+    for(auto &&BB : F) {
+        for(auto &&I : BB) {
+            auto *call = llvm::dyn_cast<llvm::CallBase>(&I);
+            if(!call)
+                continue;
+            llvm::Function *callee = call->getCalledFunction();
+            if(callee && !callee->isDeclaration())
+                calls.push_back(call);
+        }
+    }
+    return calls;
+}
+
+std::string CompositionalAnalyzer::writeFunctionBitcode(llvm::Module *M, llvm::Function *F) {
+    // llvm2kittel only looks at the entry function when it does not
+    // inline, so every other body is dropped from the bitcode
+    llvm::ValueToValueMapTy VMap;
+    std::unique_ptr<llvm::Module> functionModule = llvm::CloneModule(*M, VMap, [F](const llvm::GlobalValue *GV) {
+        return GV == F;
+    });
+
+    std::string bitcodePath = getTemporaryFilePath("gpscat", "function.bc");
+    writeBitcodeFile(functionModule.get(), bitcodePath);
+    return bitcodePath;
+}
+
+std::string CompositionalAnalyzer::solveFunction(const std::string &bitcodePath, const std::string &name) {
+    SolverConfiguration functionConfiguration = configuration;
+    functionConfiguration.numInlines = 0;
+    functionConfiguration.eagerInline = false;
+    functionConfiguration.functionName = name;
+
+    CoFloCoWrapper wrapper(functionConfiguration);
+    wrapper.setDeadline(deadline);
+    wrapper.setSolverPool(solverPool);
+
+    std::string koatCRSPath = getTemporaryFilePath("gpscat", "tmp.koat");
+    std::string CRSPath = getTemporaryFilePath("gpscat", "tmp.ces");
+    wrapper.extractKoatCostRelationSystem(bitcodePath, koatCRSPath);
+    wrapper.convertToCoFloCoFormat(koatCRSPath, CRSPath);
+    auto &&bound = wrapper.readCRSAndSolveUpperBound(CRSPath);
+
+    // Remove temporary files
+    llvm::sys::fs::remove(koatCRSPath);
+    llvm::sys::fs::remove(CRSPath);
+
+    if(wrapper.hasTimedOut())
+        timedOut = true;
+    return bound;
+}
+
+std::string CompositionalAnalyzer::run(llvm::Module *M, const std::string &entryName) {
+    // Summaries refer to the parameters by name
+    for(auto &&F : *M) {
+        if(F.isDeclaration())
+            continue;
+        for(auto &&arg : F.args())
+            if(!arg.hasName())
+                arg.setName("arg" + std::to_string(arg.getArgNo()));
+    }
+
+    // Calls are replaced in a copy, M keeps the program as it is
+    std::unique_ptr<llvm::Module> summarized = llvm::CloneModule(*M);
+    return summarize(summarized.get(), entryName);
+}
+
+std::string CompositionalAnalyzer::summarize(llvm::Module *M, const std::string &entryName) {
+    llvm::Function *entry = M->getFunction(entryName.empty() ? "main" : entryName);
+    if(!entry || entry->isDeclaration()) {
+        std::cerr << "Entry function " << (entryName.empty() ? "main" : entryName) << " not found." << std::endl;
+        return std::string();
+    }
+
+    // Functions reachable from the entry through direct calls, callers first
+    std::vector<llvm::Function*> reachable = {entry};
+    std::set<llvm::Function*> visited = {entry};
+    std::map<llvm::Function*, std::set<llvm::Function*>> callees;
+    for(std::size_t i = 0; i < reachable.size(); ++i) {
+        for(llvm::CallBase *call : getSummarizedCalls(*reachable[i])) {
+            llvm::Function *callee = call->getCalledFunction();
+            callees[reachable[i]].insert(callee);
+            if(visited.insert(callee).second)
+                reachable.push_back(callee);
+        }
+    }
+
+    llvm::CallGraph callGraph(*M);
+    for(auto it = llvm::scc_begin(&callGraph); !it.isAtEnd(); ++it) {
+        const std::vector<llvm::CallGraphNode*> &scc = *it;
+        bool recursive = scc.size() > 1;
+        for(const auto &record : *scc.front())
+            recursive |= record.second == scc.front();
+        if(!recursive)
+            continue;
+        for(llvm::CallGraphNode *node : scc)
+            if(node->getFunction() && visited.count(node->getFunction()))
+                summaries[node->getFunction()->getName().str()] = "oo";
+    }
+
+    auto isSummarized = [this](llvm::Function *F) {
+        return summaries.count(F->getName().str()) != 0;
+    };
+
+    // Solve in waves: every function whose callees are all summarized is
+    // solved concurrently with the others of its wave
+    while(!isSummarized(entry)) {
+        if(deadline.expired()) {
+            timedOut = true;
+            return std::string();
+        }
+
+        std::vector<std::pair<llvm::Function*, std::string>> jobs; // (function, bitcode path)
+        for(llvm::Function *F : reachable) {
+            if(isSummarized(F) || !std::all_of(callees[F].begin(), callees[F].end(), isSummarized))
+                continue;
+
+            // A callee without a finite bound leaves its callers without one
+            bool calleeFailed = false, calleeUnbounded = false;
+            for(llvm::Function *callee : callees[F]) {
+                const std::string &bound = summaries[callee->getName().str()];
+                calleeFailed |= bound.empty();
+                calleeUnbounded |= bound == "oo";
+            }
+            if(calleeFailed || calleeUnbounded) {
+                summaries[F->getName().str()] = calleeFailed ? std::string() : "oo";
+                continue;
+            }
+
+            std::vector<std::pair<llvm::CallBase*, std::string>> calls;
+            for(llvm::CallBase *call : getSummarizedCalls(*F))
+                calls.emplace_back(call, summaries[call->getCalledFunction()->getName().str()]);
+            if(!replaceCallsBySummaries(calls)) {
+                summaries[F->getName().str()] = "oo";
+                continue;
+            }
+
+            jobs.emplace_back(F, writeFunctionBitcode(M, F));
+        }
+
+        std::vector<std::string> bounds(jobs.size());
+        for(std::size_t begin = 0; begin < jobs.size(); begin += std::max(numJobs, 1u)) {
+            std::size_t end = std::min<std::size_t>(jobs.size(), begin + std::max(numJobs, 1u));
+            std::vector<std::future<std::string>> tasks;
+            for(std::size_t j = begin; j < end; ++j) {
+                std::string bitcodePath = jobs[j].second, name = jobs[j].first->getName().str();
+                tasks.push_back(std::async(std::launch::async, [this, bitcodePath, name]() {
+                    return solveFunction(bitcodePath, name);
+                }));
+            }
+            for(std::size_t j = begin; j < end; ++j)
+                bounds[j] = tasks[j - begin].get();
+        }
+
+        for(std::size_t j = 0; j < jobs.size(); ++j) {
+            summaries[jobs[j].first->getName().str()] = bounds[j];
+            // Remove temporary file
+            llvm::sys::fs::remove(jobs[j].second);
+        }
+    }
+
+    return summaries[entry->getName().str()];
+}
+
+} // end namespace gpscat
@@ -0,0 +1,111 @@
+#include <gpscat/ControlSlicer.h>
+
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Operator.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace gpscat {
+
+// Strip casts and address computations to find the object a pointer
+// points into. Returns nullptr when the object cannot be identified.
+static const llvm::Value *getIdentifiedObject(const llvm::Value *V) {
+    while(true) {
+        V = V->stripPointerCasts();
+        if(const auto *GEP = llvm::dyn_cast<llvm::GEPOperator>(V))
+            V = GEP->getPointerOperand();
+        else
+            break;
+    }
+    if(llvm::isa<llvm::AllocaInst>(V) || llvm::isa<llvm::GlobalVariable>(V))
+        return V;
+    return nullptr;
+}
+
+void ControlSlicer::run(llvm::Module *M) {
+    for(auto &&F : *M) {
+        if(!F.isDeclaration())
+            slice(F);
+    }
+}
+
+void ControlSlicer::slice(llvm::Function &F) {
+    llvm::SmallPtrSet<llvm::Instruction*, 32> relevant;
+    llvm::SmallVector<llvm::Instruction*, 64> worklist;
+
+    auto markRelevant = [&relevant, &worklist](llvm::Instruction *I) {
+        if(relevant.insert(I).second)
+            worklist.push_back(I);
+    };
+
+    // Stores grouped by the object they write to, nullptr for unknown objects
+    std::unordered_map<const llvm::Value*, std::vector<llvm::StoreInst*>> storesByObject;
+
+    for(auto &&I : llvm::instructions(F)) {
+        if(auto *SI = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+            storesByObject[getIdentifiedObject(SI->getPointerOperand())].push_back(SI);
+        }
+        // Branch conditions, loop exits, returned values, calls (and therefore
+        // call arguments) and anything else with side effects are kept
+        else if(I.isTerminator() || I.mayHaveSideEffects() || I.isEHPad() || I.getType()->isTokenTy()) {
+            markRelevant(&I);
+        }
+    }
+
+    auto markStores = [&storesByObject, &markRelevant](const llvm::Value *object) {
+        auto it = storesByObject.find(object);
+        if(it == storesByObject.end())
+            return;
+        for(llvm::StoreInst *SI : it->second)
+            markRelevant(SI);
+    };
+
+    bool allStoresRelevant = false;
+    while(!worklist.empty()) {
+        llvm::Instruction *I = worklist.pop_back_val();
+
+        for(llvm::Value *operand : I->operands()) {
+            if(auto *operandInst = llvm::dyn_cast<llvm::Instruction>(operand))
+                markRelevant(operandInst);
+        }
+
+        // A relevant load needs every store that may have written its value
+        if(auto *LI = llvm::dyn_cast<llvm::LoadInst>(I)) {
+            if(allStoresRelevant)
+                continue;
+            if(const llvm::Value *object = getIdentifiedObject(LI->getPointerOperand())) {
+                markStores(object);
+                markStores(nullptr);
+            }
+            else {
+                allStoresRelevant = true;
+                for(const auto &objectStores : storesByObject)
+                    markStores(objectStores.first);
+            }
+        }
+    }
+
+    // Everything else is replaced with undef and removed
+    std::vector<llvm::Instruction*> irrelevant;
+    for(auto &&I : llvm::instructions(F)) {
+        if(!relevant.count(&I))
+            irrelevant.push_back(&I);
+    }
+
+    for(llvm::Instruction *I : irrelevant) {
+        if(!I->getType()->isVoidTy())
+            I->replaceAllUsesWith(llvm::UndefValue::get(I->getType()));
+    }
+    for(llvm::Instruction *I : irrelevant)
+        I->eraseFromParent();
+}
+
+} // end namespace gpscat
@@ -0,0 +1,370 @@
+#include <gpscat/CostEquationSystem.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace gpscat {
+
+static std::string trim(const std::string &str) {
+    auto begin = str.find_first_not_of(" \t\r\n");
+    if(begin == std::string::npos)
+        return std::string();
+    auto end = str.find_last_not_of(" \t\r\n");
+    return str.substr(begin, end - begin + 1);
+}
+
+// Split at separators which are not nested in parentheses or brackets
+static std::vector<std::string> splitTopLevel(const std::string &str, char separator) {
+    std::vector<std::string> parts;
+    int depth = 0;
+    std::size_t lastPos = 0;
+    for(std::size_t pos = 0; pos < str.size(); ++pos) {
+        char c = str[pos];
+        if(c == '(' || c == '[')
+            ++depth;
+        else if(c == ')' || c == ']')
+            --depth;
+        else if(c == separator && depth == 0) {
+            parts.push_back(trim(str.substr(lastPos, pos - lastPos)));
+            lastPos = pos + 1;
+        }
+    }
+    std::string last = trim(str.substr(lastPos));
+    if(!last.empty() || !parts.empty())
+        parts.push_back(last);
+    return parts;
+}
+
+// "[a,b]" -> "a,b"
+static std::string stripBrackets(const std::string &str) {
+    std::string s = trim(str);
+    if(s.size() >= 2 && s.front() == '[' && s.back() == ']')
+        return trim(s.substr(1, s.size() - 2));
+    return s;
+}
+
+static bool isIdentifierChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+CostTerm CostTerm::parse(const std::string &str) {
+    CostTerm term;
+    std::string s = trim(str);
+    auto pos = s.find('(');
+    if(pos == std::string::npos || s.back() != ')') {
+        term.name = s;
+        return term;
+    }
+    term.name = trim(s.substr(0, pos));
+    term.args = splitTopLevel(s.substr(pos + 1, s.size() - pos - 2), ',');
+    return term;
+}
+
+std::string CostTerm::str() const {
+    if(args.empty())
+        return name;
+    std::string s = name + "(";
+    for(std::size_t i = 0; i < args.size(); ++i)
+        s += (i ? "," : "") + args[i];
+    return s + ")";
+}
+
+std::string CostEquation::str() const {
+    std::string s = "eq(" + head.str() + "," + cost + ",[";
+    for(std::size_t i = 0; i < calls.size(); ++i)
+        s += (i ? "," : "") + calls[i].str();
+    return s + "],[" + constraints + "]).";
+}
+
+CostEquationSystem CostEquationSystem::parse(const std::string &text) {
+    CostEquationSystem ces;
+
+    // Clauses end with a '.' outside of any term
+    std::vector<std::string> clauses;
+    int depth = 0;
+    std::size_t lastPos = 0;
+    for(std::size_t pos = 0; pos < text.size(); ++pos) {
+        char c = text[pos];
+        if(c == '(' || c == '[')
+            ++depth;
+        else if(c == ')' || c == ']')
+            --depth;
+        else if(c == '.' && depth == 0) {
+            clauses.push_back(trim(text.substr(lastPos, pos - lastPos)));
+            lastPos = pos + 1;
+        }
+    }
+
+    for(const auto &clause : clauses) {
+        if(clause.empty())
+            continue;
+
+        CostTerm term = CostTerm::parse(clause);
+        if(term.name == "eq" && term.args.size() == 4) {
+            CostEquation eq;
+            eq.head = CostTerm::parse(term.args[0]);
+            eq.cost = term.args[1];
+            for(const auto &call : splitTopLevel(stripBrackets(term.args[2]), ','))
+                eq.calls.push_back(CostTerm::parse(call));
+            eq.constraints = stripBrackets(term.args[3]);
+            ces.equations.push_back(std::move(eq));
+        }
+        else if(term.name == "input_output_vars" && !term.args.empty()) {
+            ces.ioVars.emplace_back(CostTerm::parse(term.args[0]).name, clause);
+        }
+        else if(term.name == "entry" && term.args.size() == 1) {
+            // entry(Head:Constraints)
+            ces.entry = splitTopLevel(term.args[0], ':').front();
+        }
+        else {
+            ces.otherClauses.push_back(clause);
+        }
+    }
+
+    return ces;
+}
+
+CostEquationSystem CostEquationSystem::readFile(const std::string &path) {
+    std::ifstream inputFile(path);
+    std::stringstream buffer;
+    buffer << inputFile.rdbuf();
+    return parse(buffer.str());
+}
+
+std::string CostEquationSystem::str() const {
+    std::string s;
+    if(!entry.empty())
+        s += "entry(" + entry + ":[]).\n";
+    for(const auto &clause : otherClauses)
+        s += clause + ".\n";
+    for(const auto &ioVar : ioVars)
+        s += ioVar.second + ".\n";
+    for(const auto &eq : equations)
+        s += eq.str() + "\n";
+    return s;
+}
+
+void CostEquationSystem::writeFile(const std::string &path) const {
+    std::ofstream outputFile(path);
+    outputFile << str();
+}
+
+std::string CostEquationSystem::getEntryName() const {
+    if(!entry.empty())
+        return CostTerm::parse(entry).name;
+    // CoFloCo starts from the first equation when no entry is given
+    return equations.empty() ? std::string() : equations.front().head.name;
+}
+
+std::vector<CostEquationSystem::Component> CostEquationSystem::getComponents() const {
+    std::map<std::string, std::set<std::string>> callGraph;
+    for(const auto &eq : equations) {
+        auto &callees = callGraph[eq.head.name];
+        for(const auto &call : eq.calls) {
+            callees.insert(call.name);
+            callGraph[call.name];
+        }
+    }
+
+    // Tarjan's algorithm emits components in reverse topological order,
+    // which is exactly callees before callers
+    std::vector<Component> components;
+    std::map<std::string, std::size_t> index, lowlink;
+    std::set<std::string> onStack;
+    std::vector<std::string> stack;
+    std::size_t nextIndex = 0;
+
+    std::function<void(const std::string&)> strongConnect = [&](const std::string &name) {
+        index[name] = lowlink[name] = nextIndex++;
+        stack.push_back(name);
+        onStack.insert(name);
+
+        for(const auto &callee : callGraph[name]) {
+            if(index.find(callee) == index.end()) {
+                strongConnect(callee);
+                lowlink[name] = std::min(lowlink[name], lowlink[callee]);
+            }
+            else if(onStack.count(callee)) {
+                lowlink[name] = std::min(lowlink[name], index[callee]);
+            }
+        }
+
+        if(lowlink[name] == index[name]) {
+            Component component;
+            std::string member;
+            do {
+                member = stack.back();
+                stack.pop_back();
+                onStack.erase(member);
+                component.push_back(member);
+            } while(member != name);
+            components.push_back(std::move(component));
+        }
+    };
+
+    for(const auto &node : callGraph) {
+        if(index.find(node.first) == index.end())
+            strongConnect(node.first);
+    }
+
+    return components;
+}
+
+bool CostEquationSystem::isRecursive(const Component &component) const {
+    if(component.size() > 1)
+        return true;
+    for(const auto &eq : equations) {
+        if(eq.head.name != component.front())
+            continue;
+        for(const auto &call : eq.calls)
+            if(call.name == eq.head.name)
+                return true;
+    }
+    return false;
+}
+
+std::vector<std::string> CostEquationSystem::getComponentEntries(const Component &component) const {
+    std::set<std::string> members(component.begin(), component.end());
+    std::set<std::string> entries;
+    for(const auto &eq : equations) {
+        if(members.count(eq.head.name))
+            continue;
+        for(const auto &call : eq.calls)
+            if(members.count(call.name))
+                entries.insert(call.name);
+    }
+    return std::vector<std::string>(entries.begin(), entries.end());
+}
+
+CostTerm CostEquationSystem::getFormalHead(const std::string &name) const {
+    for(const auto &ioVar : ioVars) {
+        if(ioVar.first == name)
+            return CostTerm::parse(CostTerm::parse(ioVar.second).args.front());
+    }
+
+    CostTerm head;
+    head.name = name;
+    for(const auto &eq : equations) {
+        if(eq.head.name == name) {
+            for(std::size_t i = 0; i < eq.head.args.size(); ++i)
+                head.args.push_back("X" + std::to_string(i));
+            break;
+        }
+    }
+    return head;
+}
+
+std::set<std::string> CostEquationSystem::getReachable(const std::string &name) const {
+    std::set<std::string> reachable = {name};
+    std::vector<std::string> worklist = {name};
+    while(!worklist.empty()) {
+        std::string current = worklist.back();
+        worklist.pop_back();
+        for(const auto &eq : equations) {
+            if(eq.head.name != current)
+                continue;
+            for(const auto &call : eq.calls)
+                if(reachable.insert(call.name).second)
+                    worklist.push_back(call.name);
+        }
+    }
+    return reachable;
+}
+
+CostEquationSystem CostEquationSystem::extract(const std::string &name) const {
+    CostEquationSystem ces(*this);
+    ces.entry = getFormalHead(name).str();
+    ces.removeUnreachable();
+    return ces;
+}
+
+bool CostEquationSystem::substituteBound(const std::string &name, const std::string &bound, const Component &component) {
+    CostTerm formalHead = getFormalHead(name);
+
+    // Tokenize the bound and make sure it is a polynomial over the formal
+    // parameters: nat, max and infinity cannot be expressed as a cost
+    std::vector<std::pair<bool, std::string>> tokens; // (is parameter, text)
+    for(std::size_t pos = 0; pos < bound.size();) {
+        char c = bound[pos];
+        if(std::isspace(static_cast<unsigned char>(c))) {
+            ++pos;
+        }
+        else if(std::isdigit(static_cast<unsigned char>(c))) {
+            std::size_t end = pos;
+            while(end < bound.size() && std::isdigit(static_cast<unsigned char>(bound[end])))
+                ++end;
+            tokens.emplace_back(false, bound.substr(pos, end - pos));
+            pos = end;
+        }
+        else if(isIdentifierChar(c)) {
+            std::size_t end = pos;
+            while(end < bound.size() && isIdentifierChar(bound[end]))
+                ++end;
+            std::string identifier = bound.substr(pos, end - pos);
+            if(end < bound.size() && bound[end] == '(')
+                return false;
+            if(std::find(formalHead.args.begin(), formalHead.args.end(), identifier) == formalHead.args.end())
+                return false;
+            tokens.emplace_back(true, identifier);
+            pos = end;
+        }
+        else if(c == '+' || c == '-' || c == '*' || c == '(' || c == ')') {
+            tokens.emplace_back(false, std::string(1, c));
+            ++pos;
+        }
+        else {
+            return false;
+        }
+    }
+    if(tokens.empty())
+        return false;
+
+    std::set<std::string> members(component.begin(), component.end());
+    for(auto &eq : equations) {
+        if(members.count(eq.head.name))
+            continue;
+
+        std::vector<CostTerm> remainingCalls;
+        for(auto &call : eq.calls) {
+            if(call.name != name) {
+                remainingCalls.push_back(std::move(call));
+                continue;
+            }
+
+            std::string cost;
+            for(const auto &token : tokens) {
+                if(!token.first) {
+                    cost += token.second;
+                    continue;
+                }
+                auto it = std::find(formalHead.args.begin(), formalHead.args.end(), token.second);
+                cost += "(" + call.args.at(it - formalHead.args.begin()) + ")";
+            }
+            eq.cost = "(" + eq.cost + ")+(" + cost + ")";
+        }
+        eq.calls = std::move(remainingCalls);
+    }
+
+    return true;
+}
+
+void CostEquationSystem::removeUnreachable() {
+    std::set<std::string> reachable = getReachable(getEntryName());
+
+    equations.erase(std::remove_if(equations.begin(), equations.end(), [&reachable](const CostEquation &eq) {
+        return !reachable.count(eq.head.name);
+    }), equations.end());
+
+    ioVars.erase(std::remove_if(ioVars.begin(), ioVars.end(), [&reachable](const std::pair<std::string, std::string> &ioVar) {
+        return !reachable.count(ioVar.first);
+    }), ioVars.end());
+}
+
+} // end namespace gpscat
@@ -0,0 +1,148 @@
+#include <gpscat/CostExecutor.h>
+#include <gpscat/TargetInstructions.h>
+
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <mutex>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace gpscat {
+
+namespace {
+
+// Global the tick adds to, and the function that calls the entry with
+// its arguments read from an array
+const char *const CounterName = "__gpscat_cost";
+const char *const RunnerName = "__gpscat_run";
+
+void initializeNativeTarget() {
+    static std::once_flag once;
+    std::call_once(once, []() {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+    });
+}
+
+template<typename T>
+T takeOrThrow(llvm::Expected<T> value) {
+    if(!value)
+        throw std::runtime_error(llvm::toString(value.takeError()));
+    return std::move(value.get());
+}
+
+void throwIfFailed(llvm::Error error) {
+    if(error)
+        throw std::runtime_error(llvm::toString(std::move(error)));
+}
+
+} // end anonymous namespace
+
+CostExecutor::CostExecutor(std::unique_ptr<llvm::LLVMContext> ownedContext, std::unique_ptr<llvm::Module> ownedModule, const std::string &functionName) {
+    initializeNativeTarget();
+
+    // Locals, so that the module goes before its context when this throws
+    std::unique_ptr<llvm::LLVMContext> context = std::move(ownedContext);
+    std::unique_ptr<llvm::Module> M = std::move(ownedModule);
+
+    llvm::Function *F = M->getFunction(functionName);
+    if(!F || F->isDeclaration())
+        throw std::runtime_error("Function " + functionName + " is not defined in the module");
+    if(F->isVarArg())
+        throw std::runtime_error("Function " + functionName + " takes variable arguments");
+    for(const llvm::Argument &arg : F->args())
+        if(!arg.getType()->isIntegerTy())
+            throw std::runtime_error("Parameter " + std::to_string(arg.getArgNo()) + " of " + functionName + " is not an integer");
+    numParameters = F->arg_size();
+
+    // The code was generated for the target the costs are for, the JIT
+    // compiles it for the host
+    llvm::orc::JITTargetMachineBuilder JTMB = takeOrThrow(llvm::orc::JITTargetMachineBuilder::detectHost());
+    llvm::DataLayout DL = takeOrThrow(JTMB.getDefaultDataLayoutForTarget());
+    M->setTargetTriple(JTMB.getTargetTriple().str());
+    M->setDataLayout(DL);
+    for(auto &&G : *M) {
+        G.removeFnAttr("target-cpu");
+        G.removeFnAttr("target-features");
+    }
+
+    llvm::LLVMContext &ctx = M->getContext();
+    llvm::Type *int64Ty = llvm::Type::getInt64Ty(ctx);
+    auto *cost = new llvm::GlobalVariable(*M, int64Ty, false, llvm::GlobalValue::ExternalLinkage,
+                                          llvm::ConstantInt::get(int64Ty, 0), CounterName);
+
+    // cost2tick only declares tick
+    if(llvm::Function *tick = M->getFunction("tick")) {
+        if(!tick->isDeclaration() || tick->arg_size() != 1 || !tick->getFunctionType()->getParamType(0)->isIntegerTy())
+            throw std::runtime_error("The module has a tick function that cost2tick did not insert");
+        llvm::IRBuilder<> builder(llvm::BasicBlock::Create(ctx, "", tick));
+        llvm::Value *sum = builder.CreateAdd(builder.CreateLoad(cost), builder.CreateSExt(&*tick->arg_begin(), int64Ty));
+        builder.CreateStore(sum, cost);
+        builder.CreateRetVoid();
+    }
+
+    llvm::Function *runner = llvm::Function::Create(llvm::FunctionType::get(llvm::Type::getVoidTy(ctx), {int64Ty->getPointerTo()}, false),
+                                                    llvm::GlobalValue::ExternalLinkage, RunnerName, M.get());
+    llvm::IRBuilder<> builder(llvm::BasicBlock::Create(ctx, "", runner));
+    std::vector<llvm::Value*> args;
+    for(llvm::Argument &arg : F->args()) {
+        llvm::Value *slot = builder.CreateConstGEP1_64(&*runner->arg_begin(), arg.getArgNo());
+        args.push_back(builder.CreateSExtOrTrunc(builder.CreateLoad(slot), arg.getType()));
+    }
+    builder.CreateCall(F, args);
+    builder.CreateRetVoid();
+
+    std::string error;
+    llvm::raw_string_ostream errorStream(error);
+    if(llvm::verifyModule(*M, &errorStream))
+        throw std::runtime_error("Cannot run " + functionName + ": " + errorStream.str());
+
+    jit = takeOrThrow(llvm::orc::LLJIT::Create(std::move(JTMB), DL));
+    // Calls of the C library and the like resolve to this process
+    jit->getMainJITDylib().setGenerator(takeOrThrow(llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(DL)));
+    throwIfFailed(jit->addIRModule(llvm::orc::ThreadSafeModule(std::move(M), std::move(context))));
+
+    // Everything is compiled here, so that the children only run it
+    counter = reinterpret_cast<std::int64_t*>(static_cast<std::uintptr_t>(takeOrThrow(jit->lookup(CounterName)).getAddress()));
+    entry = reinterpret_cast<void (*)(const std::int64_t*)>(static_cast<std::uintptr_t>(takeOrThrow(jit->lookup(RunnerName)).getAddress()));
+}
+
+CostExecutor::~CostExecutor() = default;
+
+std::optional<std::int64_t> CostExecutor::run(const std::vector<std::int64_t> &args, unsigned int timeoutSeconds) const {
+    if(args.size() != numParameters)
+        return std::nullopt;
+
+    std::vector<std::string> lines = runIsolated(1, [this, &args](std::size_t) {
+        // Whatever the function prints would end up among the results
+        int null = open("/dev/null", O_WRONLY);
+        if(null >= 0) {
+            dup2(null, STDOUT_FILENO);
+            close(null);
+        }
+
+        *counter = 0;
+        entry(args.data());
+        return std::to_string(*counter);
+    }, timeoutSeconds);
+    if(lines.front().empty())
+        return std::nullopt;
+    return std::stoll(lines.front());
+}
+
+} // end namespace gpscat
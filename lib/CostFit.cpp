@@ -0,0 +1,112 @@
+#include <gpscat/CostFit.h>
+
+#include <cmath>
+
+namespace gpscat {
+
+namespace {
+
+// Replaces the symmetric positive definite A by its Cholesky factor L,
+// with A = L L^T. Returns false if A is not positive definite.
+bool choleskyFactor(std::vector<double> &A, std::size_t n) {
+    for(std::size_t j = 0; j < n; ++j) {
+        double d = A[j * n + j];
+        for(std::size_t k = 0; k < j; ++k)
+            d -= A[j * n + k] * A[j * n + k];
+        if(d <= 0)
+            return false;
+        A[j * n + j] = std::sqrt(d);
+        for(std::size_t i = j + 1; i < n; ++i) {
+            double s = A[i * n + j];
+            for(std::size_t k = 0; k < j; ++k)
+                s -= A[i * n + k] * A[j * n + k];
+            A[i * n + j] = s / A[j * n + j];
+        }
+    }
+    return true;
+}
+
+std::vector<double> choleskySolve(const std::vector<double> &L, std::size_t n, std::vector<double> b) {
+    for(std::size_t i = 0; i < n; ++i) {
+        for(std::size_t k = 0; k < i; ++k)
+            b[i] -= L[i * n + k] * b[k];
+        b[i] /= L[i * n + i];
+    }
+    for(std::size_t i = n; i-- > 0;) {
+        for(std::size_t k = i + 1; k < n; ++k)
+            b[i] -= L[k * n + i] * b[k];
+        b[i] /= L[i * n + i];
+    }
+    return b;
+}
+
+} // end anonymous namespace
+
+double getStudentQuantile975(std::size_t degreesOfFreedom) {
+    static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                   2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                   2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if(degreesOfFreedom == 0)
+        return INFINITY;
+    if(degreesOfFreedom <= sizeof(table) / sizeof(table[0]))
+        return table[degreesOfFreedom - 1];
+
+    // The Cornish-Fisher expansion around the normal quantile, within
+    // 0.001 of the exact value from 30 degrees of freedom on
+    const double z = 1.959964, nu = static_cast<double>(degreesOfFreedom);
+    const double z3 = z * z * z, z5 = z3 * z * z, z7 = z5 * z * z;
+    return z + (z3 + z) / (4 * nu) + (5 * z5 + 16 * z3 + 3 * z) / (96 * nu * nu)
+           + (3 * z7 + 19 * z5 + 17 * z3 - 15 * z) / (384 * nu * nu * nu);
+}
+
+bool fitCosts(const std::vector<CostObservation> &observations, std::size_t numVariables, CostFit &fit) {
+    const std::size_t n = numVariables;
+    fit.observed.assign(n, false);
+    std::vector<double> A(n * n, 0.0), b(n, 0.0);
+    for(const auto &observation : observations) {
+        for(const auto &x : observation.counts) {
+            b[x.first] += x.second * observation.value;
+            fit.observed[x.first] = fit.observed[x.first] || x.second != 0;
+            for(const auto &y : observation.counts)
+                A[x.first * n + y.first] += static_cast<double>(x.second) * y.second;
+        }
+    }
+
+    // Variables without observations keep their costs at zero and do not
+    // use up degrees of freedom
+    std::size_t numObserved = 0;
+    for(std::size_t j = 0; j < n; ++j) {
+        if(fit.observed[j])
+            ++numObserved;
+        else
+            A[j * n + j] = 1;
+    }
+    if(observations.size() <= numObserved || !choleskyFactor(A, n))
+        return false;
+    fit.costs = choleskySolve(A, n, b);
+    fit.degreesOfFreedom = observations.size() - numObserved;
+
+    double rss = 0;
+    for(const auto &observation : observations) {
+        double predicted = 0;
+        for(const auto &x : observation.counts)
+            predicted += x.second * fit.costs[x.first];
+        rss += (observation.value - predicted) * (observation.value - predicted);
+    }
+    const double variance = rss / fit.degreesOfFreedom;
+    const double quantile = getStudentQuantile975(fit.degreesOfFreedom);
+
+    // The standard error of each cost is the residual deviation scaled by
+    // the diagonal of the inverse normal matrix
+    fit.halfWidths.assign(n, 0.0);
+    for(std::size_t j = 0; j < n; ++j) {
+        if(!fit.observed[j])
+            continue;
+        std::vector<double> unit(n, 0.0);
+        unit[j] = 1;
+        fit.halfWidths[j] = quantile * std::sqrt(variance * choleskySolve(A, n, unit)[j]);
+    }
+    return true;
+}
+
+} // end namespace gpscat
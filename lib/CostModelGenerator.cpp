@@ -0,0 +1,152 @@
+#include <gpscat/CostModelGenerator.h>
+#include <gpscat/TargetInstructions.h>
+
+#include <llvm/MC/MCAsmInfo.h>
+#include <llvm/MC/MCInst.h>
+#include <llvm/MC/MCInstPrinter.h>
+#include <llvm/MC/MCInstrDesc.h>
+#include <llvm/MC/MCInstrInfo.h>
+#include <llvm/MC/MCRegisterInfo.h>
+#include <llvm/MC/MCSchedule.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/TargetRegistry.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+namespace gpscat {
+
+namespace {
+
+struct Costs {
+    std::vector<std::int64_t> latencies;
+    std::vector<std::int64_t> throughputs;
+};
+
+std::int64_t combine(std::vector<std::int64_t> costs, CostModelGenerator::Aggregate aggregate) {
+    std::sort(costs.begin(), costs.end());
+    if(aggregate == CostModelGenerator::Aggregate::Max)
+        return costs.back();
+    if(aggregate == CostModelGenerator::Aggregate::Min)
+        return costs.front();
+    // The upper median
+    return costs[costs.size() / 2];
+}
+
+void initializeTargets() {
+    static std::once_flag once;
+    std::call_once(once, []() {
+        llvm::InitializeAllTargetInfos();
+        llvm::InitializeAllTargetMCs();
+    });
+}
+
+} // end anonymous namespace
+
+CostModelGenerator::CostModelGenerator(const std::string &arch, const std::string &triple, const std::string &cpu,
+                                       const std::string &features)
+    : triple(triple.empty() ? llvm::sys::getDefaultTargetTriple() : triple) {
+    initializeTargets();
+
+    std::string error;
+    target = llvm::TargetRegistry::lookupTarget(arch, this->triple, error);
+    if(!target)
+        throw std::runtime_error(error);
+
+    MRI.reset(target->createMCRegInfo(this->triple.getTriple()));
+    if(MRI)
+        MAI.reset(target->createMCAsmInfo(*MRI, this->triple.getTriple()));
+    MII.reset(target->createMCInstrInfo());
+    STI.reset(target->createMCSubtargetInfo(this->triple.getTriple(), cpu, features));
+    if(!MRI || !MAI || !MII || !STI)
+        throw std::runtime_error("Target " + this->triple.getTriple() + " has no machine code support");
+    printer.reset(target->createMCInstPrinter(this->triple, MAI->getAssemblerDialect(), *MAI, *MII, *MRI));
+    if(!printer)
+        throw std::runtime_error("Target " + this->triple.getTriple() + " has no instruction printer");
+    if(!STI->getSchedModel().hasInstrSchedModel())
+        throw std::runtime_error("Processor " + (cpu.empty() ? std::string("generic") : cpu) + " of " + this->triple.getTriple()
+                                 + " has no scheduling model");
+}
+
+CostModelGenerator::~CostModelGenerator() = default;
+
+std::vector<CostModelGenerator::Entry> CostModelGenerator::generate(const Options &options) {
+    const llvm::MCSchedModel &schedModel = STI->getSchedModel();
+
+    // Variant classes depend on the operands and cannot be resolved from
+    // the opcode alone, their opcodes are only named
+    std::vector<unsigned int> opcodes;
+    std::vector<const llvm::MCSchedClassDesc*> schedClasses;
+    for(unsigned int opcode = 0; opcode < MII->getNumOpcodes(); ++opcode) {
+        const llvm::MCInstrDesc &desc = MII->get(opcode);
+        if(desc.isPseudo())
+            continue;
+
+        const llvm::MCSchedClassDesc *schedClass = schedModel.getSchedClassDesc(desc.getSchedClass());
+        if(!schedClass || !schedClass->isValid() || schedClass->isVariant()) {
+            if(options.log && options.verbosity >= 1)
+                *options.log << "No scheduling information for " << MII->getName(opcode).str() << std::endl;
+            schedClass = nullptr;
+        }
+
+        opcodes.push_back(opcode);
+        schedClasses.push_back(schedClass);
+    }
+
+    std::vector<std::string> mnemonics = runIsolated(opcodes.size(), [this, &opcodes](std::size_t i) {
+        return getMnemonic(printInstruction(createPlaceholder(opcodes[i], *MII, *MRI), *printer, *STI)).str();
+    });
+
+    // Opcodes printed with the same mnemonic, such as the register and
+    // memory forms of an instruction, share one cost. The median keeps
+    // rare forms, like moves to control registers, from dominating.
+    std::map<std::string, Costs> mnemonicCosts;
+    std::set<std::string> unscheduled;
+    for(std::size_t i = 0; i < opcodes.size(); ++i) {
+        const std::string &mnemonic = mnemonics[i];
+        if(mnemonic.empty() || mnemonic[0] == '#' || mnemonic.find_first_of(",\"") != std::string::npos) {
+            if(options.log && options.verbosity >= 1)
+                *options.log << "No mnemonic for " << MII->getName(opcodes[i]).str() << std::endl;
+            continue;
+        }
+        if(!schedClasses[i]) {
+            unscheduled.insert(mnemonic);
+            continue;
+        }
+
+        auto toCost = [&options](double cycles) {
+            return static_cast<std::int64_t>(std::ceil(cycles * options.scale));
+        };
+        Costs &costs = mnemonicCosts[mnemonic];
+        costs.latencies.push_back(toCost(llvm::MCSchedModel::computeInstrLatency(*STI, *schedClasses[i])));
+        costs.throughputs.push_back(toCost(llvm::MCSchedModel::getReciprocalThroughput(*STI, *schedClasses[i])));
+    }
+
+    unscheduledMnemonics.clear();
+    for(const auto &mnemonic : unscheduled)
+        if(!mnemonicCosts.count(mnemonic))
+            unscheduledMnemonics.push_back(mnemonic);
+
+    std::vector<Entry> entries;
+    for(const auto &[mnemonic, costs] : mnemonicCosts)
+        entries.push_back({mnemonic, combine(costs.latencies, options.aggregate), combine(costs.throughputs, options.aggregate)});
+    return entries;
+}
+
+std::string CostModelGenerator::toCSV(const std::vector<Entry> &entries, bool latencyFirst) {
+    std::string csv = std::string("Opcode,Cost,") + (latencyFirst ? "throughput" : "latency") + "\n";
+    for(const auto &entry : entries) {
+        csv += entry.mnemonic + "," + std::to_string(latencyFirst ? entry.latency : entry.throughput) + ","
+               + std::to_string(latencyFirst ? entry.throughput : entry.latency) + "\n";
+    }
+    return csv;
+}
+
+} // end namespace gpscat
@@ -1,27 +1,56 @@
 #include <gpscat/IRCostCalculator.h>
 
+#include <llvm/IR/Constants.h>
 #include <llvm/IR/Instruction.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Metadata.h>
 
+#include <algorithm>
 #include <iostream>
 
 namespace gpscat {
 
-void IRCostCalculator::visitInstruction(llvm::Instruction &I) {
-    const auto& it = IRAsmMap.find(&I);
-    if(it == IRAsmMap.end()) {
-        //std::cerr << "Cannot find corresponding asm instructions of " << &I << ' ' << I.getOpcodeName() << std::endl;
-        return;
+IRCostCalculator::IRCostCalculator(llvm::Module *M, const AssemblyCostModel &costModel, const IRAsmMapping &mapping,
+                                   const std::vector<CostTy> &scheduledCosts)
+    : M(M), numResources(costModel.getNumResources()), numIDs(std::max<std::size_t>(mapping.getNumIDs(), scheduledCosts.size())),
+      instCosts(numResources * numIDs, 0), instructions(numIDs, nullptr) {
+    for(auto &&F : *M) {
+        for(auto &&BB : F) {
+            for(auto &&I : BB) {
+                const llvm::DebugLoc &loc = I.getDebugLoc();
+                if(loc && loc.getLine() < numIDs && !instructions[loc.getLine()])
+                    instructions[loc.getLine()] = &I;
+            }
+        }
     }
 
-    const auto& asmInstSet = it->second;
+    // All resources in one pass over the mapping
+    std::size_t firstResource = scheduledCosts.empty() ? 0 : 1;
+    for(InstructionID ID = 0; ID < mapping.getNumIDs(); ++ID) {
+        for(OpcodeID opcode : mapping.getOpcodes(ID)) {
+            for(std::size_t resource = firstResource; resource < numResources; ++resource)
+                instCosts[resource * numIDs + ID] += costModel.getCost(opcode, resource);
+        }
+    }
+    std::copy(scheduledCosts.begin(), scheduledCosts.end(), instCosts.begin());
+}
+
+CostTy IRCostCalculator::getBlockCost(const llvm::BasicBlock *BB, std::size_t resource) const {
+    CostTy cost = 0;
+    for(auto &&I : *BB)
+        cost += getInstCost(&I, resource);
+    return cost;
+}
 
-    for(const auto& asmInst : asmInstSet) {
-        auto cost = costModel.get(asmInst.getName());
-        instCostMap[&I] += cost;
-        blockCostMap[I.getParent()] += cost;
+BlockCostMapType IRCostCalculator::getBlockCostMap(std::size_t resource) const {
+    BlockCostMapType blockCostMap;
+    for(auto &&F : *M) {
+        for(auto &&BB : F) {
+            if(CostTy cost = getBlockCost(&BB, resource))
+                blockCostMap[&BB] = cost;
+        }
     }
+    return blockCostMap;
 }
 
 void IRCostCalculator::generateInstCostMetadata(llvm::Module *M) const {
@@ -29,8 +58,7 @@ void IRCostCalculator::generateInstCostMetadata(llvm::Module *M) const {
         for(auto &&BB : F) {
             for(auto &&I : BB) {
                 // Query instruction cost
-                const auto& it = instCostMap.find(&I);
-                auto cost = it == instCostMap.end() ? 0 : it->second;
+                auto cost = getInstCost(&I);
 
                 // Beware of the hard-coded integer type
                 const auto& costAsConstant = llvm::ConstantInt::get(llvm::Type::getInt32Ty(I.getContext()), cost);
@@ -46,8 +74,7 @@ void IRCostCalculator::generateBlockCostMetadata(llvm::Module *M) const {
     for(auto &&F : *M) {
         for(auto &&BB : F) {
             // Query block cost
-            const auto& it = blockCostMap.find(&BB);
-            auto cost = it == blockCostMap.end() ? 0 : it->second;
+            auto cost = getBlockCost(&BB);
 
             // Beware of the hard-coded integer type
             const auto& costAsConstant = llvm::ConstantInt::get(llvm::Type::getInt32Ty(BB.getContext()), cost);
@@ -1,35 +1,75 @@
 #include <gpscat/IRLocator.h>
 
-#include <llvm/IR/Module.h>
-#include <llvm/IR/LegacyPassManager.h>
-#include <llvm/Transforms/IPO.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/BinaryFormat/Dwarf.h>
+#include <llvm/IR/DIBuilder.h>
+#include <llvm/IR/DebugInfo.h>
+#include <llvm/IR/DebugInfoMetadata.h>
 #include <llvm/IR/IntrinsicInst.h>
-
-#include <opt/Debugify.h>
+#include <llvm/IR/Module.h>
 
 namespace gpscat {
 
+// Like debugify, which gave the IDs before, so that they stay the same
+static bool isLocated(const llvm::Function &F) {
+    return !F.isDeclaration() && F.hasExactDefinition();
+}
+
 void IRLocator::run(llvm::Module *M) {
-    llvm::legacy::PassManager PM;
-
-    // The debugify pass does exactly what we want
-    // Before debugify pass, we need to strip debug symbols
-    PM.add(llvm::createStripSymbolsPass(true));
-    PM.add(createDebugifyModulePass());
-
-    PM.run(*M);
-
-    // remove debug intrinsics
-    for(auto &F : *M) {
-        for(auto &BB : F) {
-            for(auto II = BB.begin(); II != BB.end();) {
-                auto &I = *II++;
-                if(llvm::isa<llvm::DbgInfoIntrinsic>(&I)) {
-                    I.eraseFromParent();
+    // The IDs start at 1
+    sourceLocations.assign(1, SourceLocation());
+    sourceFiles.clear();
+    llvm::StringMap<std::uint32_t> fileIndices;
+    for(auto &&F : *M) {
+        if(!isLocated(F))
+            continue;
+        for(auto &&BB : F) {
+            for(auto &&I : BB) {
+                // Stripped below, they get no ID
+                if(llvm::isa<llvm::DbgInfoIntrinsic>(&I))
+                    continue;
+
+                SourceLocation location;
+                if(const llvm::DebugLoc &loc = I.getDebugLoc()) {
+                    auto inserted = fileIndices.try_emplace(loc->getFilename(), static_cast<std::uint32_t>(sourceFiles.size()));
+                    if(inserted.second)
+                        sourceFiles.push_back(loc->getFilename().str());
+                    location = {inserted.first->second, loc.getLine()};
                 }
+                sourceLocations.push_back(location);
             }
         }
     }
+
+    // Locations of the source would be taken for IDs
+    llvm::StripDebugInfo(*M);
+
+    llvm::LLVMContext &ctx = M->getContext();
+    llvm::DIBuilder DIB(*M);
+    llvm::DIFile *file = DIB.createFile(M->getName(), "/");
+    llvm::DICompileUnit *CU = DIB.createCompileUnit(llvm::dwarf::DW_LANG_C, file, "gpscat", true, "", 0);
+    llvm::DISubroutineType *type = DIB.createSubroutineType(DIB.getOrCreateTypeArray(llvm::None));
+
+    unsigned int nextLine = 1;
+    for(auto &&F : *M) {
+        if(!isLocated(F))
+            continue;
+
+        llvm::DISubprogram::DISPFlags flags = llvm::DISubprogram::SPFlagDefinition | llvm::DISubprogram::SPFlagOptimized;
+        if(F.hasLocalLinkage())
+            flags |= llvm::DISubprogram::SPFlagLocalToUnit;
+        llvm::DISubprogram *SP = DIB.createFunction(CU, F.getName(), F.getName(), file, nextLine, type, nextLine, llvm::DINode::FlagZero, flags);
+        F.setSubprogram(SP);
+
+        for(auto &&BB : F)
+            for(auto &&I : BB)
+                I.setDebugLoc(llvm::DILocation::get(ctx, nextLine++, 1, SP));
+    }
+    DIB.finalize();
+
+    // Without it, the verifier of llc drops the locations
+    if(!M->getModuleFlag("Debug Info Version"))
+        M->addModuleFlag(llvm::Module::Warning, "Debug Info Version", llvm::DEBUG_METADATA_VERSION);
 }
 
 } // end namespace gpscat
@@ -0,0 +1,15 @@
+#include <gpscat/IncrementalAnalyzer.h>
+
+namespace gpscat {
+
+AnalysisResult IncrementalAnalyzer::analyze(llvm::Module *M, const Deadline &deadline) {
+    AnalysisResult result = analyzer.analyze(M, cache, deadline);
+
+    // In memory, everything the analysis did not look up belongs to
+    // removed or changed functions
+    if(evictAfterAnalysis)
+        cache.evict();
+    return result;
+}
+
+} // end namespace gpscat
@@ -1,73 +1,124 @@
 #include <gpscat/MappingExtractor.h>
 #include <gpscat/IRLocator.h>
-#include <gpscat/AssemblyInstruction.h>
 #include <gpscat/AssemblyCostModel.h>
-#include <gpscat/Utils.h>
 
+#include <llvm/ADT/StringRef.h>
 #include <llvm/IR/DebugLoc.h>
+#include <llvm/Support/MemoryBuffer.h>
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
 #include <iostream>
-#include <fstream>
 
 namespace gpscat {
 
-IRIDAsmMapType MappingExtractor::extractMapping(const std::string &path, const AssemblyCostModel &costModel) {
-    IRIDAsmMapType IRIDAsmMap;
+namespace {
 
-    InstructionID currentLocLineno = 0;
-    std::string line;
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Returns the next whitespace separated token of the current line and
+// moves pos past it, or an empty token at the end of the line
+llvm::StringRef nextToken(const char *&pos, const char *end) {
+    while(pos != end && isBlank(*pos))
+        ++pos;
+    const char *begin = pos;
+    while(pos != end && *pos != '\n' && !isBlank(*pos))
+        ++pos;
+    return llvm::StringRef(begin, pos - begin);
+}
+
+} // end anonymous namespace
+
+IRAsmMapping MappingExtractor::extractMapping(const std::string &path, const AssemblyCostModel &costModel) {
+    IRAsmMapping mapping;
+
+    // Large files are mapped rather than read
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path);
+    if(!buffer) {
+        std::cerr << "Cannot read " << path << ": " << buffer.getError().message() << std::endl;
+        return mapping;
+    }
+
+    // Instructions of different IDs interleave in the assembly, so the
+    // opcodes are collected first and grouped by ID afterwards
+    std::vector<std::pair<InstructionID, OpcodeID>> located;
+    InstructionID maxID = 0;
 
-    std::ifstream inputFile(path);
+    InstructionID currentLocLineno = 0;
+    const char *pos = (*buffer)->getBufferStart();
+    const char *end = (*buffer)->getBufferEnd();
     std::size_t lineNum = 0;
-    while(std::getline(inputFile, line)) {
+    while(pos != end) {
         ++lineNum;
-        const auto& tokens = split(line);
-        
-        if(tokens.empty())
-            continue;
+        // Only the first token, and the fields of .loc, are looked at;
+        // the rest of the line is skipped without being tokenized
+        llvm::StringRef first = nextToken(pos, end);
 
         // .loc directives
         // .loc fileno lineno [column] [options]
         // lineno == 0 indicates that no source line has been specified accoring to DWARF.
-        if(tokens[0] == ".loc" && tokens.size() >= 3) {
+        if(first == ".loc") {
+            nextToken(pos, end);
+            llvm::StringRef lineno = nextToken(pos, end);
             // Beware of the hardcoded type
-            currentLocLineno = std::stoul(tokens[2]);
+            if(!lineno.empty() && lineno.getAsInteger(10, currentLocLineno))
+                currentLocLineno = 0;
         }
         // known assembly instructions
-        else if(costModel.hasInst(tokens[0])) {
-            if(currentLocLineno == 0)
-                std::cerr << "No corresponding LLVM IR instruction for Assembly instruction: "
-                          << lineNum << "\t" << tokens[0] << std::endl;
-            IRIDAsmMap[currentLocLineno].push_back(AssemblyInstruction(tokens[0]));
+        else if(!first.empty()) {
+            if(OpcodeID opcode = costModel.getOpcodeID(first); opcode != AssemblyCostModel::InvalidOpcode) {
+                if(currentLocLineno == 0)
+                    std::cerr << "No corresponding LLVM IR instruction for Assembly instruction: "
+                              << lineNum << "\t" << first.str() << std::endl;
+                located.emplace_back(currentLocLineno, opcode);
+                maxID = std::max(maxID, currentLocLineno);
+            }
         }
+
+        pos = std::find(pos, end, '\n');
+        if(pos != end)
+            ++pos;
     }
-    return IRIDAsmMap;
+
+    // Counting sort by ID, keeping the assembly order within an ID
+    if(located.empty())
+        return mapping;
+    mapping.offsets.assign(static_cast<std::size_t>(maxID) + 2, 0);
+    for(const auto &entry : located)
+        ++mapping.offsets[entry.first + 1];
+    for(std::size_t i = 1; i < mapping.offsets.size(); ++i)
+        mapping.offsets[i] += mapping.offsets[i - 1];
+
+    mapping.opcodes.resize(located.size());
+    std::vector<std::uint32_t> next(mapping.offsets.begin(), mapping.offsets.end() - 1);
+    for(const auto &entry : located)
+        mapping.opcodes[next[entry.first]++] = entry.second;
+    return mapping;
 }
 
-IRAsmMapType MappingExtractor::extractMapping(const std::string &path, const AssemblyCostModel &costModel, llvm::Module* M) {
-    IRIDAsmMapType IRIDAsmMap = extractMapping(path, costModel);
+IRAsmMapping MappingExtractor::extractMapping(const std::string &path, const AssemblyCostModel &costModel, llvm::Module* M) {
+    IRAsmMapping mapping = extractMapping(path, costModel);
 
-    InstIDPtrMapType instIDPtrMap;
+    std::vector<bool> known(mapping.getNumIDs(), false);
     for(auto& F : *M) {
         for(auto& BB : F) {
             for(auto& I : BB) {
-                if(const llvm::DebugLoc &loc = I.getDebugLoc()) {
-                    instIDPtrMap[loc.getLine()] = &I;
+                if(const llvm::DebugLoc &loc = I.getDebugLoc(); loc && loc.getLine() < known.size()) {
+                    known[loc.getLine()] = true;
                 }
             }
         }
     }
 
-    IRAsmMapType IRAsmMap;
-    for(const auto& [IRID, Asms] : IRIDAsmMap) {
-        if(const auto& it = instIDPtrMap.find(IRID); it != instIDPtrMap.end())
-            IRAsmMap[it->second] = std::move(Asms);
-        else if(IRID != 0)
-            std::cerr << "Cannot find corresponding instruction ID : " << IRID << std::endl;
+    for(InstructionID ID = 1; ID < known.size(); ++ID) {
+        if(!known[ID] && !mapping.getOpcodes(ID).empty())
+            std::cerr << "Cannot find corresponding instruction ID : " << ID << std::endl;
     }
-    return IRAsmMap;
+    return mapping;
 }
 
 } // end namespace gpscat
@@ -0,0 +1,259 @@
+#include <gpscat/ProcessSupervisor.h>
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gpscat {
+
+// Process groups to kill on SIGINT. A plain array of atomics, so that the
+// signal handler neither allocates nor locks.
+static constexpr std::size_t maxProcessGroups = 1024;
+static std::atomic<pid_t> processGroups[maxProcessGroups];
+
+static sigset_t getHandledSignals() {
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    return signals;
+}
+
+static void killAllAndReraise(int signalNumber) {
+    for(auto &pgid : processGroups) {
+        pid_t group = pgid.load();
+        if(group > 0)
+            kill(-group, SIGKILL);
+    }
+    signal(signalNumber, SIG_DFL);
+    raise(signalNumber);
+}
+
+ProcessSupervisor &ProcessSupervisor::get() {
+    static ProcessSupervisor supervisor;
+    return supervisor;
+}
+
+bool ProcessSupervisor::configure(unsigned int maxChildren, unsigned int memoryBudgetMB, const ResourceLimits &childLimits) {
+    if(memoryBudgetMB && !childLimits.memoryLimitMB)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->maxChildren = maxChildren;
+        this->memoryBudgetMB = memoryBudgetMB;
+        this->childLimits = childLimits;
+    }
+    admissionCondition.notify_all();
+    return true;
+}
+
+void ProcessSupervisor::installSignalHandlers() {
+    signal(SIGINT, killAllAndReraise);
+    signal(SIGTERM, killAllAndReraise);
+}
+
+void ProcessSupervisor::prepareChild() const {
+    setpgid(0, 0);
+
+    // The handler would kill the groups of the parent
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    sigset_t handledSignals = getHandledSignals();
+    pthread_sigmask(SIG_UNBLOCK, &handledSignals, nullptr);
+
+    if(childLimits.memoryLimitMB) {
+        rlim_t bytes = static_cast<rlim_t>(childLimits.memoryLimitMB) * 1024 * 1024;
+        rlimit limit = {bytes, bytes};
+        setrlimit(RLIMIT_AS, &limit);
+    }
+    if(childLimits.cpuLimitSeconds) {
+        // SIGXCPU at the soft limit, SIGKILL one second later
+        rlimit limit = {childLimits.cpuLimitSeconds, childLimits.cpuLimitSeconds + 1};
+        setrlimit(RLIMIT_CPU, &limit);
+    }
+}
+
+bool ProcessSupervisor::registerProcessGroup(pid_t pgid) {
+    for(auto &slot : processGroups) {
+        pid_t empty = 0;
+        if(slot.compare_exchange_strong(empty, pgid))
+            return true;
+    }
+    return false;
+}
+
+pid_t ProcessSupervisor::forkChild() {
+    // A signal between fork and registration would leave the child
+    // running, so the handled signals wait until it is registered
+    sigset_t handledSignals = getHandledSignals();
+    sigset_t previousMask;
+    pthread_sigmask(SIG_BLOCK, &handledSignals, &previousMask);
+
+    pid_t pid = fork();
+    if(pid == 0) {
+        prepareChild();
+        return 0;
+    }
+
+    bool registered = false;
+    if(pid > 0) {
+        // Also set from the parent, so the group exists before we may kill it
+        setpgid(pid, pid);
+        registered = registerProcessGroup(pid);
+        if(!registered) {
+            killProcessGroup(pid);
+            waitpid(pid, nullptr, 0);
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &previousMask, nullptr);
+
+    if(pid > 0 && !registered) {
+        std::cerr << "More than " << maxProcessGroups << " child processes at once, not starting another one." << std::endl;
+        return -1;
+    }
+    return pid;
+}
+
+void ProcessSupervisor::unregisterProcessGroup(pid_t pgid) {
+    for(auto &slot : processGroups) {
+        pid_t expected = pgid;
+        if(slot.compare_exchange_strong(expected, 0))
+            return;
+    }
+}
+
+void ProcessSupervisor::killProcessGroup(pid_t pgid) {
+    if(pgid > 0)
+        kill(-pgid, SIGKILL);
+}
+
+int ProcessSupervisor::run(const std::string &program, const std::vector<std::string> &args, const std::string &outputPath,
+                           unsigned int timeoutSeconds, const std::atomic<bool> *cancelled) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeoutSeconds);
+    auto expired = [&]() {
+        return (timeoutSeconds && std::chrono::steady_clock::now() >= deadline) || (cancelled && *cancelled);
+    };
+
+    // Admission: a child reserves its memory limit from the budget. A child
+    // larger than the whole budget is still admitted when nothing else runs.
+    unsigned int reservation;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        reservation = childLimits.memoryLimitMB;
+        auto admissible = [&]() {
+            if(numRunning == 0)
+                return true;
+            if(maxChildren && numRunning >= maxChildren)
+                return false;
+            return !memoryBudgetMB || reservedMemoryMB + reservation <= memoryBudgetMB;
+        };
+        while(!admissible()) {
+            if(expired())
+                return -1;
+            admissionCondition.wait_for(lock, std::chrono::milliseconds(50));
+        }
+        ++numRunning;
+        reservedMemoryMB += reservation;
+    }
+
+    auto release = [this, reservation]() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --numRunning;
+            reservedMemoryMB -= reservation;
+        }
+        admissionCondition.notify_all();
+    };
+
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(program.c_str()));
+    for(const auto &arg : args)
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    pid_t pid = forkChild();
+    if(pid == 0) {
+        if(!outputPath.empty()) {
+            int outputFd = open(outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if(outputFd < 0)
+                _exit(127);
+            dup2(outputFd, STDOUT_FILENO);
+            close(outputFd);
+        }
+        execv(program.c_str(), argv.data());
+        _exit(127);
+    }
+    if(pid < 0) {
+        release();
+        return -1;
+    }
+
+    // Wakes up when the child exits instead of polling for it, where the
+    // kernel has pidfds
+    int pidfd = -1;
+#ifdef SYS_pidfd_open
+    pidfd = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+#endif
+
+    int exitCode = -1;
+    while(true) {
+        int status;
+        pid_t result = waitpid(pid, &status, WNOHANG);
+        if(result == pid) {
+            exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+            break;
+        }
+        if(result < 0 && errno != EINTR)
+            break;
+
+        if(expired()) {
+            killProcessGroup(pid);
+            waitpid(pid, nullptr, 0);
+            break;
+        }
+
+        if(pidfd < 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        // Until the child exits or the timeout expires; cancellation is
+        // a flag, which is looked at every 100 ms
+        int waitMilliseconds = cancelled ? 100 : -1;
+        if(timeoutSeconds) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count() + 1;
+            int remainingMilliseconds = static_cast<int>(std::min<decltype(remaining)>(remaining, std::numeric_limits<int>::max()));
+            waitMilliseconds = waitMilliseconds < 0 ? remainingMilliseconds : std::min(waitMilliseconds, remainingMilliseconds);
+        }
+        pollfd pfd = {pidfd, POLLIN, 0};
+        poll(&pfd, 1, waitMilliseconds);
+    }
+    if(pidfd >= 0)
+        close(pidfd);
+
+    // Leftover grandchildren die with their group
+    killProcessGroup(pid);
+    unregisterProcessGroup(pid);
+    release();
+
+    return exitCode;
+}
+
+} // end namespace gpscat
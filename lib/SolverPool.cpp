@@ -0,0 +1,67 @@
+#include <gpscat/SolverPool.h>
+#include <gpscat/Subprocess.h>
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gpscat {
+
+SolverPool::SolverPool(const std::string &program, const std::vector<std::string> &args, unsigned int numWorkers, unsigned int timeoutSeconds)
+    : program(program), args(args), timeoutSeconds(timeoutSeconds), workers(numWorkers ? numWorkers : 1) {
+    // Workers are started lazily by their first query
+    for(std::size_t slot = workers.size(); slot > 0; --slot)
+        idleSlots.push_back(slot - 1);
+}
+
+std::size_t SolverPool::acquire() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idleCondition.wait(lock, [this]() { return !idleSlots.empty(); });
+    std::size_t slot = idleSlots.back();
+    idleSlots.pop_back();
+    return slot;
+}
+
+void SolverPool::release(std::size_t slot) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        idleSlots.push_back(slot);
+    }
+    idleCondition.notify_one();
+}
+
+std::string SolverPool::solve(const std::string &path, unsigned int timeoutSeconds, const std::vector<std::string> &queryArgs) {
+    std::size_t slot = acquire();
+    auto &worker = workers[slot];
+
+    if(!worker || !worker->isRunning())
+        worker = std::make_unique<Subprocess>(program, args);
+
+    std::string request = path;
+    for(const auto &arg : queryArgs)
+        request += "\t" + arg;
+
+    std::string response;
+    bool answered = worker->writeLine(request) && worker->readLine(response, timeoutSeconds ? timeoutSeconds : this->timeoutSeconds);
+
+    std::string bound;
+    if(answered && response.compare(0, 3, "ok ") == 0) {
+        bound = response.substr(3);
+    }
+    else if(answered && response.compare(0, 6, "error ") == 0) {
+        std::cerr << "Solver worker failed: " << response.substr(6) << std::endl;
+    }
+    else {
+        std::cerr << "Solver worker crashed or timed out, recycling it." << std::endl;
+        worker.reset();
+        std::lock_guard<std::mutex> lock(mutex);
+        ++numRecycledWorkers;
+    }
+
+    release(slot);
+    return bound;
+}
+
+} // end namespace gpscat
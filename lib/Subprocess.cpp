@@ -0,0 +1,136 @@
+#include <gpscat/Subprocess.h>
+#include <gpscat/ProcessSupervisor.h>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <sys/types.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace gpscat {
+
+static std::vector<char*> makeArgv(const std::string &program, const std::vector<std::string> &args) {
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(program.c_str()));
+    for(const auto &arg : args)
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+    return argv;
+}
+
+Subprocess::Subprocess(const std::string &program, const std::vector<std::string> &args) {
+    // A socket pair instead of two pipes: a single descriptor for both
+    // directions, and send() can suppress SIGPIPE when the child has died.
+    // Close-on-exec, so that the other workers and tools do not inherit it
+    // and keep a dead worker's socket open; dup2 clears it for this child.
+    int fds[2];
+    if(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+        return;
+
+    std::vector<char*> argv = makeArgv(program, args);
+
+    pid = ProcessSupervisor::get().forkChild();
+    if(pid == 0) {
+        close(fds[0]);
+        dup2(fds[1], STDIN_FILENO);
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[1]);
+        execvp(program.c_str(), argv.data());
+        _exit(127);
+    }
+
+    close(fds[1]);
+    if(pid < 0) {
+        close(fds[0]);
+        return;
+    }
+    fd = fds[0];
+}
+
+Subprocess::~Subprocess() {
+    kill();
+}
+
+bool Subprocess::isRunning() {
+    if(pid <= 0)
+        return false;
+    int status;
+    if(waitpid(pid, &status, WNOHANG) == pid) {
+        ProcessSupervisor::killProcessGroup(pid);
+        ProcessSupervisor::get().unregisterProcessGroup(pid);
+        pid = -1;
+        return false;
+    }
+    return true;
+}
+
+bool Subprocess::writeLine(const std::string &line) {
+    if(fd < 0)
+        return false;
+    std::string message = line + "\n";
+    std::size_t written = 0;
+    while(written < message.size()) {
+        ssize_t n = send(fd, message.data() + written, message.size() - written, MSG_NOSIGNAL);
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n <= 0)
+            return false;
+        written += n;
+    }
+    return true;
+}
+
+bool Subprocess::readLine(std::string &line, unsigned int timeoutSeconds) {
+    if(fd < 0)
+        return false;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeoutSeconds);
+    while(true) {
+        auto newline = buffer.find('\n');
+        if(newline != std::string::npos) {
+            line = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            return true;
+        }
+
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if(remaining.count() <= 0)
+            return false;
+
+        pollfd pfd = {fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, static_cast<int>(remaining.count()));
+        if(ready < 0 && errno == EINTR)
+            continue;
+        if(ready <= 0)
+            return false;
+
+        char chunk[4096];
+        ssize_t n = read(fd, chunk, sizeof(chunk));
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n <= 0)
+            return false;
+        buffer.append(chunk, n);
+    }
+}
+
+void Subprocess::kill() {
+    if(fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    if(pid > 0) {
+        ProcessSupervisor::killProcessGroup(pid);
+        waitpid(pid, nullptr, 0);
+        ProcessSupervisor::get().unregisterProcessGroup(pid);
+        pid = -1;
+    }
+}
+
+} // end namespace gpscat
@@ -0,0 +1,103 @@
+#include <gpscat/TargetInstructions.h>
+
+#include <llvm/MC/MCInstPrinter.h>
+#include <llvm/MC/MCInstrDesc.h>
+#include <llvm/MC/MCInstrInfo.h>
+#include <llvm/MC/MCRegisterInfo.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cctype>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace gpscat {
+
+llvm::MCInst createPlaceholder(unsigned int opcode, const llvm::MCInstrInfo &MII, const llvm::MCRegisterInfo &MRI) {
+    const llvm::MCInstrDesc &desc = MII.get(opcode);
+    llvm::MCInst inst;
+    inst.setOpcode(opcode);
+    for(const llvm::MCOperandInfo &info : llvm::make_range(desc.opInfo_begin(), desc.opInfo_end())) {
+        if(info.RegClass >= 0 && static_cast<unsigned int>(info.RegClass) < MRI.getNumRegClasses()
+           && MRI.getRegClass(info.RegClass).getNumRegs() > 0)
+            inst.addOperand(llvm::MCOperand::createReg(MRI.getRegClass(info.RegClass).getRegister(0)));
+        else if(info.OperandType == llvm::MCOI::OPERAND_REGISTER)
+            inst.addOperand(llvm::MCOperand::createReg(0));
+        else
+            inst.addOperand(llvm::MCOperand::createImm(0));
+    }
+    return inst;
+}
+
+std::string printInstruction(const llvm::MCInst &inst, llvm::MCInstPrinter &printer, const llvm::MCSubtargetInfo &STI) {
+    std::string text;
+    llvm::raw_string_ostream os(text);
+    printer.printInst(&inst, os, "", STI);
+    os.flush();
+
+    std::replace(text.begin(), text.end(), '\n', ' ');
+    std::replace(text.begin(), text.end(), '\t', ' ');
+    return llvm::StringRef(text).trim().str();
+}
+
+llvm::StringRef getMnemonic(llvm::StringRef text) {
+    return text.ltrim().take_until([](char c) {
+        return std::isspace(static_cast<unsigned char>(c));
+    });
+}
+
+std::vector<std::string> runIsolated(std::size_t count, const std::function<std::string(std::size_t)> &produce,
+                                     unsigned int timeoutSeconds) {
+    std::vector<std::string> lines(count);
+    std::size_t next = 0;
+    while(next < count) {
+        int fds[2];
+        if(pipe(fds) != 0)
+            break;
+        pid_t pid = fork();
+        if(pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            break;
+        }
+        if(pid == 0) {
+            close(fds[0]);
+            // SIGALRM ends the child where it hangs, like a crash
+            signal(SIGALRM, SIG_DFL);
+            for(std::size_t i = next; i < count; ++i) {
+                alarm(timeoutSeconds);
+                std::string line = produce(i) + "\n";
+                alarm(0);
+                if(write(fds[1], line.data(), line.size()) != static_cast<ssize_t>(line.size()))
+                    _exit(1);
+            }
+            _exit(0);
+        }
+
+        close(fds[1]);
+        std::string pending;
+        char buffer[4096];
+        ssize_t n;
+        while((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+            pending.append(buffer, n);
+            std::size_t end;
+            while((end = pending.find('\n')) != std::string::npos && next < count) {
+                lines[next++] = pending.substr(0, end);
+                pending.erase(0, end + 1);
+            }
+        }
+        close(fds[0]);
+
+        int status = 0;
+        waitpid(pid, &status, 0);
+        // The child died at next
+        if(next < count)
+            ++next;
+    }
+    return lines;
+}
+
+} // end namespace gpscat
@@ -0,0 +1,148 @@
+#include <gpscat/TickCoalescer.h>
+
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+
+namespace gpscat {
+
+BlockCostMapType TickCoalescer::run(llvm::Module *M, const BlockCostMapType &blockCostMap) {
+    BlockCostMapType costs(blockCostMap);
+
+    for(auto &&F : *M) {
+        if(F.isDeclaration())
+            continue;
+
+        // The CFG is never modified, only the costs move around
+        llvm::DominatorTree DT(F);
+        llvm::LoopInfo LI(DT);
+
+        bool changed = true;
+        while(changed) {
+            changed = coalesceChains(F, costs);
+            changed |= coalesceBranchArms(F, costs);
+            changed |= coalesceIntoLoopHeaders(LI, DT, costs);
+        }
+    }
+
+    // Blocks without cost should not get a tick call at all
+    for(auto it = costs.begin(); it != costs.end();) {
+        if(it->second == 0)
+            it = costs.erase(it);
+        else
+            ++it;
+    }
+
+    return costs;
+}
+
+bool TickCoalescer::coalesceChains(llvm::Function &F, BlockCostMapType &costs) {
+    // BB -> S where BB is the only predecessor of S and S is the only
+    // successor of BB: both blocks are always executed the same number of times.
+    bool changed = false;
+    for(auto &&BB : F) {
+        llvm::BasicBlock *S = BB.getSingleSuccessor();
+        if(!S || S == &BB || S->getSinglePredecessor() != &BB)
+            continue;
+
+        auto it = costs.find(S);
+        if(it == costs.end() || it->second == 0)
+            continue;
+
+        // Read the cost before operator[] may rehash the map
+        CostTy cost = it->second;
+        it->second = 0;
+        costs[&BB] += cost;
+        changed = true;
+    }
+    return changed;
+}
+
+bool TickCoalescer::coalesceBranchArms(llvm::Function &F, BlockCostMapType &costs) {
+    // D branches to S1..Sn and D is the only predecessor of every Si:
+    // each execution of D is followed by exactly one arm, so when all arms
+    // cost the same, their common cost can be charged to D instead.
+    bool changed = false;
+    for(auto &&D : F) {
+        llvm::SmallPtrSet<llvm::BasicBlock*, 4> arms;
+        for(llvm::BasicBlock *S : llvm::successors(&D))
+            arms.insert(S);
+        if(arms.size() < 2)
+            continue;
+
+        bool foldable = true;
+        CostTy armCost = 0;
+        for(llvm::BasicBlock *S : arms) {
+            if(S == &D || S->getSinglePredecessor() != &D) {
+                foldable = false;
+                break;
+            }
+            auto it = costs.find(S);
+            CostTy cost = it == costs.end() ? 0 : it->second;
+            if(S == *arms.begin())
+                armCost = cost;
+            else if(cost != armCost) {
+                foldable = false;
+                break;
+            }
+        }
+        if(!foldable || armCost == 0)
+            continue;
+
+        for(llvm::BasicBlock *S : arms)
+            costs[S] = 0;
+        costs[&D] += armCost;
+        changed = true;
+    }
+    return changed;
+}
+
+bool TickCoalescer::coalesceIntoLoopHeaders(llvm::LoopInfo &LI, const llvm::DominatorTree &DT, BlockCostMapType &costs) {
+    // A block of the loop body (not of a subloop) which dominates every
+    // place an iteration can end in is executed exactly once per execution
+    // of the loop header.
+    bool changed = false;
+    for(llvm::Loop *L : LI.getLoopsInPreorder()) {
+        llvm::BasicBlock *header = L->getHeader();
+
+        // Blocks that end an iteration: latches, exiting blocks and blocks
+        // leaving the function from inside the loop
+        llvm::SmallVector<llvm::BasicBlock*, 8> iterationEnds;
+        for(llvm::BasicBlock *BB : L->blocks()) {
+            if(llvm::succ_empty(BB) || L->isLoopExiting(BB) || L->isLoopLatch(BB))
+                iterationEnds.push_back(BB);
+        }
+
+        for(llvm::BasicBlock *BB : L->blocks()) {
+            if(BB == header || LI.getLoopFor(BB) != L)
+                continue;
+
+            auto it = costs.find(BB);
+            if(it == costs.end() || it->second == 0)
+                continue;
+
+            bool onEveryIteration = true;
+            for(llvm::BasicBlock *end : iterationEnds) {
+                if(!DT.dominates(BB, end)) {
+                    onEveryIteration = false;
+                    break;
+                }
+            }
+            if(!onEveryIteration)
+                continue;
+
+            CostTy cost = it->second;
+            it->second = 0;
+            costs[header] += cost;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+} // end namespace gpscat
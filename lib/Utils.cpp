@@ -2,7 +2,11 @@
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ADT/SmallVector.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Program.h>
 
+#include <algorithm>
+#include <map>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <system_error>
@@ -30,4 +34,26 @@ std::vector<std::string> split(const std::string &str) {
                                     std::istream_iterator<std::string>());
 }
 
+llvm::ErrorOr<std::string> findProgram(const std::string &name) {
+    static std::mutex mutex;
+    static std::map<std::string, std::string> paths;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = paths.find(name);
+    if(it != paths.end())
+        return it->second;
+
+    // Failures are not remembered, the program may be installed later
+    llvm::ErrorOr<std::string> path = llvm::sys::findProgramByName(name);
+    if(path)
+        paths[name] = path.get();
+    return path;
+}
+
+std::string getBoundVariableName(const llvm::Argument &arg) {
+    std::string name = arg.hasName() ? arg.getName().str() : "arg" + std::to_string(arg.getArgNo());
+    std::replace(name.begin(), name.end(), '.', '_');
+    return "V_" + name;
+}
+
 } // end namespace gpscat
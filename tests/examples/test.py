@@ -18,7 +18,7 @@ for bcFilename in bcFilenames:
                                     bcFilename,
                                     *optArg], stdout=subprocess.PIPE, stderr=subprocess.PIPE)
         costAnalyzer = subprocess.Popen(['gpscat-cost',
-                                         'costModel.csv',
+                                         'builtin:wasm32',
                                          '-arch=wasm32',
                                          '-replace-nat',
                                          #'-eager-inline',
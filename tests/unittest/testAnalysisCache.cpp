@@ -0,0 +1,165 @@
+#include "catch.hpp"
+
+#include <gpscat/AnalysisCache.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <utime.h>
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+using gpscat::AnalysisCache;
+
+static std::string createCacheDirectory() {
+    std::string path = gpscat::getTemporaryFilePath("gpscat-test", "cache");
+    llvm::sys::fs::remove(path);
+    return path;
+}
+
+TEST_CASE("AnalysisCache: store and lookup", "[analysisCache]") {
+    std::string directory = createCacheDirectory();
+    AnalysisCache cache(directory, 1);
+
+    std::string value;
+    REQUIRE_FALSE(cache.lookup("missing", value));
+
+    cache.store("bound", "nat(V_n)*3");
+    REQUIRE(cache.lookup("bound", value));
+    REQUIRE(value == "nat(V_n)*3");
+
+    cache.store("bound", "2");
+    REQUIRE(cache.lookup("bound", value));
+    REQUIRE(value == "2");
+
+    std::vector<gpscat::CostTy> blockCosts;
+    cache.storeBlockCosts("costs", {3, 0, -1, 12});
+    REQUIRE(cache.lookupBlockCosts("costs", blockCosts));
+    REQUIRE(blockCosts == std::vector<gpscat::CostTy>{3, 0, -1, 12});
+
+    llvm::sys::fs::remove_directories(directory);
+}
+
+TEST_CASE("AnalysisCache: eviction", "[analysisCache]") {
+    std::string directory = createCacheDirectory();
+    AnalysisCache cache(directory, 1);
+
+    // Two entries of 600 KB do not fit in 1 MB; the older one goes
+    cache.store("old", std::string(600 * 1024, 'a'));
+    cache.store("new", std::string(600 * 1024, 'b'));
+
+    // Last used an hour ago
+    struct utimbuf times = {std::time(nullptr) - 3600, std::time(nullptr) - 3600};
+    ::utime((directory + "/old").c_str(), &times);
+    cache.evict();
+
+    std::string value;
+    REQUIRE(cache.lookup("new", value));
+    REQUIRE_FALSE(cache.lookup("old", value));
+
+    llvm::sys::fs::remove_directories(directory);
+}
+
+TEST_CASE("AnalysisCache: in memory", "[analysisCache]") {
+    AnalysisCache cache;
+
+    std::string value;
+    cache.store("kept", "1");
+    cache.store("unused", "2");
+    cache.evict();
+    REQUIRE(cache.lookup("kept", value));
+    REQUIRE(value == "1");
+
+    // Only what was used since the last eviction stays
+    cache.evict();
+    REQUIRE(cache.lookup("kept", value));
+    REQUIRE_FALSE(cache.lookup("unused", value));
+}
+
+TEST_CASE("AnalysisCache: function hashes", "[analysisCache]") {
+    auto parse = [](llvm::LLVMContext &context, const std::string &source) {
+        llvm::SMDiagnostic err;
+        return llvm::parseAssemblyString(source, err, context);
+    };
+
+    llvm::LLVMContext context;
+    auto M1 = parse(context,
+        "define i32 @g(i32 %n) {\nentry:\n  %a = add i32 %n, 1\n  ret i32 %a\n}\n"
+        "define i32 @f(i32 %n) {\nentry:\n  %r = call i32 @g(i32 %n)\n  ret i32 %r\n}\n");
+    // Same as M1 except for the names of local values
+    auto M2 = parse(context,
+        "define i32 @g(i32 %n) {\nstart:\n  %sum = add i32 %n, 1\n  ret i32 %sum\n}\n"
+        "define i32 @f(i32 %n) {\nstart:\n  %x = call i32 @g(i32 %n)\n  ret i32 %x\n}\n");
+    // The callee adds 2 instead of 1
+    auto M3 = parse(context,
+        "define i32 @g(i32 %n) {\nentry:\n  %a = add i32 %n, 2\n  ret i32 %a\n}\n"
+        "define i32 @f(i32 %n) {\nentry:\n  %r = call i32 @g(i32 %n)\n  ret i32 %r\n}\n");
+    REQUIRE(M1);
+    REQUIRE(M2);
+    REQUIRE(M3);
+
+    auto functionHash = [](std::unique_ptr<llvm::Module> &M, const char *name) {
+        return AnalysisCache::getFunctionHash(*M->getFunction(name));
+    };
+    auto closureHash = [](std::unique_ptr<llvm::Module> &M, const char *name) {
+        return AnalysisCache::getCalleeClosureHash(*M->getFunction(name));
+    };
+
+    REQUIRE(functionHash(M1, "f") == functionHash(M2, "f"));
+    REQUIRE(closureHash(M1, "f") == closureHash(M2, "f"));
+
+    REQUIRE(functionHash(M1, "f") == functionHash(M3, "f"));
+    REQUIRE(functionHash(M1, "g") != functionHash(M3, "g"));
+    REQUIRE(closureHash(M1, "f") != closureHash(M3, "f"));
+}
+
+TEST_CASE("AnalysisCache: function hashes see what changes the code", "[analysisCache]") {
+    llvm::LLVMContext context;
+    auto functionHash = [&context](const std::string &source) {
+        llvm::SMDiagnostic err;
+        std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(source, err, context);
+        REQUIRE(M);
+        return AnalysisCache::getFunctionHash(*M->getFunction("f"));
+    };
+    auto phi = [](const std::string &incoming) {
+        return "define i32 @f(i1 %c) {\nentry:\n  br i1 %c, label %a, label %b\n"
+               "a:\n  br label %join\nb:\n  br label %join\n"
+               "join:\n  %r = phi i32 " + incoming + "\n  ret i32 %r\n}\n";
+    };
+
+    // The same incoming values from swapped predecessors
+    REQUIRE(functionHash(phi("[ 0, %a ], [ 1, %b ]")) != functionHash(phi("[ 1, %a ], [ 0, %b ]")));
+    REQUIRE(functionHash(phi("[ 0, %a ], [ 1, %b ]")) == functionHash(phi("[ 0, %a ], [ 1, %b ]")));
+
+    auto add = [](const std::string &flags) {
+        return "define i32 @f(i32 %n) {\n  %a = add " + flags + " i32 %n, 1\n  ret i32 %a\n}\n";
+    };
+    REQUIRE(functionHash(add("")) != functionHash(add("nsw")));
+    REQUIRE(functionHash(add("nsw")) != functionHash(add("nuw")));
+
+    auto load = [](const std::string &flags, const std::string &alignment) {
+        return "define i32 @f(i32* %p) {\n  %v = load " + flags + " i32, i32* %p, align " + alignment + "\n  ret i32 %v\n}\n";
+    };
+    REQUIRE(functionHash(load("", "4")) != functionHash(load("volatile", "4")));
+    REQUIRE(functionHash(load("", "4")) != functionHash(load("", "1")));
+
+    auto attributes = [](const std::string &attributes) {
+        return "define i32 @f(i32 %n) " + attributes + " {\n  ret i32 %n\n}\n";
+    };
+    REQUIRE(functionHash(attributes("")) != functionHash(attributes("noinline optnone")));
+
+    auto global = [](const std::string &initializer) {
+        return "@t = internal constant [2 x i32] " + initializer + "\n"
+               "define i32 @f(i64 %i) {\n"
+               "  %p = getelementptr [2 x i32], [2 x i32]* @t, i64 0, i64 %i\n"
+               "  %v = load i32, i32* %p\n  ret i32 %v\n}\n";
+    };
+    REQUIRE(functionHash(global("[i32 1, i32 2]")) != functionHash(global("[i32 1, i32 3]")));
+}
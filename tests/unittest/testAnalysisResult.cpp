@@ -0,0 +1,78 @@
+#include "catch.hpp"
+
+#include <gpscat/AnalysisResult.h>
+#include <gpscat/Deadline.h>
+
+#include <limits>
+#include <string>
+
+using gpscat::AnalysisResult;
+
+TEST_CASE("AnalysisResult: JSON", "[analysisResult]") {
+    AnalysisResult result;
+    result.status = AnalysisResult::Status::Partial;
+    result.stage = "solve";
+    result.message = "deadline \"expired\"";
+    result.functionCosts = {{"f", {1, 0, 270}, "", {}, {}}, {"g", {}, "", {}, {}}};
+
+    REQUIRE(result.toJSON() == "{\"status\":\"partial\",\"stage\":\"solve\",\"message\":\"deadline \\\"expired\\\"\","
+                               "\"functions\":[{\"name\":\"f\",\"blockCosts\":[1,0,270]},{\"name\":\"g\",\"blockCosts\":[]}],"
+                               "\"bound\":null}");
+
+    result.status = AnalysisResult::Status::Complete;
+    result.message.clear();
+    result.functionCosts.clear();
+    result.bound = "nat(V_arg0)*3";
+    REQUIRE(result.toJSON() == "{\"status\":\"complete\",\"stage\":\"solve\",\"functions\":[],\"bound\":\"nat(V_arg0)*3\"}");
+
+    result.functionCosts = {{"f", {2}, "nat(V_n)", {}, {}}};
+    result.bound.clear();
+    REQUIRE(result.toJSON() == "{\"status\":\"complete\",\"stage\":\"solve\","
+                               "\"functions\":[{\"name\":\"f\",\"blockCosts\":[2],\"bound\":\"nat(V_n)\"}],\"bound\":null}");
+
+    result.functionCosts = {{"f", {3}, "", {1, 2, 0}, {}}};
+    REQUIRE(result.toJSON() == "{\"status\":\"complete\",\"stage\":\"solve\","
+                               "\"functions\":[{\"name\":\"f\",\"blockCosts\":[3],\"instructionCosts\":[1,2,0]}],\"bound\":null}");
+
+    result.functionCosts.clear();
+    result.bound = "V_n";
+    result.score = 2.5;
+    REQUIRE(result.toJSON() == "{\"status\":\"complete\",\"stage\":\"solve\",\"functions\":[],\"bound\":\"V_n\",\"score\":2.5}");
+    result.score = std::numeric_limits<double>::infinity();
+    REQUIRE(result.toJSON() == "{\"status\":\"complete\",\"stage\":\"solve\",\"functions\":[],\"bound\":\"V_n\",\"score\":null}");
+
+    result.score.reset();
+    result.resourceBounds = {{"Cost", "V_n"}, {"energy", ""}};
+    REQUIRE(result.toJSON() == "{\"status\":\"complete\",\"stage\":\"solve\",\"functions\":[],\"bound\":\"V_n\","
+                               "\"resourceBounds\":{\"Cost\":\"V_n\",\"energy\":null}}");
+}
+
+TEST_CASE("AnalysisResult: collapsed stacks", "[analysisResult]") {
+    AnalysisResult result;
+    result.sourceFiles = {"a.c", "b.h"};
+    result.functionCosts = {{"f", {}, "", {2, 3, 4, 0, 5, 1}, {{0, 12}, {1, 3}, {0, 12}, {0, 13}, {0, 0}, {1, 3}}},
+                            {"g", {}, "", {7, 1}, {}},
+                            {"h", {}, "", {}, {}}};
+
+    // Sorted by file and line, zero costs left out
+    REQUIRE(result.toCollapsedStacks() == "f 5\n"
+                                          "f;a.c:12 6\n"
+                                          "f;b.h:3 4\n"
+                                          "g 8\n");
+
+    result.functionCosts.clear();
+    REQUIRE(result.toCollapsedStacks().empty());
+}
+
+TEST_CASE("AnalysisResult: deadline", "[analysisResult]") {
+    gpscat::Deadline none;
+    REQUIRE(!none.expired());
+    REQUIRE(none.clamp(60) == 60);
+    REQUIRE(none.clamp(0) == 0);
+
+    gpscat::Deadline soon = gpscat::Deadline::after(5);
+    REQUIRE(!soon.expired());
+    REQUIRE(soon.clamp(60) == 5);
+    REQUIRE(soon.clamp(2) == 2);
+    REQUIRE(soon.clamp(0) == 5);
+}
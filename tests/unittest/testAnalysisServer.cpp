@@ -0,0 +1,148 @@
+#include "catch.hpp"
+
+#include <gpscat/AnalysisServer.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/Support/FileSystem.h>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using gpscat::AnalysisServer;
+
+static std::string sendRequest(const std::string &socketPath, const std::string &request) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    if(connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return std::string();
+    }
+
+    send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+    std::string response;
+    char buffer[256];
+    ssize_t received;
+    while((received = recv(fd, buffer, sizeof(buffer), 0)) > 0)
+        response.append(buffer, received);
+    close(fd);
+    return response;
+}
+
+TEST_CASE("AnalysisServer: requests", "[analysisServer]") {
+    gpscat::Analyzer::Options options;
+    options.deadlineSeconds = 10;
+    AnalysisServer server("cost.csv", options, 1);
+
+    auto request = server.parseRequest("size=12");
+    REQUIRE(request.size == 12);
+    REQUIRE(request.costModelPath == "cost.csv");
+    REQUIRE(request.options.arch == "wasm32");
+    REQUIRE(request.options.deadlineSeconds == 10);
+    REQUIRE(!request.score);
+
+    request = server.parseRequest("cost-model=x86.csv arch=x86-64 O=0 mcpu=skylake schedule-blocks function=main inline=3 eager-inline compositional=0 deadline=2 score "
+                                  "range.V_n=1:100 range.V_m=-5:5.5 size=7");
+    REQUIRE(request.costModelPath == "x86.csv");
+    REQUIRE(request.options.arch == "x86-64");
+    REQUIRE(request.options.optLevel == "0");
+    REQUIRE(request.options.cpu == "skylake");
+    REQUIRE(request.options.scheduleBlocks);
+    REQUIRE(request.options.configuration.functionName == "main");
+    REQUIRE(request.options.configuration.numInlines == 3);
+    REQUIRE(request.options.configuration.eagerInline);
+    REQUIRE(!request.options.compositional);
+    REQUIRE(request.options.deadlineSeconds == 2);
+    REQUIRE(request.score);
+    REQUIRE(request.ranges.at("V_n") == std::make_pair(1.0, 100.0));
+    REQUIRE(request.ranges.at("V_m") == std::make_pair(-5.0, 5.5));
+    REQUIRE(request.size == 7);
+
+    REQUIRE_THROWS_AS(server.parseRequest("arch=x86-64"), std::invalid_argument);
+    REQUIRE_THROWS_AS(server.parseRequest("size=-1"), std::invalid_argument);
+    REQUIRE_THROWS_AS(server.parseRequest("size=1 color=red"), std::invalid_argument);
+    REQUIRE_THROWS_AS(server.parseRequest("size=1 score=maybe"), std::invalid_argument);
+    REQUIRE_THROWS_AS(server.parseRequest("size=1 range.V_n=5:1"), std::invalid_argument);
+    REQUIRE_THROWS_AS(server.parseRequest("size=1 range.V_n=1-5"), std::invalid_argument);
+}
+
+TEST_CASE("AnalysisServer: answers over the socket", "[analysisServer]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd,1\n";
+    std::string socketPath = gpscat::getTemporaryFilePath("gpscat-test", "sock");
+    llvm::sys::fs::remove(socketPath);
+
+    AnalysisServer server(costModelPath, gpscat::Analyzer::Options(), 2);
+    REQUIRE(server.listen(socketPath));
+    std::thread serverThread([&server]() {
+        server.serve();
+    });
+
+    struct stat status;
+    REQUIRE(stat(socketPath.c_str(), &status) == 0);
+    REQUIRE((status.st_mode & 0777) == 0600);
+
+    std::string response = sendRequest(socketPath, "size=10\nnot really");
+    REQUIRE(response.find("\"status\":\"failed\",\"stage\":\"parse\"") == 1);
+    REQUIRE(response.back() == '\n');
+
+    response = sendRequest(socketPath, "size=10 color=red\n");
+    REQUIRE(response.find("\"stage\":\"request\",\"message\":\"Unknown option: color\"") != std::string::npos);
+
+    // Only one server per socket
+    AnalysisServer other(costModelPath, gpscat::Analyzer::Options(), 1);
+    REQUIRE(!other.listen(socketPath));
+
+    server.stop();
+    serverThread.join();
+
+    llvm::sys::fs::remove(costModelPath);
+}
+
+TEST_CASE("AnalysisServer: analyzes inputs", "[analysisServer]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\ni32.add,1\n";
+    std::string socketPath = gpscat::getTemporaryFilePath("gpscat-test", "sock");
+    llvm::sys::fs::remove(socketPath);
+
+    // A solver worker which finds the same bound for everything
+    std::string solver = gpscat::getTemporaryFilePath("gpscat-test", "solver.sh");
+    std::ofstream(solver) << "#!/bin/sh\nwhile read -r line; do echo \"ok 42\"; done\n";
+    llvm::sys::fs::setPermissions(solver, llvm::sys::fs::owner_all);
+    gpscat::Analyzer::Options options;
+    options.configuration.solverWorker = solver;
+
+    AnalysisServer server(costModelPath, options, 1);
+    REQUIRE(server.listen(socketPath));
+    std::thread serverThread([&server]() {
+        server.serve();
+    });
+
+    std::string input = "define i32 @f(i32 %x) {\n  %y = add i32 %x, 1\n  ret i32 %y\n}\n";
+    std::string header = "size=" + std::to_string(input.size()) + "\n";
+    std::string response = sendRequest(socketPath, header + input);
+    REQUIRE(response.find("\"status\":\"complete\"") != std::string::npos);
+    REQUIRE(response.find("\"bound\":\"42\"") != std::string::npos);
+    REQUIRE(response.find("\"blockCosts\":[1]") != std::string::npos);
+
+    // A changed cost model is read again
+    std::ofstream(costModelPath) << "Opcode,Cost\ni32.add,5\n";
+    response = sendRequest(socketPath, header + input);
+    REQUIRE(response.find("\"blockCosts\":[5]") != std::string::npos);
+
+    server.stop();
+    serverThread.join();
+
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove(solver);
+}
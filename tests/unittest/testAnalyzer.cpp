@@ -0,0 +1,249 @@
+#include "catch.hpp"
+
+#include <gpscat/Analyzer.h>
+#include <gpscat/AnalysisCache.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <signal.h>
+
+using gpscat::Analyzer;
+using gpscat::AnalysisCache;
+
+TEST_CASE("Analyzer: cost model", "[analyzer]") {
+    REQUIRE_THROWS_AS(Analyzer("/nonexistent/cost.csv", Analyzer::Options()), std::runtime_error);
+}
+
+TEST_CASE("Analyzer: cached block costs", "[analyzer]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd,1\n";
+    std::string directory = gpscat::getTemporaryFilePath("gpscat-test", "cache");
+    llvm::sys::fs::remove(directory);
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(R"(
+        define internal i32 @f(i32 %n) {
+        entry:
+          %c = icmp sgt i32 %n, 0
+          br i1 %c, label %then, label %exit
+        then:
+          br label %exit
+        exit:
+          ret i32 %n
+        }
+    )", err, context);
+    REQUIRE(M);
+
+    // Neither llc nor a solver runs: the block costs are cached and there
+    // is no externally visible function to solve
+    Analyzer::Options options;
+    options.cacheDir = directory;
+    options.allFunctions = true;
+    Analyzer analyzer(costModelPath, options);
+    AnalysisCache cache(directory, 1);
+    cache.storeBlockCosts(analyzer.getBlockCostKey(*M->getFunction("f")), {3, 1, 2});
+
+    gpscat::AnalysisResult result = analyzer.analyze(M.get());
+
+    REQUIRE(result.status == gpscat::AnalysisResult::Status::Complete);
+    REQUIRE(result.functionCosts.size() == 1);
+    REQUIRE(result.functionCosts[0].name == "f");
+    REQUIRE(result.functionCosts[0].blockCosts == std::vector<gpscat::CostTy>{3, 1, 2});
+    REQUIRE(result.functionCosts[0].instructionCosts.empty());
+
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove_directories(directory);
+}
+
+TEST_CASE("Analyzer: cached block costs of several resources", "[analyzer]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost,energy\nadd,1,7\n";
+    std::string directory = gpscat::getTemporaryFilePath("gpscat-test", "cache");
+    llvm::sys::fs::remove(directory);
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(R"(
+        define internal void @f() {
+        entry:
+          ret void
+        }
+    )", err, context);
+    REQUIRE(M);
+
+    // A solver worker which finds the same bound for everything
+    std::string solver = gpscat::getTemporaryFilePath("gpscat-test", "solver.sh");
+    std::ofstream(solver) << "#!/bin/sh\nwhile read -r line; do echo \"ok 42\"; done\n";
+    llvm::sys::fs::setPermissions(solver, llvm::sys::fs::owner_all);
+
+    // Without the block costs of energy llc would have to run
+    Analyzer::Options options;
+    options.cacheDir = directory;
+    options.configuration.solverWorker = solver;
+    Analyzer analyzer(costModelPath, options);
+    AnalysisCache cache(directory, 1);
+    cache.storeBlockCosts(analyzer.getBlockCostKey(*M->getFunction("f")), {2});
+    cache.storeBlockCosts(analyzer.getBlockCostKey(*M->getFunction("f"), 1), {14});
+
+    gpscat::AnalysisResult result = analyzer.analyze(M.get());
+
+    REQUIRE(result.status == gpscat::AnalysisResult::Status::Complete);
+    REQUIRE(analyzer.getNumCompiled() == 0);
+    REQUIRE(result.functionCosts.size() == 1);
+    REQUIRE(result.functionCosts[0].blockCosts == std::vector<gpscat::CostTy>{2});
+    REQUIRE(result.resourceBounds.size() == 2);
+
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove(solver);
+    llvm::sys::fs::remove_directories(directory);
+}
+
+TEST_CASE("Analyzer: solver workers end with the analyzer", "[analyzer]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd,1\n";
+
+    // Every worker appends its process id
+    std::string pids = gpscat::getTemporaryFilePath("gpscat-test", "pids");
+    std::string solver = gpscat::getTemporaryFilePath("gpscat-test", "solver.sh");
+    std::ofstream(solver) << "#!/bin/sh\necho $$ >> " << pids << "\nwhile read -r line; do echo \"ok 42\"; done\n";
+    llvm::sys::fs::setPermissions(solver, llvm::sys::fs::owner_all);
+
+    Analyzer::Options options;
+    options.configuration.functionName = "f";
+    options.configuration.solverWorker = solver;
+    options = Analyzer::withSolverPool(options);
+
+    // A fresh module and cache each time, so that every analysis solves
+    // without compiling
+    llvm::LLVMContext context;
+    auto analyze = [&](Analyzer &analyzer) {
+        llvm::SMDiagnostic err;
+        std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString("define void @f() {\n  ret void\n}\n", err, context);
+        AnalysisCache cache;
+        cache.storeBlockCosts(analyzer.getBlockCostKey(*M->getFunction("f")), {1});
+        return analyzer.analyze(M.get(), cache, gpscat::Deadline()).status;
+    };
+    std::vector<pid_t> workers;
+    auto readPids = [&]() {
+        workers.clear();
+        std::ifstream file(pids);
+        for(pid_t pid; file >> pid;)
+            workers.push_back(pid);
+    };
+
+    {
+        // Analyzers given the same pool share its workers
+        Analyzer first(costModelPath, options), second(costModelPath, options);
+        REQUIRE(analyze(first) == gpscat::AnalysisResult::Status::Complete);
+        REQUIRE(analyze(second) == gpscat::AnalysisResult::Status::Complete);
+        readPids();
+        REQUIRE(workers.size() == 1);
+        REQUIRE(kill(workers[0], 0) == 0);
+    }
+    // Stopped with the last user of the pool
+    REQUIRE(kill(workers[0], 0) == 0);
+    options.solverPool.reset();
+    REQUIRE(kill(workers[0], 0) == -1);
+
+    {
+        Analyzer analyzer(costModelPath, options);
+        REQUIRE(analyze(analyzer) == gpscat::AnalysisResult::Status::Complete);
+        readPids();
+        REQUIRE(workers.size() == 2);
+        REQUIRE(kill(workers[1], 0) == 0);
+    }
+    REQUIRE(kill(workers[1], 0) == -1);
+
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove(solver);
+    llvm::sys::fs::remove(pids);
+}
+
+TEST_CASE("Analyzer: options -all-functions does not support", "[analyzer]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost,energy\nadd,1,7\n";
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString("define void @f() {\n  ret void\n}\n", err, context);
+    REQUIRE(M);
+
+    // Rejected before anything runs, instead of solving without them
+    Analyzer::Options options;
+    options.allFunctions = true;
+    gpscat::AnalysisResult result = Analyzer(costModelPath, options).analyze(M.get());
+    REQUIRE(result.status == gpscat::AnalysisResult::Status::Failed);
+    REQUIRE(result.stage == "options");
+
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd,1\n";
+    options.compositional = true;
+    result = Analyzer(costModelPath, options).analyze(M.get());
+    REQUIRE(result.stage == "options");
+    REQUIRE(result.functionCosts.empty());
+
+    llvm::sys::fs::remove(costModelPath);
+}
+
+TEST_CASE("Analyzer: only functions missing from the cache are compiled", "[analyzer]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\ni32.add,1\ni32.mul,4\n";
+    std::string directory = gpscat::getTemporaryFilePath("gpscat-test", "cache");
+    llvm::sys::fs::remove(directory);
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(R"(
+        define internal i32 @f(i32 %x) {
+          %y = mul i32 %x, 3
+          ret i32 %y
+        }
+        define internal i32 @g(i32 %x) {
+          %y = add i32 %x, 3
+          ret i32 %y
+        }
+    )", err, context);
+    REQUIRE(M);
+
+    Analyzer::Options options;
+    options.cacheDir = directory;
+    options.allFunctions = true;
+    Analyzer analyzer(costModelPath, options);
+    AnalysisCache cache(directory, 1);
+    // Not what llc makes of f, so it shows that f was not compiled again
+    cache.storeBlockCosts(analyzer.getBlockCostKey(*M->getFunction("f")), {9});
+    // The analysis adds tick calls to g
+    std::string key = analyzer.getBlockCostKey(*M->getFunction("g"));
+
+    gpscat::AnalysisResult result = analyzer.analyze(M.get());
+
+    REQUIRE(result.status == gpscat::AnalysisResult::Status::Complete);
+    REQUIRE(result.functionCosts.size() == 2);
+    REQUIRE(result.functionCosts[0].blockCosts == std::vector<gpscat::CostTy>{9});
+    REQUIRE(result.functionCosts[0].instructionCosts.empty());
+    REQUIRE(result.functionCosts[1].blockCosts == std::vector<gpscat::CostTy>{1});
+    REQUIRE(!result.functionCosts[1].instructionCosts.empty());
+
+    std::vector<gpscat::CostTy> blockCosts;
+    REQUIRE(cache.lookupBlockCosts(key, blockCosts));
+    REQUIRE(blockCosts == std::vector<gpscat::CostTy>{1});
+
+    // llc compiles for the triple and data layout of the module
+    key = analyzer.getBlockCostKey(*M->getFunction("f"));
+    M->setTargetTriple("wasm64-unknown-unknown");
+    REQUIRE(analyzer.getBlockCostKey(*M->getFunction("f")) != key);
+
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove_directories(directory);
+}
@@ -0,0 +1,119 @@
+#include "catch.hpp"
+
+#include <gpscat/AssemblyCostModel.h>
+#include <gpscat/BuiltinCostModel.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/Support/FileSystem.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using gpscat::AssemblyCostModel;
+using gpscat::BuiltinCostEntry;
+
+namespace {
+
+constexpr BuiltinCostEntry entries[] = {{"add", 1}, {"sub", 1}, {"mul", 3}, {"div", 20}, {"br", 2}};
+constexpr gpscat::PerfectHashTable<5> table(entries);
+constexpr gpscat::BuiltinCostModel model = table.getModel("test");
+
+// The table is built and usable at compile time
+static_assert(model.find("div") == 3, "");
+static_assert(model.find("rem") == 5, "");
+
+} // end anonymous namespace
+
+TEST_CASE("BuiltinCostModel: perfect hash", "[assemblyCostModel]") {
+    for(std::size_t i = 0; i < 5; ++i)
+        REQUIRE(model.find(entries[i].opcode) == i);
+    REQUIRE(model.find("") == 5);
+    REQUIRE(model.find("adds") == 5);
+
+    REQUIRE(gpscat::findBuiltinCostModel("wasm32"));
+    REQUIRE_FALSE(gpscat::findBuiltinCostModel("z80"));
+}
+
+TEST_CASE("AssemblyCostModel: built-in models", "[assemblyCostModel]") {
+    AssemblyCostModel costModel("builtin:wasm32");
+    REQUIRE(costModel.getNumOpcodes() > 0);
+    REQUIRE(costModel.getOpcodeName(0) == "local.get");
+    REQUIRE(costModel.getOpcodeID("local.get") == 0);
+    REQUIRE(costModel.get("local.get") == 135);
+    REQUIRE(costModel.getOpcodeID("local.gets") == AssemblyCostModel::InvalidOpcode);
+
+    // Every opcode is found under its own ID
+    for(gpscat::OpcodeID opcode = 0; opcode < costModel.getNumOpcodes(); ++opcode)
+        REQUIRE(costModel.getOpcodeID(costModel.getOpcodeName(opcode)) == opcode);
+
+    // Changing a built-in model keeps its IDs
+    gpscat::OpcodeID unreachable = costModel.getOpcodeID("unreachable");
+    costModel.set("nop", 0);
+    REQUIRE(costModel.getOpcodeID("unreachable") == unreachable);
+    REQUIRE(costModel.get("nop") == 0);
+
+    REQUIRE(AssemblyCostModel::isBuiltin("builtin:wasm32"));
+    REQUIRE_FALSE(AssemblyCostModel::isBuiltin("wasm32.csv"));
+    REQUIRE_THROWS_AS(AssemblyCostModel("builtin:z80"), std::runtime_error);
+}
+
+TEST_CASE("AssemblyCostModel: CSV files", "[assemblyCostModel]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+
+    // Any column order, quotes, spaces, Windows line ends and blank lines
+    std::ofstream(costModelPath) << "Cost,\"Opcode\"\r\n 1 , add \r\n\r\n\"7\",\"mul\"\r\n";
+    AssemblyCostModel costModel(costModelPath);
+    REQUIRE(costModel.getNumOpcodes() == 2);
+    REQUIRE(costModel.getNumResources() == 1);
+    REQUIRE(costModel.get("add") == 1);
+    REQUIRE(costModel.get("mul") == 7);
+    REQUIRE(costModel.toCSV() == "Opcode,Cost\nadd,1\nmul,7\n");
+
+    std::ofstream(costModelPath) << "Opcode,Cost\n";
+    REQUIRE(AssemblyCostModel(costModelPath).getNumOpcodes() == 0);
+    std::ofstream(costModelPath) << "";
+    REQUIRE_THROWS_AS(AssemblyCostModel(costModelPath), std::runtime_error);
+
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd,one\n";
+    REQUIRE_THROWS_AS(AssemblyCostModel(costModelPath), std::runtime_error);
+    std::ofstream(costModelPath) << "Name,Cost\nadd,1\n";
+    REQUIRE_THROWS_AS(AssemblyCostModel(costModelPath), std::runtime_error);
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd\n";
+    REQUIRE_THROWS_AS(AssemblyCostModel(costModelPath), std::runtime_error);
+    REQUIRE_THROWS_AS(AssemblyCostModel("/nonexistent/cost.csv"), std::runtime_error);
+
+    llvm::sys::fs::remove(costModelPath);
+}
+
+TEST_CASE("AssemblyCostModel: resources", "[assemblyCostModel]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+
+    // Cost comes first, wherever its column is
+    std::ofstream(costModelPath) << "Opcode,energy,Cost,gas\nadd,5,1,3\nmul,9,4,3\n";
+    AssemblyCostModel costModel(costModelPath);
+    REQUIRE(costModel.getNumResources() == 3);
+    REQUIRE(costModel.getResourceName(0) == "Cost");
+    REQUIRE(costModel.getResourceName(1) == "energy");
+    REQUIRE(costModel.getResourceName(2) == "gas");
+    REQUIRE(costModel.get("mul") == 4);
+    REQUIRE(costModel.get("mul", 1) == 9);
+    REQUIRE(costModel.getCost(costModel.getOpcodeID("add"), 2) == 3);
+
+    // New opcodes cost nothing in the other resources
+    costModel.set("div", 20);
+    REQUIRE(costModel.get("div") == 20);
+    REQUIRE(costModel.get("div", 1) == 0);
+    REQUIRE(costModel.toCSV() == "Opcode,Cost,energy,gas\nadd,1,5,3\nmul,4,9,3\ndiv,20,0,0\n");
+
+    // Without a Cost column the first column is the first resource
+    std::ofstream(costModelPath) << "Opcode,time\nadd,2\n";
+    REQUIRE(AssemblyCostModel(costModelPath).getResourceName(0) == "time");
+
+    std::ofstream(costModelPath) << "Opcode,Cost,energy\nadd,1,high\n";
+    REQUIRE_THROWS_AS(AssemblyCostModel(costModelPath), std::runtime_error);
+    std::ofstream(costModelPath) << "Opcode,a,b,c,d,e,f,g,h,i\n";
+    REQUIRE_THROWS_AS(AssemblyCostModel(costModelPath), std::runtime_error);
+
+    llvm::sys::fs::remove(costModelPath);
+}
@@ -0,0 +1,118 @@
+#include "catch.hpp"
+
+#include <gpscat/BatchAnalyzer.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/Support/FileSystem.h>
+
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+using gpscat::BatchAnalyzer;
+using strings = std::vector<std::string>;
+
+static std::string createFile(const std::string &suffix, const std::string &content) {
+    std::string path = gpscat::getTemporaryFilePath("gpscat-test", suffix);
+    std::ofstream file(path);
+    file << content;
+    return path;
+}
+
+TEST_CASE("BatchAnalyzer: manifest and journal", "[batchAnalyzer]") {
+    std::string manifest = createFile("manifest", "# corpus\na.bc\n\n  b.bc \n");
+    REQUIRE(BatchAnalyzer::readManifest(manifest) == strings{"a.bc", "b.bc"});
+
+    // The last line was cut short by a killed run
+    std::string journal = createFile("journal", "a.bc\t{\"status\":\"complete\"}\nb.bc\t{\"status\":\"comp");
+    REQUIRE(BatchAnalyzer::readJournal(journal) == std::set<std::string>{"a.bc"});
+
+    // Cut short right after an inner object, or with braces in a string
+    std::string truncated = createFile("journal",
+        "a.bc\t{\"status\":\"complete\",\"functions\":[{\"name\":\"f\"}\n"
+        "b.bc\t{\"status\":\"complete\",\"message\":\"}\\\"}\"}\n"
+        "c.bc\t{\"status\":\"complete\",\"message\":\"{\"}\n");
+    REQUIRE(BatchAnalyzer::readJournal(truncated) == std::set<std::string>{"b.bc", "c.bc"});
+
+    // Results which are not complete are analyzed again
+    std::string incomplete = createFile("journal",
+        "a.bc\t{\"status\":\"partial\",\"stage\":\"solve\"}\n"
+        "b.bc\t{\"status\":\"failed\",\"stage\":\"parse\"}\n"
+        "b.bc\t{\"status\":\"complete\"}\n");
+    REQUIRE(BatchAnalyzer::readJournal(incomplete) == std::set<std::string>{"b.bc"});
+
+    llvm::sys::fs::remove(manifest);
+    llvm::sys::fs::remove(journal);
+    llvm::sys::fs::remove(truncated);
+    llvm::sys::fs::remove(incomplete);
+}
+
+TEST_CASE("BatchAnalyzer: largest inputs first", "[batchAnalyzer]") {
+    std::string small = createFile("small.bc", "x");
+    std::string large = createFile("large.bc", std::string(100, 'x'));
+    std::string missing = small + ".missing";
+
+    REQUIRE(BatchAnalyzer::getSchedule({small, missing, large}) == strings{large, small, missing});
+
+    llvm::sys::fs::remove(small);
+    llvm::sys::fs::remove(large);
+}
+
+TEST_CASE("BatchAnalyzer: resumes from the journal", "[batchAnalyzer]") {
+    std::string costModelPath = createFile("cost.csv", "Opcode,Cost\nadd,1\n");
+    gpscat::AssemblyCostModel costModel(costModelPath);
+
+    // Missing inputs fail to parse
+    std::string journal = gpscat::getTemporaryFilePath("gpscat-test", "journal");
+    strings inputs = {journal + ".a.bc", journal + ".b.bc", journal + ".c.bc"};
+    std::ofstream(journal) << inputs[0] << "\t{\"status\":\"partial\",\"stage\":\"solve\",\"message\":\"deadline expired\"}\n"
+                           << inputs[1] << "\t{\"status\":\"complete\"}\n";
+
+    BatchAnalyzer batchAnalyzer(costModel, gpscat::Analyzer::Options(), 2);
+    std::set<std::string> analyzed;
+    batchAnalyzer.run(inputs, journal, [&analyzed](const std::string &input, const gpscat::AnalysisResult &result) {
+        analyzed.insert(input);
+        REQUIRE(result.stage == "parse");
+        REQUIRE(result.status == gpscat::AnalysisResult::Status::Failed);
+    });
+
+    // The partial one is retried, and the failures are retried next time
+    REQUIRE(analyzed == std::set<std::string>{inputs[0], inputs[2]});
+    REQUIRE(BatchAnalyzer::readJournal(journal) == std::set<std::string>{inputs[1]});
+
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove(journal);
+}
+
+TEST_CASE("BatchAnalyzer: analyzes inputs", "[batchAnalyzer]") {
+    std::string costModelPath = createFile("cost.csv", "Opcode,Cost\nadd,1\n");
+    gpscat::AssemblyCostModel costModel(costModelPath);
+
+    // A solver worker which finds the same bound for everything
+    std::string solver = createFile("solver.sh", "#!/bin/sh\nwhile read -r line; do echo \"ok 42\"; done\n");
+    llvm::sys::fs::setPermissions(solver, llvm::sys::fs::owner_all);
+    gpscat::Analyzer::Options options;
+    options.configuration.solverWorker = solver;
+
+    std::string input = createFile("f.ll", "define i32 @f(i32 %x) {\n  %y = add i32 %x, 1\n  ret i32 %y\n}\n");
+    std::string journal = input + ".journal";
+
+    BatchAnalyzer batchAnalyzer(costModel, options, 1);
+    std::set<std::string> analyzed;
+    batchAnalyzer.run({input}, journal, [&analyzed](const std::string &input, const gpscat::AnalysisResult &result) {
+        analyzed.insert(input);
+        REQUIRE(result.status == gpscat::AnalysisResult::Status::Complete);
+        REQUIRE(result.bound == "42");
+        REQUIRE(result.functionCosts.size() == 1);
+        REQUIRE(result.functionCosts[0].name == "f");
+    });
+
+    REQUIRE(analyzed == std::set<std::string>{input});
+    REQUIRE(BatchAnalyzer::readJournal(journal) == std::set<std::string>{input});
+
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove(solver);
+    llvm::sys::fs::remove(input);
+    llvm::sys::fs::remove(journal);
+}
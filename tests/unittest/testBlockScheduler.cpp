@@ -0,0 +1,55 @@
+#include "catch.hpp"
+
+#include <gpscat/BlockScheduler.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/Support/FileSystem.h>
+
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("BlockScheduler: cycles per instruction ID", "[blockScheduler]") {
+    std::string asmPath = gpscat::getTemporaryFilePath("gpscat-test", "map.s");
+    std::ofstream(asmPath) << "\t.text\n"
+                              "\t.file\t\"f.ll\"\n"
+                              "f:\n"
+                              "\t.file\t1 \"f.ll\"\n"
+                              // Independent additions run side by side
+                              "\t.loc\t1 1 0\n\taddl\t%esi, %edi\n"
+                              "\t.loc\t1 2 0\n\taddl\t%edx, %ecx\n"
+                              "\t.loc\t1 3 0\n\taddl\t%r8d, %r9d\n"
+                              "\t.loc\t1 4 0\n\taddl\t%r10d, %r11d\n"
+                              "\tjmp\t.LBB0_1\n"
+                              // Dependent multiplications do not
+                              ".LBB0_1:\n"
+                              "\t.loc\t1 5 0\n\timull\t%edi, %edi\n"
+                              "\t.loc\t1 6 0\n\timull\t%edi, %edi\n\timull\t%edi, %edi\n"
+                              "\t.loc\t1 7 0\n\timull\t%edi, %edi\n";
+
+    gpscat::BlockScheduler blockScheduler("x86-64", "skylake");
+    std::vector<gpscat::CostTy> costs = blockScheduler.schedule(asmPath);
+    REQUIRE(costs.size() == 8);
+    REQUIRE(costs[0] == 0);
+
+    // Four additions and a jump, against five cycles one after another
+    gpscat::CostTy additions = std::accumulate(costs.begin() + 1, costs.begin() + 5, 0);
+    REQUIRE(additions >= 1);
+    REQUIRE(additions < 5);
+
+    // Four multiplications of three cycles each
+    gpscat::CostTy multiplications = std::accumulate(costs.begin() + 5, costs.end(), 0);
+    REQUIRE(multiplications >= 12);
+    REQUIRE(multiplications <= 13);
+    REQUIRE(costs[6] > costs[5]);
+
+    REQUIRE(blockScheduler.schedule(asmPath + ".missing").empty());
+    llvm::sys::fs::remove(asmPath);
+}
+
+TEST_CASE("BlockScheduler: processors without scheduling model", "[blockScheduler]") {
+    REQUIRE_THROWS_AS(gpscat::BlockScheduler("wasm32", ""), std::runtime_error);
+    REQUIRE_THROWS_AS(gpscat::BlockScheduler("no-such-arch", ""), std::runtime_error);
+}
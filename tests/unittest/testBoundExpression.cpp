@@ -0,0 +1,79 @@
+#include "catch.hpp"
+
+#include <gpscat/BoundExpression.h>
+
+#include <cmath>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using gpscat::BoundExpression;
+
+static double eval(const std::string &str, double defaultValue = 0) {
+    return BoundExpression::parse(str).evaluate({{"x", 3}, {"V_arg0", 10}}, defaultValue);
+}
+
+TEST_CASE("BoundExpression: arithmetic", "[boundExpression]") {
+    REQUIRE(eval("1466") == 1466);
+    REQUIRE(eval("1+2*3") == 7);
+    REQUIRE(eval("(1+2)*3") == 9);
+    REQUIRE(eval("10-4-3") == 3);
+    REQUIRE(eval("-x+4") == 1);
+    REQUIRE(eval("x^2") == 9);
+    REQUIRE(eval("1/2*x") == 1.5);
+    REQUIRE(eval("2*V_arg0+x") == 23);
+}
+
+TEST_CASE("BoundExpression: CoFloCo functions", "[boundExpression]") {
+    REQUIRE(eval("nat(x-5)") == 0);
+    REQUIRE(eval("nat(x-1)") == 2);
+    REQUIRE(eval("max([x,7])") == 7);
+    REQUIRE(eval("max([nat(x-1),1])*2") == 4);
+    REQUIRE(eval("min([x,V_arg0])") == 3);
+    REQUIRE(eval("max(x,V_arg0)") == 10);
+    REQUIRE(std::isinf(eval("oo")));
+    REQUIRE(eval("y", 1000) == 1000);
+}
+
+TEST_CASE("BoundExpression: variables and errors", "[boundExpression]") {
+    REQUIRE(BoundExpression::parse("nat(V_arg0-1)*max([V_arg1,x])+3").getVariables() == std::set<std::string>{"V_arg0", "V_arg1", "x"});
+    REQUIRE(BoundExpression::parse("oo").getVariables().empty());
+
+    REQUIRE_THROWS_AS(BoundExpression::parse(""), std::invalid_argument);
+    REQUIRE_THROWS_AS(BoundExpression::parse("1+"), std::invalid_argument);
+    REQUIRE_THROWS_AS(BoundExpression::parse("nat(x"), std::invalid_argument);
+    REQUIRE_THROWS_AS(BoundExpression::parse("x y"), std::invalid_argument);
+    REQUIRE_THROWS_AS(eval("foo(x)"), std::invalid_argument);
+}
+
+TEST_CASE("BoundExpression: mean over ranges", "[boundExpression]") {
+    REQUIRE(BoundExpression::parse("42").estimateMean({}, 10) == 42);
+    REQUIRE(BoundExpression::parse("2*x").estimateMean({{"x", {5, 5}}}, 10) == 10);
+
+    double mean = BoundExpression::parse("x+2*y").estimateMean({{"x", {0, 10}}, {"y", {0, 1}}}, 10000);
+    REQUIRE(std::abs(mean - 6) < 0.2);
+}
+
+TEST_CASE("BoundExpression: degree", "[boundExpression]") {
+    auto degree = [](const std::string &str) {
+        return BoundExpression::parse(str).getDegree();
+    };
+
+    REQUIRE(degree("1466") == 0);
+    REQUIRE(degree("2000*nat(V_n)+5") == 1);
+    REQUIRE(degree("nat(V_n)*nat(V_m-1)+V_n") == 2);
+    REQUIRE(degree("max([nat(V_n)^3,V_m])") == 3);
+    REQUIRE(degree("min([nat(V_n)^3,V_m])") == 1);
+    REQUIRE(degree("nat(V_n)/2") == 1);
+
+    // Between the powers
+    REQUIRE(degree("nat(V_n)*log(2,nat(V_n))") > 1);
+    REQUIRE(degree("nat(V_n)*log(2,nat(V_n))") < 2);
+    REQUIRE(degree("log(2,nat(V_n))") < degree("nat(V_n)"));
+
+    // Above every polynomial, below oo
+    REQUIRE(degree("pow(2,nat(V_n))") > degree("nat(V_n)^100"));
+    REQUIRE(std::isfinite(degree("pow(2,nat(V_n))*pow(3,V_m)")));
+    REQUIRE(std::isinf(degree("oo")));
+    REQUIRE(std::isinf(degree("nat(V_n)*oo")));
+}
@@ -0,0 +1,142 @@
+#include "catch.hpp"
+
+#include <gpscat-c/Analyzer.h>
+#include <gpscat/AnalysisCache.h>
+#include <gpscat/Analyzer.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+
+static const char *moduleText = R"(
+define internal void @f() {
+entry:
+  ret void
+}
+)";
+
+TEST_CASE("C API: options and cost model", "[capi]") {
+    gpscat_analyzer *analyzer = gpscat_analyzer_create();
+    REQUIRE(analyzer);
+
+    REQUIRE(gpscat_analyzer_set_option(analyzer, "arch", "wasm32") == GPSCAT_OK);
+    REQUIRE(gpscat_analyzer_set_option(analyzer, "eager-inline", "1") == GPSCAT_OK);
+    REQUIRE(gpscat_analyzer_set_option(analyzer, "inline", "-1") == GPSCAT_ERROR_INVALID_ARGUMENT);
+    REQUIRE(std::string(gpscat_analyzer_get_error(analyzer)) == "invalid value of inline: -1");
+    REQUIRE(gpscat_analyzer_set_option(analyzer, "color", "red") == GPSCAT_ERROR_INVALID_ARGUMENT);
+
+    REQUIRE(gpscat_analyzer_analyze(analyzer, moduleText, std::strlen(moduleText)) == GPSCAT_ERROR_STATE);
+    REQUIRE(gpscat_analyzer_load_cost_model(analyzer, "/nonexistent/cost.csv") == GPSCAT_ERROR_COST_MODEL);
+
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd,1\n";
+    REQUIRE(gpscat_analyzer_load_cost_model(analyzer, costModelPath.c_str()) == GPSCAT_OK);
+    REQUIRE(gpscat_analyzer_set_option(analyzer, "arch", "x86-64") == GPSCAT_ERROR_STATE);
+
+    REQUIRE(gpscat_analyzer_analyze(analyzer, "garbage", 7) == GPSCAT_OK);
+    REQUIRE(gpscat_result_status(analyzer) == GPSCAT_STATUS_FAILED);
+    REQUIRE(std::string(gpscat_result_stage(analyzer)) == "parse");
+    REQUIRE(gpscat_result_bound(analyzer) == nullptr);
+    REQUIRE(gpscat_result_num_functions(analyzer) == 0);
+    REQUIRE(gpscat_result_function_name(analyzer, 0) == nullptr);
+
+    gpscat_analyzer_free(analyzer);
+    llvm::sys::fs::remove(costModelPath);
+}
+
+TEST_CASE("C API: results", "[capi]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd,1\n";
+    std::string directory = gpscat::getTemporaryFilePath("gpscat-test", "cache");
+    llvm::sys::fs::remove(directory);
+
+    // Cached block costs, and no externally visible function to solve
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(moduleText, err, context);
+    REQUIRE(M);
+    gpscat::AnalysisCache cache(directory, 1);
+    gpscat::Analyzer keys(costModelPath, gpscat::Analyzer::Options());
+    cache.storeBlockCosts(keys.getBlockCostKey(*M->getFunction("f")), {7});
+
+    gpscat_analyzer *analyzer = gpscat_analyzer_create();
+    REQUIRE(gpscat_analyzer_set_option(analyzer, "cache-dir", directory.c_str()) == GPSCAT_OK);
+    REQUIRE(gpscat_analyzer_set_option(analyzer, "all-functions", "1") == GPSCAT_OK);
+    REQUIRE(gpscat_analyzer_load_cost_model(analyzer, costModelPath.c_str()) == GPSCAT_OK);
+
+    // The same analyzer is reused for several inputs
+    for(int i = 0; i < 2; ++i) {
+        REQUIRE(gpscat_analyzer_analyze(analyzer, moduleText, std::strlen(moduleText)) == GPSCAT_OK);
+        REQUIRE(gpscat_result_status(analyzer) == GPSCAT_STATUS_COMPLETE);
+        REQUIRE(gpscat_result_num_functions(analyzer) == 1);
+        REQUIRE(std::string(gpscat_result_function_name(analyzer, 0)) == "f");
+        REQUIRE(gpscat_result_function_bound(analyzer, 0) == nullptr);
+
+        std::size_t numBlocks = 0;
+        const int32_t *blockCosts = gpscat_result_block_costs(analyzer, 0, &numBlocks);
+        REQUIRE(numBlocks == 1);
+        REQUIRE(blockCosts[0] == 7);
+        REQUIRE(std::string(gpscat_result_json(analyzer)).find("\"blockCosts\":[7]") != std::string::npos);
+    }
+
+    gpscat_analyzer_free(analyzer);
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove_directories(directory);
+}
+
+TEST_CASE("C API: bounds of several resources", "[capi]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost,energy\nadd,1,7\n";
+    std::string directory = gpscat::getTemporaryFilePath("gpscat-test", "cache");
+    llvm::sys::fs::remove(directory);
+
+    // A solver worker which finds the same bound for everything
+    std::string solver = gpscat::getTemporaryFilePath("gpscat-test", "solver.sh");
+    std::ofstream(solver) << "#!/bin/sh\nwhile read -r line; do echo \"ok 42\"; done\n";
+    llvm::sys::fs::setPermissions(solver, llvm::sys::fs::owner_all);
+
+    const char *text = "define void @f() {\n"
+                       "entry:\n"
+                       "  ret void\n"
+                       "}\n";
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(text, err, context);
+    REQUIRE(M);
+    gpscat::AnalysisCache cache(directory, 1);
+    gpscat::Analyzer keys(costModelPath, gpscat::Analyzer::Options());
+    cache.storeBlockCosts(keys.getBlockCostKey(*M->getFunction("f")), {2});
+    cache.storeBlockCosts(keys.getBlockCostKey(*M->getFunction("f"), 1), {14});
+
+    gpscat_analyzer *analyzer = gpscat_analyzer_create();
+    REQUIRE(gpscat_analyzer_set_option(analyzer, "cache-dir", directory.c_str()) == GPSCAT_OK);
+    REQUIRE(gpscat_analyzer_set_option(analyzer, "function", "f") == GPSCAT_OK);
+    REQUIRE(gpscat_analyzer_set_option(analyzer, "solver-worker", solver.c_str()) == GPSCAT_OK);
+    REQUIRE(gpscat_analyzer_load_cost_model(analyzer, costModelPath.c_str()) == GPSCAT_OK);
+
+    REQUIRE(gpscat_analyzer_analyze(analyzer, text, std::strlen(text)) == GPSCAT_OK);
+    REQUIRE(gpscat_result_status(analyzer) == GPSCAT_STATUS_COMPLETE);
+    REQUIRE(std::string(gpscat_result_bound(analyzer)) == "42");
+    REQUIRE(gpscat_result_num_resources(analyzer) == 2);
+    REQUIRE(std::string(gpscat_result_resource_name(analyzer, 0)) == "Cost");
+    REQUIRE(std::string(gpscat_result_resource_name(analyzer, 1)) == "energy");
+    REQUIRE(std::string(gpscat_result_resource_bound(analyzer, 1)) == "42");
+    REQUIRE(gpscat_result_resource_name(analyzer, 2) == nullptr);
+    REQUIRE(gpscat_result_resource_bound(analyzer, 2) == nullptr);
+
+    std::size_t numBlocks = 0;
+    REQUIRE(gpscat_result_block_costs(analyzer, 0, &numBlocks)[0] == 2);
+
+    gpscat_analyzer_free(analyzer);
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove(solver);
+    llvm::sys::fs::remove_directories(directory);
+}
@@ -2,6 +2,7 @@
 
 #include <gpscat/CoFloCoWrapper.h>
 #include <string>
+#include <algorithm>
 
 using gpscat::CoFloCoWrapper;
 
@@ -40,3 +41,21 @@ TEST_CASE("CoFloCoWrapper: replaceNatWithMax", "[coflocoWrapper]") {
     REQUIRE(wrapper.replaceNatWithMax("max([nat(x+1)-1,3])-1") == "max([max([x+1,0])-1,3])-1");
     REQUIRE(wrapper.replaceNatWithMax("x+max([nat(max([nat(x),nat(2*x-2)])),1466])-1") == "x+max([max([max([max([x,0]),max([2*x-2,0])]),0]),1466])-1");
 }
+
+TEST_CASE("CoFloCoWrapper: portfolio", "[coflocoWrapper]") {
+    gpscat::SolverConfiguration base;
+    base.numInlines = 1000;
+
+    auto portfolio = gpscat::getPortfolio(base);
+    REQUIRE(portfolio.front().str() == base.str());
+    for(std::size_t i = 0; i < portfolio.size(); ++i)
+        for(std::size_t j = i + 1; j < portfolio.size(); ++j)
+            REQUIRE(portfolio[i].str() != portfolio[j].str());
+
+    REQUIRE(std::any_of(portfolio.begin(), portfolio.end(), [](const gpscat::SolverConfiguration &configuration) {
+        return configuration.eagerInline;
+    }));
+    REQUIRE(std::any_of(portfolio.begin(), portfolio.end(), [](const gpscat::SolverConfiguration &configuration) {
+        return !configuration.solveFast;
+    }));
+}
@@ -0,0 +1,199 @@
+#include "catch.hpp"
+
+#include <gpscat/CompositionalAnalyzer.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using gpscat::CompositionalAnalyzer;
+
+static const char *callerSource =
+    "declare void @tick(i32)\n"
+    "define void @g(i32 %n, i32 %m) {\n"
+    "entry:\n  ret void\n"
+    "}\n"
+    "define void @f(i32 %x) {\n"
+    "entry:\n  call void @g(i32 %x, i32 7)\n  ret void\n"
+    "}\n";
+
+static llvm::CallBase *getFirstCall(llvm::Function *F) {
+    for(auto &&BB : *F)
+        for(auto &&I : BB)
+            if(auto *call = llvm::dyn_cast<llvm::CallBase>(&I))
+                return call;
+    return nullptr;
+}
+
+static llvm::CallBase *getTickCall(llvm::Function *F) {
+    for(auto &&BB : *F)
+        for(auto &&I : BB)
+            if(auto *call = llvm::dyn_cast<llvm::CallBase>(&I))
+                if(call->getCalledFunction()->getName() == "tick")
+                    return call;
+    return nullptr;
+}
+
+TEST_CASE("CompositionalAnalyzer: replaceCallBySummary", "[compositionalAnalyzer]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(callerSource, err, context);
+    REQUIRE(M);
+    llvm::Function *f = M->getFunction("f");
+
+    SECTION("parameters are replaced by the call arguments") {
+        REQUIRE(CompositionalAnalyzer::replaceCallBySummary(getFirstCall(f), "2*V_n+V_m"));
+
+        llvm::CallBase *tick = getTickCall(f);
+        REQUIRE(tick);
+
+        // 2*%x+7, or INT64_MAX when it overflows
+        auto *saturated = llvm::dyn_cast<llvm::SelectInst>(tick->getArgOperand(0));
+        REQUIRE(saturated);
+        REQUIRE(llvm::cast<llvm::ConstantInt>(saturated->getTrueValue())->isMaxValue(true));
+        auto *add = llvm::dyn_cast<llvm::ExtractValueInst>(saturated->getFalseValue());
+        REQUIRE(add);
+        auto *addCall = llvm::dyn_cast<llvm::CallInst>(add->getAggregateOperand());
+        REQUIRE(addCall);
+        REQUIRE(addCall->getCalledFunction()->getIntrinsicID() == llvm::Intrinsic::sadd_with_overflow);
+        auto *constant = llvm::dyn_cast<llvm::ConstantInt>(addCall->getArgOperand(1));
+        REQUIRE(constant);
+        REQUIRE(constant->getSExtValue() == 7);
+    }
+
+    SECTION("constant bounds become a constant tick") {
+        REQUIRE(CompositionalAnalyzer::replaceCallBySummary(getFirstCall(f), "max([3,nat(5)])"));
+
+        llvm::CallBase *tick = getFirstCall(f);
+        REQUIRE(tick->getCalledFunction()->getName() == "tick");
+        auto *constant = llvm::dyn_cast<llvm::ConstantInt>(tick->getArgOperand(0));
+        REQUIRE(constant);
+        REQUIRE(constant->getSExtValue() == 5);
+    }
+
+    SECTION("unbounded and unknown bounds are rejected") {
+        REQUIRE_FALSE(CompositionalAnalyzer::replaceCallBySummary(getFirstCall(f), "oo"));
+        REQUIRE_FALSE(CompositionalAnalyzer::replaceCallBySummary(getFirstCall(f), "V_unknown+1"));
+        REQUIRE_FALSE(CompositionalAnalyzer::replaceCallBySummary(getFirstCall(f), "V_n/V_m"));
+
+        // The call is left untouched
+        REQUIRE(getFirstCall(f)->getCalledFunction()->getName() == "g");
+        REQUIRE(f->front().size() == 2);
+    }
+}
+
+TEST_CASE("CompositionalAnalyzer: replaceCallsBySummaries", "[compositionalAnalyzer]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(
+        "define void @g(i32 %n.addr) {\n"
+        "entry:\n  ret void\n"
+        "}\n"
+        "define void @f(i32 %x) {\n"
+        "entry:\n  call void @g(i32 %x)\n  call void @g(i32 3)\n  ret void\n"
+        "}\n", err, context);
+    REQUIRE(M);
+    llvm::Function *f = M->getFunction("f");
+    std::vector<llvm::CallBase*> calls;
+    for(auto &&I : f->front())
+        if(auto *call = llvm::dyn_cast<llvm::CallBase>(&I))
+            calls.push_back(call);
+    REQUIRE(calls.size() == 2);
+
+    SECTION("nothing is replaced when one bound cannot be computed") {
+        REQUIRE_FALSE(CompositionalAnalyzer::replaceCallsBySummaries({{calls[0], "V_n_addr"}, {calls[1], "oo"}}));
+        REQUIRE(!M->getFunction("tick"));
+        REQUIRE(f->front().size() == 3);
+        REQUIRE(getFirstCall(f) == calls[0]);
+    }
+
+    SECTION("parameter names are mangled like llvm2kittel does") {
+        REQUIRE(CompositionalAnalyzer::replaceCallsBySummaries({{calls[0], "V_n_addr"}, {calls[1], "V_n_addr+1"}}));
+
+        std::vector<llvm::Value*> costs;
+        for(auto &&I : f->front())
+            if(auto *call = llvm::dyn_cast<llvm::CallBase>(&I))
+                costs.push_back(call->getArgOperand(0));
+        REQUIRE(costs.size() == 2);
+        auto *sext = llvm::dyn_cast<llvm::SExtInst>(costs[0]);
+        REQUIRE(sext);
+        REQUIRE(sext->getOperand(0) == &*f->arg_begin());
+        auto *constant = llvm::dyn_cast<llvm::ConstantInt>(costs[1]);
+        REQUIRE(constant);
+        REQUIRE(constant->getSExtValue() == 4);
+    }
+}
+
+TEST_CASE("CompositionalAnalyzer: bounds beyond i32", "[compositionalAnalyzer]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(
+        "declare void @tick(i32)\n"
+        "define void @g(i64 %n) {\n"
+        "entry:\n  ret void\n"
+        "}\n"
+        "define void @f(i64 %x) {\n"
+        "entry:\n  call void @tick(i32 5)\n  call void @g(i64 %x)\n  ret void\n"
+        "}\n", err, context);
+    REQUIRE(M);
+    llvm::Function *f = M->getFunction("f");
+    auto *call = llvm::cast<llvm::CallBase>(getFirstCall(f)->getNextNode());
+    auto getTickArgument = [f](std::size_t i) {
+        std::vector<llvm::Value*> arguments;
+        for(auto &&I : f->front())
+            if(auto *call = llvm::dyn_cast<llvm::CallBase>(&I))
+                arguments.push_back(call->getArgOperand(0));
+        return arguments.at(i);
+    };
+    auto getConstantTick = [&](std::size_t i) {
+        auto *constant = llvm::dyn_cast<llvm::ConstantInt>(getTickArgument(i));
+        REQUIRE(constant);
+        return constant->getSExtValue();
+    };
+
+    SECTION("tick takes an i64") {
+        REQUIRE(CompositionalAnalyzer::replaceCallBySummary(call, "3000000000"));
+        REQUIRE(M->getFunction("tick")->getFunctionType()->getParamType(0)->isIntegerTy(64));
+        // The tick of cost2tick is widened
+        REQUIRE(getConstantTick(0) == 5);
+        REQUIRE(getConstantTick(1) == 3000000000);
+    }
+
+    SECTION("parameters are not truncated") {
+        REQUIRE(CompositionalAnalyzer::replaceCallBySummary(call, "V_n"));
+        REQUIRE(getTickArgument(1) == &*f->arg_begin());
+    }
+
+    SECTION("overflowing bounds saturate") {
+        REQUIRE(CompositionalAnalyzer::replaceCallBySummary(call, "4611686018427387904*4+1"));
+        REQUIRE(getConstantTick(1) == std::numeric_limits<int64_t>::max());
+    }
+}
+
+TEST_CASE("CompositionalAnalyzer: recursion", "[compositionalAnalyzer]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(
+        "define void @r(i32) {\n"
+        "entry:\n  call void @r(i32 %0)\n  ret void\n"
+        "}\n"
+        "define void @f(i32 %x) {\n"
+        "entry:\n  call void @r(i32 %x)\n  ret void\n"
+        "}\n", err, context);
+    REQUIRE(M);
+
+    // Neither function needs a solver: r is recursive and f calls r
+    CompositionalAnalyzer analyzer(gpscat::SolverConfiguration(), 1);
+    REQUIRE(analyzer.run(M.get(), "f") == "oo");
+    REQUIRE(analyzer.getSummaries().at("r") == "oo");
+    REQUIRE(M->getFunction("r")->arg_begin()->getName() == "arg0");
+}
@@ -0,0 +1,92 @@
+#include "catch.hpp"
+
+#include <gpscat/ControlSlicer.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <memory>
+#include <string>
+
+using gpscat::ControlSlicer;
+
+static bool hasInstruction(llvm::Function *F, const std::string &name) {
+    for(auto &&I : llvm::instructions(F))
+        if(I.getName() == name)
+            return true;
+    return false;
+}
+
+TEST_CASE("ControlSlicer: keep loop control, drop data path", "[controlSlicer]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(
+        "declare void @tick(i32)\n"
+        "define void @f(i32 %n, i32 %x) {\n"
+        "entry:\n"
+        "  %acc = alloca i32\n"
+        "  br label %loop\n"
+        "loop:\n"
+        "  %i = phi i32 [ 0, %entry ], [ %inc, %loop ]\n"
+        "  %h = phi i32 [ %x, %entry ], [ %mix, %loop ]\n"
+        "  %mix = mul i32 %h, 31\n"
+        "  store i32 %mix, i32* %acc\n"
+        "  call void @tick(i32 3)\n"
+        "  %inc = add i32 %i, 1\n"
+        "  %c = icmp slt i32 %inc, %n\n"
+        "  br i1 %c, label %loop, label %exit\n"
+        "exit:\n"
+        "  ret void\n"
+        "}\n", err, context);
+    REQUIRE(M);
+
+    ControlSlicer().run(M.get());
+    llvm::Function *F = M->getFunction("f");
+
+    REQUIRE(!llvm::verifyModule(*M));
+    REQUIRE(hasInstruction(F, "i"));
+    REQUIRE(hasInstruction(F, "inc"));
+    REQUIRE(hasInstruction(F, "c"));
+    REQUIRE(!hasInstruction(F, "h"));
+    REQUIRE(!hasInstruction(F, "mix"));
+    REQUIRE(!hasInstruction(F, "acc"));
+}
+
+TEST_CASE("ControlSlicer: keep stores feeding a loop counter", "[controlSlicer]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(
+        "define void @f(i32 %n) {\n"
+        "entry:\n"
+        "  %i.addr = alloca i32\n"
+        "  store i32 0, i32* %i.addr\n"
+        "  br label %loop\n"
+        "loop:\n"
+        "  %i = load i32, i32* %i.addr\n"
+        "  %inc = add i32 %i, 1\n"
+        "  store i32 %inc, i32* %i.addr\n"
+        "  %c = icmp slt i32 %inc, %n\n"
+        "  br i1 %c, label %loop, label %exit\n"
+        "exit:\n"
+        "  ret void\n"
+        "}\n", err, context);
+    REQUIRE(M);
+
+    ControlSlicer().run(M.get());
+    llvm::Function *F = M->getFunction("f");
+
+    REQUIRE(!llvm::verifyModule(*M));
+    REQUIRE(hasInstruction(F, "i.addr"));
+    REQUIRE(hasInstruction(F, "i"));
+    REQUIRE(hasInstruction(F, "inc"));
+
+    std::size_t numStores = 0;
+    for(auto &&I : llvm::instructions(F))
+        numStores += llvm::isa<llvm::StoreInst>(&I);
+    REQUIRE(numStores == 2);
+}
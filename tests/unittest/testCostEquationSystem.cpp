@@ -0,0 +1,81 @@
+#include "catch.hpp"
+
+#include <gpscat/CostEquationSystem.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using gpscat::CostEquationSystem;
+using gpscat::CostTerm;
+using strings = std::vector<std::string>;
+
+static const std::string loopCES =
+    "input_output_vars(eval_f_start(V_n,B),[V_n],[B]).\n"
+    "input_output_vars(eval_f_loop(V_n,V_i,B),[V_n,V_i],[B]).\n"
+    "eq(eval_f_start(V_n,B),1,[eval_f_loop(V_n,0,B)],[]).\n"
+    "eq(eval_f_loop(V_n,V_i,B),2,[eval_f_loop(V_n,V_i+1,B)],[V_i+1<V_n]).\n"
+    "eq(eval_f_loop(V_n,V_i,B),1,[eval_f_stop(B)],[V_i+1>=V_n]).\n"
+    "eq(eval_f_stop(A),0,[],[]).\n"
+    "eq(eval_f_dead(A),7,[],[]).\n";
+
+TEST_CASE("CostEquationSystem: parse terms", "[costEquationSystem]") {
+    CostTerm term = CostTerm::parse("eval_f(V_a,max(V_b,1),B)");
+    REQUIRE(term.name == "eval_f");
+    REQUIRE(term.args == strings{"V_a", "max(V_b,1)", "B"});
+    REQUIRE(term.str() == "eval_f(V_a,max(V_b,1),B)");
+}
+
+TEST_CASE("CostEquationSystem: parse equations", "[costEquationSystem]") {
+    CostEquationSystem ces = CostEquationSystem::parse(loopCES);
+    REQUIRE(ces.getEquations().size() == 5);
+    REQUIRE(ces.getEntryName() == "eval_f_start");
+
+    const auto &eq = ces.getEquations()[1];
+    REQUIRE(eq.head.name == "eval_f_loop");
+    REQUIRE(eq.cost == "2");
+    REQUIRE(eq.calls.size() == 1);
+    REQUIRE(eq.calls[0].args == strings{"V_n", "V_i+1", "B"});
+    REQUIRE(eq.constraints == "V_i+1<V_n");
+    REQUIRE(eq.str() == "eq(eval_f_loop(V_n,V_i,B),2,[eval_f_loop(V_n,V_i+1,B)],[V_i+1<V_n]).");
+
+    REQUIRE(CostEquationSystem::parse(ces.str()).str() == ces.str());
+}
+
+TEST_CASE("CostEquationSystem: components", "[costEquationSystem]") {
+    CostEquationSystem ces = CostEquationSystem::parse(loopCES);
+    auto components = ces.getComponents();
+
+    auto position = [&components](const std::string &name) {
+        return std::find_if(components.begin(), components.end(), [&name](const CostEquationSystem::Component &component) {
+            return std::find(component.begin(), component.end(), name) != component.end();
+        }) - components.begin();
+    };
+
+    REQUIRE(components.size() == 4);
+    REQUIRE(position("eval_f_stop") < position("eval_f_loop"));
+    REQUIRE(position("eval_f_loop") < position("eval_f_start"));
+    REQUIRE(ces.isRecursive({"eval_f_loop"}));
+    REQUIRE(!ces.isRecursive({"eval_f_start"}));
+    REQUIRE(ces.getComponentEntries({"eval_f_loop"}) == strings{"eval_f_loop"});
+}
+
+TEST_CASE("CostEquationSystem: extract and substitute", "[costEquationSystem]") {
+    CostEquationSystem ces = CostEquationSystem::parse(loopCES);
+
+    CostEquationSystem loop = ces.extract("eval_f_loop");
+    REQUIRE(loop.getEntryName() == "eval_f_loop");
+    REQUIRE(loop.getEquations().size() == 3);
+    REQUIRE(loop.str().compare(0, 30, "entry(eval_f_loop(V_n,V_i,B):[") == 0);
+
+    REQUIRE(!ces.substituteBound("eval_f_loop", "nat(V_n-V_i)", {"eval_f_loop"}));
+    REQUIRE(!ces.substituteBound("eval_f_loop", "oo", {"eval_f_loop"}));
+    REQUIRE(ces.substituteBound("eval_f_loop", "2*V_n-2*V_i+1", {"eval_f_loop"}));
+
+    const auto &start = ces.getEquations()[0];
+    REQUIRE(start.calls.empty());
+    REQUIRE(start.cost == "(1)+(2*(V_n)-2*(0)+1)");
+
+    ces.removeUnreachable();
+    REQUIRE(ces.getEquations().size() == 1);
+}
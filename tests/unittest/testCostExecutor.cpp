@@ -0,0 +1,145 @@
+#include "catch.hpp"
+
+#include <gpscat/AnalysisCache.h>
+#include <gpscat/Analyzer.h>
+#include <gpscat/CostExecutor.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+static gpscat::CostExecutor createExecutor(const std::string &source, const std::string &functionName) {
+    auto context = std::make_unique<llvm::LLVMContext>();
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(source, err, *context);
+    REQUIRE(M);
+    return gpscat::CostExecutor(std::move(context), std::move(M), functionName);
+}
+
+// 2 per iteration of a loop running n times, 5 on exit, of a module for
+// another target
+static const char *const LoopSource =
+    "target datalayout = \"e-m:e-p:32:32-i64:64-n32:64-S128\"\n"
+    "target triple = \"wasm32\"\n"
+    "declare void @tick(i32)\n"
+    "declare void @abort()\n"
+    "define i32 @f(i32 %n, i8 %crash) #0 {\n"
+    "entry:\n"
+    "  %c = icmp ne i8 %crash, 0\n"
+    "  br i1 %c, label %die, label %header\n"
+    "header:\n"
+    "  %i = phi i32 [ 0, %entry ], [ %next, %body ]\n"
+    "  %more = icmp slt i32 %i, %n\n"
+    "  br i1 %more, label %body, label %exit\n"
+    "body:\n"
+    "  %next = add i32 %i, 1\n"
+    "  call void @tick(i32 2)\n"
+    "  br label %header\n"
+    "exit:\n"
+    "  call void @tick(i32 5)\n"
+    "  ret i32 %i\n"
+    "die:\n"
+    "  call void @abort()\n"
+    "  unreachable\n"
+    "}\n"
+    "define void @spin() {\n"
+    "entry:\n"
+    "  br label %loop\n"
+    "loop:\n"
+    "  call void @tick(i32 1)\n"
+    "  br label %loop\n"
+    "}\n"
+    "define void @g(float %x) {\n"
+    "  ret void\n"
+    "}\n"
+    "attributes #0 = { \"target-cpu\"=\"generic\" \"target-features\"=\"+simd128\" }\n";
+
+TEST_CASE("CostExecutor: counted ticks", "[costExecutor]") {
+    gpscat::CostExecutor executor = createExecutor(LoopSource, "f");
+    REQUIRE(executor.getNumParameters() == 2);
+
+    REQUIRE(executor.run({0, 0}, 0) == 5);
+    REQUIRE(executor.run({10, 0}, 0) == 25);
+    // The counter starts at zero for every call
+    REQUIRE(executor.run({10, 0}, 0) == 25);
+    // Arguments are truncated to the parameter types
+    REQUIRE(executor.run({3, 256}, 0) == 11);
+
+    REQUIRE(!executor.run({3, 1}, 0));
+    REQUIRE(!executor.run({3}, 0));
+}
+
+TEST_CASE("CostExecutor: timeout", "[costExecutor]") {
+    gpscat::CostExecutor executor = createExecutor(LoopSource, "spin");
+    REQUIRE(!executor.run({}, 1));
+}
+
+TEST_CASE("CostExecutor: unsupported functions", "[costExecutor]") {
+    REQUIRE_THROWS_AS(createExecutor(LoopSource, "g"), std::runtime_error);
+    REQUIRE_THROWS_AS(createExecutor(LoopSource, "abort"), std::runtime_error);
+    REQUIRE_THROWS_AS(createExecutor(LoopSource, "missing"), std::runtime_error);
+}
+
+TEST_CASE("CostExecutor: callees of a compositional analysis", "[costExecutor]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd,1\n";
+    std::string directory = gpscat::getTemporaryFilePath("gpscat-test", "cache");
+    llvm::sys::fs::remove(directory);
+
+    // A solver worker which finds the same bound for everything
+    std::string solver = gpscat::getTemporaryFilePath("gpscat-test", "solver.sh");
+    std::ofstream(solver) << "#!/bin/sh\nwhile read -r line; do echo \"ok 42\"; done\n";
+    llvm::sys::fs::setPermissions(solver, llvm::sys::fs::owner_all);
+
+    auto context = std::make_unique<llvm::LLVMContext>();
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(
+        "define void @g(i32 %n) {\n"
+        "entry:\n"
+        "  br label %header\n"
+        "header:\n"
+        "  %i = phi i32 [ 0, %entry ], [ %next, %body ]\n"
+        "  %more = icmp slt i32 %i, %n\n"
+        "  br i1 %more, label %body, label %exit\n"
+        "body:\n"
+        "  %next = add i32 %i, 1\n"
+        "  br label %header\n"
+        "exit:\n"
+        "  ret void\n"
+        "}\n"
+        "define void @f(i32 %x) {\n"
+        "  call void @g(i32 %x)\n"
+        "  ret void\n"
+        "}\n", err, *context);
+    REQUIRE(M);
+
+    gpscat::Analyzer::Options options;
+    options.cacheDir = directory;
+    options.compositional = true;
+    options.configuration.functionName = "f";
+    options.configuration.solverWorker = solver;
+    gpscat::Analyzer analyzer(costModelPath, options);
+    gpscat::AnalysisCache cache(directory, 1);
+    cache.storeBlockCosts(analyzer.getBlockCostKey(*M->getFunction("g")), {0, 1, 2, 0});
+    cache.storeBlockCosts(analyzer.getBlockCostKey(*M->getFunction("f")), {1});
+
+    gpscat::AnalysisResult result = analyzer.analyze(M.get());
+    REQUIRE(result.bound == "42");
+
+    // The call to g is still there: its ticks are counted, not the 42 of
+    // its summary
+    gpscat::CostExecutor executor(std::move(context), std::move(M), "f");
+    REQUIRE(executor.run({3}, 0) == 1 + 4 * 1 + 3 * 2);
+
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove(solver);
+    llvm::sys::fs::remove_directories(directory);
+}
@@ -0,0 +1,74 @@
+#include "catch.hpp"
+
+#include <gpscat/CostFit.h>
+
+#include <cmath>
+#include <vector>
+
+using gpscat::CostObservation;
+
+TEST_CASE("CostFit: known costs", "[costFit]") {
+    // Kernels of one or two mnemonics at the lengths gpscat-calibrate
+    // uses, with a call overhead of 5 and costs 1 and 3. Mnemonic 3 has
+    // no kernel.
+    const double costs[] = {5, 1, 3};
+    std::vector<CostObservation> observations;
+    for(unsigned int length : {8, 16, 32, 64}) {
+        observations.push_back({{{0, 1}, {1, length}}, costs[0] + length * costs[1]});
+        observations.push_back({{{0, 1}, {2, length}}, costs[0] + length * costs[2]});
+        observations.push_back({{{0, 1}, {1, length}, {2, length}}, costs[0] + length * (costs[1] + costs[2])});
+    }
+
+    gpscat::CostFit fit;
+    REQUIRE(gpscat::fitCosts(observations, 4, fit));
+    REQUIRE(fit.degreesOfFreedom == 12 - 3);
+    REQUIRE(fit.observed == std::vector<bool>{true, true, true, false});
+    for(std::size_t j = 0; j < 3; ++j) {
+        REQUIRE(fit.costs[j] == Approx(costs[j]));
+        REQUIRE(fit.halfWidths[j] == Approx(0).margin(1e-6));
+    }
+    REQUIRE(fit.costs[3] == 0);
+    REQUIRE(fit.halfWidths[3] == 0);
+
+    // With noise the intervals are wider, and still hold the costs
+    for(std::size_t i = 0; i < observations.size(); ++i)
+        observations[i].value += i % 2 ? 0.5 : -0.5;
+    REQUIRE(gpscat::fitCosts(observations, 4, fit));
+    for(std::size_t j = 0; j < 3; ++j) {
+        REQUIRE(fit.halfWidths[j] > 0);
+        REQUIRE(std::abs(fit.costs[j] - costs[j]) < fit.halfWidths[j]);
+    }
+}
+
+TEST_CASE("CostFit: standard errors of a line", "[costFit]") {
+    // value = a + b x for x = 1..4 fits a = 0.5 and b = 1.4 with residuals
+    // 0.1, -0.3, 0.3, -0.1: RSS 0.2 over 2 degrees of freedom, and
+    // Sxx = 5, so b has the standard error sqrt(0.1 / 5)
+    std::vector<CostObservation> observations = {
+        {{{0, 1}, {1, 1}}, 2}, {{{0, 1}, {1, 2}}, 3}, {{{0, 1}, {1, 3}}, 5}, {{{0, 1}, {1, 4}}, 6}};
+    gpscat::CostFit fit;
+    REQUIRE(gpscat::fitCosts(observations, 2, fit));
+    REQUIRE(fit.degreesOfFreedom == 2);
+    REQUIRE(fit.costs[0] == Approx(0.5));
+    REQUIRE(fit.costs[1] == Approx(1.4));
+    REQUIRE(fit.halfWidths[1] == Approx(4.303 * std::sqrt(0.1 / 5)));
+    // 1/m + mean^2 / Sxx for the intercept
+    REQUIRE(fit.halfWidths[0] == Approx(4.303 * std::sqrt(0.1 * (0.25 + 2.5 * 2.5 / 5))));
+}
+
+TEST_CASE("CostFit: too few observations", "[costFit]") {
+    gpscat::CostFit fit;
+    // As many observations as observed variables
+    REQUIRE(!gpscat::fitCosts({{{{0, 1}, {1, 8}}, 13}, {{{0, 1}, {1, 16}}, 21}}, 3, fit));
+    // Variables that always appear together cannot be told apart
+    REQUIRE(!gpscat::fitCosts({{{{0, 1}, {1, 8}, {2, 8}}, 13}, {{{0, 1}, {1, 16}, {2, 16}}, 21}, {{{0, 1}, {1, 32}, {2, 32}}, 37}}, 3, fit));
+}
+
+TEST_CASE("CostFit: Student's t quantiles", "[costFit]") {
+    REQUIRE(gpscat::getStudentQuantile975(1) == Approx(12.706));
+    REQUIRE(gpscat::getStudentQuantile975(30) == Approx(2.042));
+    REQUIRE(gpscat::getStudentQuantile975(31) == Approx(2.040).margin(0.001));
+    REQUIRE(gpscat::getStudentQuantile975(60) == Approx(2.000).margin(0.001));
+    REQUIRE(gpscat::getStudentQuantile975(120) == Approx(1.980).margin(0.001));
+    REQUIRE(gpscat::getStudentQuantile975(100000) == Approx(1.960).margin(0.001));
+}
@@ -0,0 +1,74 @@
+#include "catch.hpp"
+
+#include <gpscat/AssemblyCostModel.h>
+#include <gpscat/CostModelGenerator.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/Support/FileSystem.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using gpscat::CostModelGenerator;
+
+static std::map<std::string, CostModelGenerator::Entry> byMnemonic(const std::vector<CostModelGenerator::Entry> &entries) {
+    std::map<std::string, CostModelGenerator::Entry> result;
+    for(const auto &entry : entries)
+        result.emplace(entry.mnemonic, entry);
+    return result;
+}
+
+TEST_CASE("CostModelGenerator: x86-64 on skylake", "[costModelGenerator]") {
+    CostModelGenerator generator("x86-64", "", "skylake", "");
+
+    CostModelGenerator::Options options;
+    options.aggregate = CostModelGenerator::Aggregate::Min;
+    std::vector<CostModelGenerator::Entry> entries = generator.generate(options);
+    REQUIRE(std::is_sorted(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+        return a.mnemonic < b.mnemonic;
+    }));
+
+    auto costs = byMnemonic(entries);
+    REQUIRE(costs.count("addq"));
+    REQUIRE(costs["addq"].latency == 1);
+    REQUIRE(costs["addq"].throughput == 1);
+    REQUIRE(costs["imulq"].latency == 3);
+    REQUIRE(costs["divq"].latency > costs["imulq"].latency);
+
+    // Left out mnemonics have no entry
+    for(const auto &mnemonic : generator.getUnscheduledMnemonics())
+        REQUIRE(!costs.count(mnemonic));
+
+    // The register form is the cheapest of addq, not the most expensive
+    options.aggregate = CostModelGenerator::Aggregate::Max;
+    REQUIRE(byMnemonic(generator.generate(options))["addq"].latency > 1);
+
+    options.aggregate = CostModelGenerator::Aggregate::Min;
+    options.scale = 2;
+    REQUIRE(byMnemonic(generator.generate(options))["addq"].latency == 2);
+
+    // The CSV is a cost model gpscat-cost reads
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << CostModelGenerator::toCSV(entries, true);
+    gpscat::AssemblyCostModel costModel(costModelPath);
+    REQUIRE(costModel.getNumResources() == 2);
+    REQUIRE(costModel.getResourceName(1) == "throughput");
+    REQUIRE(costModel.get("imulq") == 3);
+    llvm::sys::fs::remove(costModelPath);
+}
+
+TEST_CASE("CostModelGenerator: CSV columns", "[costModelGenerator]") {
+    std::vector<CostModelGenerator::Entry> entries = {{"add", 1, 2}, {"div", 20, 8}};
+    REQUIRE(CostModelGenerator::toCSV(entries, true) == "Opcode,Cost,throughput\nadd,1,2\ndiv,20,8\n");
+    REQUIRE(CostModelGenerator::toCSV(entries, false) == "Opcode,Cost,latency\nadd,2,1\ndiv,8,20\n");
+}
+
+TEST_CASE("CostModelGenerator: unusable targets", "[costModelGenerator]") {
+    REQUIRE_THROWS_AS(CostModelGenerator("z80", "", "generic", ""), std::runtime_error);
+    // WebAssembly has no scheduling model
+    REQUIRE_THROWS_AS(CostModelGenerator("wasm32", "", "generic", ""), std::runtime_error);
+}
@@ -0,0 +1,120 @@
+#include "catch.hpp"
+
+#include <gpscat/IRLocator.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST_CASE("IRLocator: dense instruction IDs", "[irLocator]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(
+        "declare i32 @ext(i32)\n"
+        "define i32 @f(i32 %x) !dbg !6 {\n"
+        "entry:\n"
+        "  call void @llvm.dbg.value(metadata i32 %x, metadata !9, metadata !DIExpression()), !dbg !10\n"
+        "  %c = icmp sgt i32 %x, 0, !dbg !10\n"
+        "  br i1 %c, label %a, label %b, !dbg !10\n"
+        "a:\n"
+        "  %y = call i32 @ext(i32 %x), !dbg !10\n"
+        "  ret i32 %y, !dbg !10\n"
+        "b:\n"
+        "  ret i32 0, !dbg !10\n"
+        "}\n"
+        "define internal void @g() {\n"
+        "  ret void\n"
+        "}\n"
+        "define linkonce_odr void @h() {\n"
+        "  ret void\n"
+        "}\n"
+        "declare void @llvm.dbg.value(metadata, metadata, metadata)\n"
+        "!llvm.dbg.cu = !{!0}\n"
+        "!llvm.module.flags = !{!3}\n"
+        "!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, producer: \"clang\", isOptimized: false, emissionKind: FullDebug)\n"
+        "!1 = !DIFile(filename: \"f.c\", directory: \"/src\")\n"
+        "!3 = !{i32 2, !\"Debug Info Version\", i32 3}\n"
+        "!6 = distinct !DISubprogram(name: \"f\", scope: !1, file: !1, line: 40, type: !7, unit: !0)\n"
+        "!7 = !DISubroutineType(types: !8)\n"
+        "!8 = !{}\n"
+        "!9 = !DILocalVariable(name: \"x\", arg: 1, scope: !6, file: !1, line: 40, type: null)\n"
+        "!10 = !DILocation(line: 41, column: 3, scope: !6)\n", err, context);
+    REQUIRE(M);
+
+    gpscat::IRLocator().run(M.get());
+    REQUIRE(!llvm::verifyModule(*M, &llvm::errs()));
+
+    // The source's dbg.value is gone and no new ones are made
+    unsigned int line = 1;
+    for(auto &&BB : *M->getFunction("f")) {
+        for(auto &&I : BB) {
+            REQUIRE(!llvm::isa<llvm::DbgInfoIntrinsic>(&I));
+            REQUIRE(I.getDebugLoc());
+            REQUIRE(I.getDebugLoc().getLine() == line++);
+            REQUIRE(I.getDebugLoc()->getScope() == M->getFunction("f")->getSubprogram());
+        }
+    }
+    REQUIRE(line == 6);
+
+    llvm::Function *g = M->getFunction("g");
+    REQUIRE(g->getSubprogram());
+    REQUIRE(g->getSubprogram()->isLocalToUnit());
+    REQUIRE(g->front().front().getDebugLoc().getLine() == 6);
+
+    // Functions that may be replaced at link time get no IDs
+    REQUIRE(!M->getFunction("h")->getSubprogram());
+    REQUIRE(!M->getFunction("h")->front().front().getDebugLoc());
+
+    // Only the new compile unit is left
+    REQUIRE(M->getNamedMetadata("llvm.dbg.cu")->getNumOperands() == 1);
+    REQUIRE(M->getFunction("f")->getSubprogram()->getUnit()->getProducer() == "gpscat");
+    REQUIRE(M->getModuleFlag("Debug Info Version"));
+}
+
+TEST_CASE("IRLocator: source locations", "[irLocator]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(
+        "define i32 @f(i32 %x) !dbg !6 {\n"
+        "  call void @llvm.dbg.value(metadata i32 %x, metadata !9, metadata !DIExpression()), !dbg !10\n"
+        "  %y = add i32 %x, 1, !dbg !10\n"
+        "  %z = mul i32 %y, 3\n"
+        "  ret i32 %z, !dbg !11\n"
+        "}\n"
+        "declare void @llvm.dbg.value(metadata, metadata, metadata)\n"
+        "!llvm.dbg.cu = !{!0}\n"
+        "!llvm.module.flags = !{!3}\n"
+        "!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, producer: \"clang\", isOptimized: false, emissionKind: FullDebug)\n"
+        "!1 = !DIFile(filename: \"f.c\", directory: \"/src\")\n"
+        "!2 = !DIFile(filename: \"f.h\", directory: \"/src\")\n"
+        "!3 = !{i32 2, !\"Debug Info Version\", i32 3}\n"
+        "!6 = distinct !DISubprogram(name: \"f\", scope: !1, file: !1, line: 40, type: !7, unit: !0)\n"
+        "!7 = !DISubroutineType(types: !8)\n"
+        "!8 = !{}\n"
+        "!9 = !DILocalVariable(name: \"x\", arg: 1, scope: !6, file: !1, line: 40, type: null)\n"
+        "!10 = !DILocation(line: 41, column: 3, scope: !6)\n"
+        "!11 = !DILocation(line: 7, column: 1, scope: !12)\n"
+        "!12 = !DILexicalBlockFile(scope: !6, file: !2, discriminator: 0)\n", err, context);
+    REQUIRE(M);
+
+    // Kept by ID, the dbg.value gets none
+    gpscat::IRLocator irLocator;
+    irLocator.run(M.get());
+
+    REQUIRE(irLocator.getSourceFiles() == std::vector<std::string>{"f.c", "f.h"});
+    const auto &locations = irLocator.getSourceLocations();
+    REQUIRE(locations.size() == 4);
+    REQUIRE(locations[1].file == 0);
+    REQUIRE(locations[1].line == 41);
+    REQUIRE(locations[2].line == 0);
+    REQUIRE(locations[3].file == 1);
+    REQUIRE(locations[3].line == 7);
+}
@@ -0,0 +1,116 @@
+#include "catch.hpp"
+
+#include <gpscat/IncrementalAnalyzer.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+using gpscat::IncrementalAnalyzer;
+
+static std::string getSource(const std::string &calleeOpcode) {
+    return "define i32 @g(i32 %x) {\n"
+           "  %y = " + calleeOpcode + " i32 %x, 3\n"
+           "  ret i32 %y\n"
+           "}\n"
+           "define i32 @f(i32 %x) {\n"
+           "  %y = call i32 @g(i32 %x)\n"
+           "  ret i32 %y\n"
+           "}\n";
+}
+
+TEST_CASE("IncrementalAnalyzer: successive versions", "[incrementalAnalyzer]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\ni32.add,1\ni32.mul,4\n";
+    gpscat::AssemblyCostModel costModel(costModelPath);
+
+    // A solver worker which finds the same bound for everything
+    std::string solver = gpscat::getTemporaryFilePath("gpscat-test", "solver.sh");
+    std::ofstream(solver) << "#!/bin/sh\nwhile read -r line; do echo \"ok 42\"; done\n";
+    llvm::sys::fs::setPermissions(solver, llvm::sys::fs::owner_all);
+    gpscat::Analyzer::Options options;
+    options.configuration.solverWorker = solver;
+
+    auto analyze = [](IncrementalAnalyzer &analyzer, const std::string &source) {
+        llvm::LLVMContext context;
+        llvm::SMDiagnostic err;
+        std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(source, err, context);
+        REQUIRE(M);
+        gpscat::AnalysisResult result = analyzer.analyze(M.get());
+        REQUIRE(result.status == gpscat::AnalysisResult::Status::Complete);
+        REQUIRE(result.bound == "42");
+        return result;
+    };
+
+    SECTION("unchanged functions are reused, changed ones analyzed again") {
+        IncrementalAnalyzer analyzer(costModel, options);
+
+        gpscat::AnalysisResult result = analyze(analyzer, getSource("add"));
+        REQUIRE(analyzer.getNumCompiled() == 2);
+        REQUIRE(analyzer.getNumSolved() == 1);
+        REQUIRE(result.functionCosts.size() == 2);
+        REQUIRE(result.functionCosts[0].name == "g");
+        REQUIRE(result.functionCosts[0].blockCosts == std::vector<gpscat::CostTy>{1});
+
+        analyze(analyzer, getSource("add"));
+        REQUIRE(analyzer.getNumCompiled() == 0);
+        REQUIRE(analyzer.getNumSolved() == 0);
+
+        result = analyze(analyzer, getSource("mul"));
+        REQUIRE(analyzer.getNumCompiled() == 1);
+        REQUIRE(analyzer.getNumSolved() == 1);
+        REQUIRE(result.functionCosts[0].blockCosts == std::vector<gpscat::CostTy>{4});
+
+        // The first version of g was forgotten when it changed
+        analyze(analyzer, getSource("add"));
+        REQUIRE(analyzer.getNumCompiled() == 1);
+    }
+
+    SECTION("removed functions are kept for unrelated modules") {
+        IncrementalAnalyzer analyzer(costModel, options, false);
+
+        analyze(analyzer, getSource("add"));
+        analyze(analyzer, getSource("mul"));
+        analyze(analyzer, getSource("add"));
+        REQUIRE(analyzer.getNumCompiled() == 0);
+        REQUIRE(analyzer.getNumSolved() == 0);
+    }
+
+    SECTION("compositional summaries of unchanged callees are reused") {
+        options.compositional = true;
+        options.configuration.functionName = "f";
+        IncrementalAnalyzer analyzer(costModel, options);
+
+        analyze(analyzer, getSource("add"));
+        REQUIRE(analyzer.getNumSolved() == 2);
+
+        // Only g changed, but f calls it
+        analyze(analyzer, getSource("mul"));
+        REQUIRE(analyzer.getNumCompiled() == 1);
+        REQUIRE(analyzer.getNumSolved() == 2);
+
+        analyze(analyzer, getSource("mul"));
+        REQUIRE(analyzer.getNumSolved() == 0);
+    }
+
+    SECTION("the options of Analyzer apply") {
+        // Each resource of the cost model gets its own bound
+        std::ofstream(costModelPath) << "Opcode,Cost,energy\ni32.add,1,7\ni32.mul,4,9\n";
+        IncrementalAnalyzer analyzer(gpscat::AssemblyCostModel(costModelPath), options);
+
+        gpscat::AnalysisResult result = analyze(analyzer, getSource("add"));
+        REQUIRE(analyzer.getNumSolved() == 2);
+        REQUIRE(result.resourceBounds.size() == 2);
+        REQUIRE(result.resourceBounds[1].resource == "energy");
+    }
+
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove(solver);
+}
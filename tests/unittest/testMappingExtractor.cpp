@@ -0,0 +1,170 @@
+#include "catch.hpp"
+
+#include <gpscat/AssemblyCostModel.h>
+#include <gpscat/IRCostCalculator.h>
+#include <gpscat/MappingExtractor.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using gpscat::AssemblyCostModel;
+using gpscat::MappingExtractor;
+using gpscat::OpcodeID;
+
+static std::vector<std::string> names(const AssemblyCostModel &costModel, llvm::ArrayRef<OpcodeID> opcodes) {
+    std::vector<std::string> result;
+    for(OpcodeID opcode : opcodes)
+        result.push_back(costModel.getOpcodeName(opcode));
+    return result;
+}
+
+TEST_CASE("AssemblyCostModel: interned opcodes", "[mappingExtractor]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd,1\nmul,3\n";
+    AssemblyCostModel costModel(costModelPath);
+
+    REQUIRE(costModel.getNumOpcodes() == 2);
+    OpcodeID mul = costModel.getOpcodeID("mul");
+    REQUIRE(costModel.getOpcodeName(mul) == "mul");
+    REQUIRE(costModel.getCost(mul) == 3);
+    REQUIRE(costModel.getOpcodeID("div") == AssemblyCostModel::InvalidOpcode);
+
+    costModel.set("mul", 4);
+    costModel.set("div", 20);
+    REQUIRE(costModel.getOpcodeID("mul") == mul);
+    REQUIRE(costModel.get("mul") == 4);
+    REQUIRE(costModel.hasInst("div"));
+    REQUIRE(costModel.getNumOpcodes() == 3);
+    REQUIRE_THROWS_AS(costModel.get("sub"), std::out_of_range);
+
+    llvm::sys::fs::remove(costModelPath);
+}
+
+TEST_CASE("MappingExtractor: opcodes and costs by instruction ID", "[mappingExtractor]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd,1\nmul,3\nbr,2\n";
+    AssemblyCostModel costModel(costModelPath);
+
+    // The opcodes of instruction 1 are interleaved with the ones of 2
+    std::string asmPath = gpscat::getTemporaryFilePath("gpscat-test", "map.s");
+    std::ofstream(asmPath) << "f:\n"
+                              "\t.loc 1 1 1\n\tadd r0, r1\n"
+                              "\t.loc 1 2 1\n\tmul r0, r0\n\tnop\n"
+                              "\t.loc 1 1 1\n\tadd r0, r2\n"
+                              "\t.loc 1 3 1\n\tbr .LBB0_1\n";
+
+    MappingExtractor mappingExtractor;
+    gpscat::IRAsmMapping mapping = mappingExtractor.extractMapping(asmPath, costModel);
+    REQUIRE(mapping.getNumIDs() == 4);
+    REQUIRE(mapping.getOpcodes(gpscat::InstructionID(0)).empty());
+    REQUIRE(names(costModel, mapping.getOpcodes(1)) == std::vector<std::string>{"add", "add"});
+    REQUIRE(names(costModel, mapping.getOpcodes(2)) == std::vector<std::string>{"mul"});
+    REQUIRE(names(costModel, mapping.getOpcodes(3)) == std::vector<std::string>{"br"});
+    REQUIRE(mapping.getOpcodes(7).empty());
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(R"(
+        define i32 @f(i32 %n) !dbg !5 {
+        entry:
+          %a = add i32 %n, %n, !dbg !7
+          br label %exit, !dbg !9
+        exit:
+          %m = mul i32 %a, %a, !dbg !8
+          ret i32 %m
+        }
+
+        !llvm.dbg.cu = !{!0}
+        !llvm.module.flags = !{!3}
+
+        !0 = distinct !DICompileUnit(language: DW_LANG_C, file: !1, emissionKind: FullDebug)
+        !1 = !DIFile(filename: "f.ll", directory: "/")
+        !3 = !{i32 2, !"Debug Info Version", i32 3}
+        !5 = distinct !DISubprogram(name: "f", scope: null, file: !1, line: 1, type: !6, unit: !0)
+        !6 = !DISubroutineType(types: !{})
+        !7 = !DILocation(line: 1, column: 1, scope: !5)
+        !8 = !DILocation(line: 2, column: 1, scope: !5)
+        !9 = !DILocation(line: 3, column: 1, scope: !5)
+    )", err, context);
+    REQUIRE(M);
+
+    gpscat::IRCostCalculator irCostCalculator(M.get(), costModel, mappingExtractor.extractMapping(asmPath, costModel, M.get()));
+    llvm::Function *F = M->getFunction("f");
+    llvm::BasicBlock &entry = F->getEntryBlock();
+    llvm::BasicBlock &exit = *std::next(F->begin());
+
+    REQUIRE(irCostCalculator.getInstCost(&entry.front()) == 2);
+    REQUIRE(irCostCalculator.getInstCost(exit.getTerminator()) == 0);
+    REQUIRE(irCostCalculator.getBlockCost(&entry) == 4);
+    REQUIRE(irCostCalculator.getBlockCost(&exit) == 3);
+
+    gpscat::BlockCostMapType blockCostMap = irCostCalculator.getBlockCostMap();
+    REQUIRE(blockCostMap.size() == 2);
+    REQUIRE(blockCostMap[&entry] == 4);
+
+    // A copy of an instruction keeps its ID but not its cost
+    llvm::Instruction *copy = entry.front().clone();
+    copy->insertBefore(entry.getTerminator());
+    REQUIRE(irCostCalculator.getInstCost(copy) == 0);
+    REQUIRE(irCostCalculator.getBlockCost(&entry) == 4);
+    copy->eraseFromParent();
+
+    // Every resource from the same mapping
+    std::ofstream(costModelPath) << "Opcode,Cost,energy\nadd,1,10\nmul,3,30\nbr,2,0\n";
+    AssemblyCostModel resourceCostModel(costModelPath);
+    gpscat::IRCostCalculator resourceCostCalculator(M.get(), resourceCostModel, mappingExtractor.extractMapping(asmPath, resourceCostModel));
+    REQUIRE(resourceCostCalculator.getNumResources() == 2);
+    REQUIRE(resourceCostCalculator.getBlockCost(&entry) == 4);
+    REQUIRE(resourceCostCalculator.getBlockCost(&entry, 1) == 20);
+    REQUIRE(resourceCostCalculator.getInstCost(&exit.front(), 1) == 30);
+    REQUIRE(resourceCostCalculator.getBlockCostMap(1).size() == 2);
+
+    // Scheduled cycles replace the first resource only
+    gpscat::IRCostCalculator scheduledCostCalculator(M.get(), resourceCostModel, mappingExtractor.extractMapping(asmPath, resourceCostModel),
+                                                     {0, 1, 1, 0});
+    REQUIRE(scheduledCostCalculator.getBlockCost(&entry) == 1);
+    REQUIRE(scheduledCostCalculator.getBlockCost(&exit) == 1);
+    REQUIRE(scheduledCostCalculator.getBlockCost(&entry, 1) == 20);
+
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove(asmPath);
+}
+
+TEST_CASE("MappingExtractor: tokenizing", "[mappingExtractor]") {
+    std::string costModelPath = gpscat::getTemporaryFilePath("gpscat-test", "cost.csv");
+    std::ofstream(costModelPath) << "Opcode,Cost\nadd,1\n";
+    AssemblyCostModel costModel(costModelPath);
+
+    // Windows line ends, operands that look like opcodes, comments, a
+    // truncated .loc and no newline at the end of the file
+    std::string asmPath = gpscat::getTemporaryFilePath("gpscat-test", "map.s");
+    std::ofstream(asmPath) << "\t.loc\t1 2 0 prologue_end\r\n"
+                              "  add\tadd, add\r\n"
+                              "# add\n"
+                              "\n"
+                              "\t.loc 1\n"
+                              "\tmul add\n"
+                              "\t.loc 1 5\n"
+                              "add";
+
+    MappingExtractor mappingExtractor;
+    gpscat::IRAsmMapping mapping = mappingExtractor.extractMapping(asmPath, costModel);
+    REQUIRE(mapping.getNumIDs() == 6);
+    REQUIRE(mapping.getOpcodes(2).size() == 1);
+    REQUIRE(mapping.getOpcodes(5).size() == 1);
+
+    REQUIRE(mappingExtractor.extractMapping("/nonexistent/map.s", costModel).getNumIDs() == 0);
+
+    llvm::sys::fs::remove(costModelPath);
+    llvm::sys::fs::remove(asmPath);
+}
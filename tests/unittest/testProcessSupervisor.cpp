@@ -0,0 +1,91 @@
+#include "catch.hpp"
+
+#include <gpscat/ProcessSupervisor.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/Support/FileSystem.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using gpscat::ProcessSupervisor;
+
+TEST_CASE("ProcessSupervisor: output and exit code", "[processSupervisor]") {
+    ProcessSupervisor &supervisor = ProcessSupervisor::get();
+    std::string outputPath = gpscat::getTemporaryFilePath("gpscat-test", "out");
+
+    REQUIRE(supervisor.run("/bin/sh", {"-c", "echo hello; exit 3"}, outputPath, 5) == 3);
+
+    std::string line;
+    std::ifstream output(outputPath);
+    std::getline(output, line);
+    REQUIRE(line == "hello");
+
+    REQUIRE(supervisor.run("/nonexistent/program", {}, std::string(), 5) == 127);
+    REQUIRE(supervisor.getNumRunning() == 0);
+
+    // The signals blocked while the child is registered are not blocked in it
+    REQUIRE(supervisor.run("/bin/sh", {"-c", "grep SigBlk /proc/self/status"}, outputPath, 5) == 0);
+    std::ifstream status(outputPath);
+    std::getline(status, line);
+    REQUIRE(line.substr(line.find(':') + 1).find_first_not_of("\t 0") == std::string::npos);
+
+    llvm::sys::fs::remove(outputPath);
+}
+
+TEST_CASE("ProcessSupervisor: timeout and cancellation", "[processSupervisor]") {
+    ProcessSupervisor &supervisor = ProcessSupervisor::get();
+    auto start = std::chrono::steady_clock::now();
+
+    // The whole process group goes, not only the shell
+    REQUIRE(supervisor.run("/bin/sh", {"-c", "sleep 10; sleep 10"}, std::string(), 1) == -1);
+
+    std::atomic<bool> cancelled(false);
+    std::thread canceller([&cancelled]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        cancelled = true;
+    });
+    REQUIRE(supervisor.run("/bin/sleep", {"10"}, std::string(), 0, &cancelled) == -1);
+    canceller.join();
+
+    REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+}
+
+TEST_CASE("ProcessSupervisor: limits", "[processSupervisor]") {
+    ProcessSupervisor &supervisor = ProcessSupervisor::get();
+
+    SECTION("concurrency cap") {
+        supervisor.configure(1, 0, {});
+        auto start = std::chrono::steady_clock::now();
+        std::thread other([&supervisor]() {
+            supervisor.run("/bin/sleep", {"0.3"}, std::string(), 5);
+        });
+        supervisor.run("/bin/sleep", {"0.3"}, std::string(), 5);
+        other.join();
+        REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(600));
+    }
+
+    SECTION("memory budget") {
+        // Nothing would be reserved from the budget
+        REQUIRE(!supervisor.configure(0, 100, {0, 0}));
+
+        REQUIRE(supervisor.configure(0, 100, {64, 0}));
+        auto start = std::chrono::steady_clock::now();
+        std::thread other([&supervisor]() {
+            supervisor.run("/bin/sleep", {"0.3"}, std::string(), 5);
+        });
+        supervisor.run("/bin/sleep", {"0.3"}, std::string(), 5);
+        other.join();
+        REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(600));
+    }
+
+    SECTION("CPU time limit") {
+        supervisor.configure(0, 0, {0, 1});
+        REQUIRE(supervisor.run("/bin/sh", {"-c", "while :; do :; done"}, std::string(), 10) == -1);
+    }
+
+    supervisor.configure(0, 0, {});
+}
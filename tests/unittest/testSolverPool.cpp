@@ -0,0 +1,56 @@
+#include "catch.hpp"
+
+#include <gpscat/SolverPool.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/Support/FileSystem.h>
+
+#include <fstream>
+#include <string>
+
+using gpscat::SolverPool;
+
+// Stands in for a CoFloCo worker: echoes the request back as the bound
+static std::string createFakeWorker() {
+    std::string path = gpscat::getTemporaryFilePath("gpscat-test", "worker.sh");
+    std::ofstream script(path);
+    script << "while read -r line; do\n"
+              "  case \"$line\" in\n"
+              "    crash) exit 1 ;;\n"
+              "    hang) sleep 10 ;;\n"
+              "    fail) echo \"error cannot solve\" ;;\n"
+              "    *) echo \"ok bound($line)\" ;;\n"
+              "  esac\n"
+              "done\n";
+    return path;
+}
+
+TEST_CASE("SolverPool: answers queries", "[solverPool]") {
+    std::string worker = createFakeWorker();
+    SolverPool pool("sh", {worker}, 2, 5);
+
+    REQUIRE(pool.solve("a.ces") == "bound(a.ces)");
+    REQUIRE(pool.solve("b.ces") == "bound(b.ces)");
+    REQUIRE(pool.solve("fail") == "");
+    REQUIRE(pool.getNumRecycledWorkers() == 0);
+
+    // The options of a query follow its path
+    REQUIRE(pool.solve("a.ces", 0, {"-solve_fast", "-compute_lbs"}) == "bound(a.ces\t-solve_fast\t-compute_lbs)");
+
+    llvm::sys::fs::remove(worker);
+}
+
+TEST_CASE("SolverPool: recycles crashed and stuck workers", "[solverPool]") {
+    std::string worker = createFakeWorker();
+    SolverPool pool("sh", {worker}, 1, 1);
+
+    REQUIRE(pool.solve("crash") == "");
+    REQUIRE(pool.getNumRecycledWorkers() == 1);
+    REQUIRE(pool.solve("a.ces") == "bound(a.ces)");
+
+    REQUIRE(pool.solve("hang") == "");
+    REQUIRE(pool.getNumRecycledWorkers() == 2);
+    REQUIRE(pool.solve("b.ces") == "bound(b.ces)");
+
+    llvm::sys::fs::remove(worker);
+}
@@ -0,0 +1,33 @@
+#include "catch.hpp"
+
+#include <gpscat/TargetInstructions.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+TEST_CASE("TargetInstructions: mnemonics", "[targetInstructions]") {
+    REQUIRE(gpscat::getMnemonic("addl %eax, %eax") == "addl");
+    REQUIRE(gpscat::getMnemonic("\tmovl\t%edi, %eax") == "movl");
+    REQUIRE(gpscat::getMnemonic("ret") == "ret");
+    REQUIRE(gpscat::getMnemonic("  ").empty());
+}
+
+TEST_CASE("TargetInstructions: isolated children", "[targetInstructions]") {
+    // The child dies at 2 and 3, a new one continues each time
+    std::vector<std::string> lines = gpscat::runIsolated(6, [](std::size_t i) {
+        if(i == 2 || i == 3)
+            std::abort();
+        return std::to_string(i * i);
+    });
+    REQUIRE(lines == std::vector<std::string>{"0", "1", "", "", "16", "25"});
+
+    REQUIRE(gpscat::runIsolated(0, [](std::size_t) { return std::string("x"); }).empty());
+
+    // A call that hangs is given up like one that crashes
+    lines = gpscat::runIsolated(3, [](std::size_t i) {
+        while(i == 1) {}
+        return std::to_string(i);
+    }, 1);
+    REQUIRE(lines == std::vector<std::string>{"0", "", "2"});
+}
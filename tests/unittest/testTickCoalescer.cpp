@@ -0,0 +1,98 @@
+#include "catch.hpp"
+
+#include <gpscat/TickCoalescer.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <memory>
+#include <string>
+
+using gpscat::TickCoalescer;
+using gpscat::BlockCostMapType;
+
+static llvm::BasicBlock *getBlock(llvm::Module *M, const std::string &name) {
+    for(auto &&BB : *M->getFunction("f"))
+        if(BB.getName() == name)
+            return &BB;
+    return nullptr;
+}
+
+static gpscat::CostTy costOf(const BlockCostMapType &costs, llvm::BasicBlock *BB) {
+    auto it = costs.find(BB);
+    return it == costs.end() ? 0 : it->second;
+}
+
+TEST_CASE("TickCoalescer: straight-line chain", "[tickCoalescer]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(
+        "define void @f() {\n"
+        "a:\n  br label %b\n"
+        "b:\n  br label %c\n"
+        "c:\n  ret void\n"
+        "}\n", err, context);
+    REQUIRE(M);
+
+    BlockCostMapType costs = {{getBlock(M.get(), "a"), 1}, {getBlock(M.get(), "b"), 2}, {getBlock(M.get(), "c"), 3}};
+    auto coalesced = TickCoalescer().run(M.get(), costs);
+
+    REQUIRE(coalesced.size() == 1);
+    REQUIRE(costOf(coalesced, getBlock(M.get(), "a")) == 6);
+}
+
+TEST_CASE("TickCoalescer: branch arms", "[tickCoalescer]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(
+        "define void @f(i1 %c) {\n"
+        "a:\n  br i1 %c, label %t, label %e\n"
+        "t:\n  br label %j\n"
+        "e:\n  br label %j\n"
+        "j:\n  ret void\n"
+        "}\n", err, context);
+    REQUIRE(M);
+
+    SECTION("equal arms are folded into the branch") {
+        BlockCostMapType costs = {{getBlock(M.get(), "t"), 4}, {getBlock(M.get(), "e"), 4}, {getBlock(M.get(), "j"), 1}};
+        auto coalesced = TickCoalescer().run(M.get(), costs);
+
+        REQUIRE(costOf(coalesced, getBlock(M.get(), "a")) == 4);
+        REQUIRE(costOf(coalesced, getBlock(M.get(), "t")) == 0);
+        REQUIRE(costOf(coalesced, getBlock(M.get(), "e")) == 0);
+        REQUIRE(costOf(coalesced, getBlock(M.get(), "j")) == 1);
+    }
+
+    SECTION("unequal arms are kept") {
+        BlockCostMapType costs = {{getBlock(M.get(), "t"), 4}, {getBlock(M.get(), "e"), 5}};
+        auto coalesced = TickCoalescer().run(M.get(), costs);
+
+        REQUIRE(costOf(coalesced, getBlock(M.get(), "a")) == 0);
+        REQUIRE(costOf(coalesced, getBlock(M.get(), "t")) == 4);
+        REQUIRE(costOf(coalesced, getBlock(M.get(), "e")) == 5);
+    }
+}
+
+TEST_CASE("TickCoalescer: loop header", "[tickCoalescer]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(
+        "define void @f(i32 %n) {\n"
+        "entry:\n  br label %header\n"
+        "header:\n  %i = phi i32 [ 0, %entry ], [ %inc, %latch ]\n  br label %body\n"
+        "body:\n  %inc = add i32 %i, 1\n  %c = icmp slt i32 %inc, %n\n  br i1 %c, label %latch, label %exit\n"
+        "latch:\n  br label %header\n"
+        "exit:\n  ret void\n"
+        "}\n", err, context);
+    REQUIRE(M);
+
+    BlockCostMapType costs = {{getBlock(M.get(), "header"), 1}, {getBlock(M.get(), "body"), 2}, {getBlock(M.get(), "latch"), 3}};
+    auto coalesced = TickCoalescer().run(M.get(), costs);
+
+    // The latch runs one time less than the header, so it must stay
+    REQUIRE(costOf(coalesced, getBlock(M.get(), "header")) == 3);
+    REQUIRE(costOf(coalesced, getBlock(M.get(), "body")) == 0);
+    REQUIRE(costOf(coalesced, getBlock(M.get(), "latch")) == 3);
+}
@@ -0,0 +1,76 @@
+#!/usr/bin/env swipl
+% Solver worker for -solver-worker: loads CoFloCo once and then answers
+% one query per line, so that starting Prolog and loading CoFloCo is paid
+% once per worker instead of once per query. The protocol is the one of
+% SolverPool:
+%
+%   request:  <path of the cost equation system>[\t<argument>]...
+%   response: ok <cost upper bound>
+%             error <message>
+%
+% CoFloCo is loaded from $COFLOCO_HOME/src/main_cofloco.pl. The arguments
+% of a request, such as -solve_fast or -compute_lbs yes, and then those of
+% the worker are added to the query, as they would be on the command line
+% of cofloco.
+
+:- initialization(main, main).
+
+main(Args) :-
+    (   getenv('COFLOCO_HOME', Home)
+    ->  true
+    ;   format(user_error, "COFLOCO_HOME is not set~n", []),
+        halt(1)
+    ),
+    atomic_list_concat([Home, '/src/main_cofloco'], MainFile),
+    use_module(MainFile),
+    serve(Args).
+
+serve(Args) :-
+    read_line_to_string(user_input, Line),
+    (   Line == end_of_file
+    ->  true
+    ;   answer(Line, Args),
+        serve(Args)
+    ).
+
+answer(Line, Args) :-
+    split_string(Line, "\t", "", [Path|QueryArgs]),
+    maplist(atom_string, QueryAtoms, QueryArgs),
+    append(QueryAtoms, Args, AllArgs),
+    catch(solve(Path, AllArgs, Response), Error, error_response(Error, Response)),
+    (   Response = ok(Bound)
+    ->  format("ok ~s~n", [Bound])
+    ;   Response = error(Message),
+        format("error ~s~n", [Message])
+    ),
+    flush_output.
+
+% Whatever CoFloCo prints is kept off the protocol channel, only the bound
+% is taken from it
+solve(Path, Args, Response) :-
+    append(['-i', Path, '-v', '0'], Args, Query),
+    with_output_to(string(Output), once(main_cofloco:cofloco_query(Query))),
+    !,
+    (   maximum_cost(Output, Bound)
+    ->  Response = ok(Bound)
+    ;   Response = error("no bound in the output of CoFloCo")
+    ).
+solve(_, _, error("CoFloCo failed")).
+
+% The line cofloco prints as
+%   ### Maximum cost of func(arg0, arg1, ...): <bound>
+maximum_cost(Output, Bound) :-
+    split_string(Output, "\n", "", Lines),
+    member(Line, Lines),
+    string_concat("### Maximum cost", _, Line),
+    sub_string(Line, Colon, _, _, ":"),
+    !,
+    Start is Colon + 2,
+    sub_string(Line, Start, _, 0, Bound).
+
+% The message must stay on one line
+error_response(Error, error(Message)) :-
+    term_string(Error, Text),
+    split_string(Text, "\n", "", Parts),
+    atomic_list_concat(Parts, ' ', Atom),
+    atom_string(Atom, Message).
@@ -0,0 +1,418 @@
+// Measures a cost model for gpscat-cost on the processor it runs on.
+// Every instruction that neither touches memory nor leaves the straight
+// line is repeated in small kernels, which are timed with the cycle
+// counter of the processor, and the costs are fitted to the timings by
+// least squares. Opcodes are keyed by the mnemonic llc prints for them.
+
+#include <gpscat/CostFit.h>
+#include <gpscat/TargetInstructions.h>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/MC/MCAsmInfo.h>
+#include <llvm/MC/MCCodeEmitter.h>
+#include <llvm/MC/MCContext.h>
+#include <llvm/MC/MCFixup.h>
+#include <llvm/MC/MCInstPrinter.h>
+#include <llvm/MC/MCInstrDesc.h>
+#include <llvm/MC/MCInstrInfo.h>
+#include <llvm/MC/MCObjectFileInfo.h>
+#include <llvm/MC/MCParser/MCAsmParser.h>
+#include <llvm/MC/MCParser/MCTargetAsmParser.h>
+#include <llvm/MC/MCRegisterInfo.h>
+#include <llvm/MC/MCStreamer.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/MC/MCTargetOptions.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/Memory.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetRegistry.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static llvm::cl::opt<std::string> outputFilename("o", llvm::cl::desc("Output cost model csv file"), llvm::cl::init("-"));
+static llvm::cl::opt<std::string> intervalsFilename("intervals", llvm::cl::desc("Also write the fitted costs with their 95% confidence intervals to this csv file"),
+                                                    llvm::cl::init(std::string()));
+static llvm::cl::opt<std::string> counter("counter", llvm::cl::desc("What is measured: cycles, from the performance counters, or nanoseconds"), llvm::cl::init("cycles"));
+static llvm::cl::opt<std::string> pairsFrom("pairs-from", llvm::cl::desc("Also measure the mnemonic pairs that follow each other most often in this llc assembly file"),
+                                            llvm::cl::init(std::string()));
+static llvm::cl::opt<unsigned int> numPairs("num-pairs", llvm::cl::desc("Number of pairs measured with -pairs-from"), llvm::cl::init(32));
+static llvm::cl::list<std::string> only("only", llvm::cl::desc("Measure only these mnemonics"), llvm::cl::CommaSeparated);
+static llvm::cl::opt<std::string> returnText("return", llvm::cl::desc("Return instruction ending each kernel"), llvm::cl::init("ret"));
+static llvm::cl::opt<unsigned int> repetitions("repetitions", llvm::cl::desc("Measurements of each kernel length"), llvm::cl::init(5));
+static llvm::cl::opt<unsigned int> calls("calls", llvm::cl::desc("Calls of a kernel per measurement"), llvm::cl::init(1000));
+static llvm::cl::opt<unsigned int> kernelTimeout("kernel-timeout", llvm::cl::desc("Time limit in seconds of measuring one kernel, after which it is dropped (0 for none)"), llvm::cl::init(60));
+static llvm::cl::opt<unsigned int> scale("scale", llvm::cl::desc("Factor applied to the measured costs before rounding them to integers"), llvm::cl::init(1));
+static llvm::cl::opt<unsigned int> verbosity("verbose", llvm::cl::desc("Verbosity"), llvm::cl::init(0));
+
+namespace {
+
+// Copies of the instruction in each kernel. The slope over the lengths is
+// the cost, the calls and returns are the intercept.
+const unsigned int kernelLengths[] = {8, 16, 32, 64};
+
+// Collects the instructions of parsed assembly
+class InstCollector final : public llvm::MCStreamer {
+public:
+    explicit InstCollector(llvm::MCContext &context) : llvm::MCStreamer(context) {}
+
+    void EmitInstruction(const llvm::MCInst &inst, const llvm::MCSubtargetInfo &, bool) override {
+        insts.push_back(inst);
+    }
+    bool EmitSymbolAttribute(llvm::MCSymbol *, llvm::MCSymbolAttr) override {
+        return true;
+    }
+    void EmitCommonSymbol(llvm::MCSymbol *, std::uint64_t, unsigned) override {}
+    void EmitZerofill(llvm::MCSection *, llvm::MCSymbol *, std::uint64_t, unsigned, llvm::SMLoc) override {}
+
+    std::vector<llvm::MCInst> insts;
+};
+
+int openCycleCounter() {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+std::uint64_t readCounter() {
+    if(counter == "nanoseconds")
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    // Opened by each measuring process for itself
+    static int fd = openCycleCounter();
+    std::uint64_t count = 0;
+    if(read(fd, &count, sizeof(count)) != sizeof(count))
+        return 0;
+    return count;
+}
+
+// Cost per call of the code, which must end with a return
+double measure(const std::vector<char> &code) {
+    std::error_code ec;
+    llvm::sys::MemoryBlock block = llvm::sys::Memory::allocateMappedMemory(code.size(), nullptr, llvm::sys::Memory::MF_READ | llvm::sys::Memory::MF_WRITE, ec);
+    if(ec)
+        return -1;
+    std::memcpy(block.base(), code.data(), code.size());
+    if(llvm::sys::Memory::protectMappedMemory(block, llvm::sys::Memory::MF_READ | llvm::sys::Memory::MF_EXEC)) {
+        llvm::sys::Memory::releaseMappedMemory(block);
+        return -1;
+    }
+    llvm::sys::Memory::InvalidateInstructionCache(block.base(), code.size());
+
+    auto kernel = reinterpret_cast<void (*)()>(block.base());
+    kernel();
+    std::uint64_t start = readCounter();
+    for(unsigned int i = 0; i < calls; ++i)
+        kernel();
+    std::uint64_t end = readCounter();
+
+    llvm::sys::Memory::releaseMappedMemory(block);
+    return static_cast<double>(end - start) / calls;
+}
+
+// The first token of every instruction line of llc output
+std::vector<std::string> readMnemonics(const std::string &path) {
+    std::vector<std::string> mnemonics;
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(path);
+    if(!buffer) {
+        std::cerr << "Cannot read " << path << ": " << buffer.getError().message() << std::endl;
+        return mnemonics;
+    }
+    llvm::SmallVector<llvm::StringRef, 0> lines;
+    (*buffer)->getBuffer().split(lines, '\n');
+    for(llvm::StringRef line : lines) {
+        llvm::StringRef first = gpscat::getMnemonic(line);
+        if(!first.empty() && !first.startswith(".") && !first.startswith("#") && !first.endswith(":"))
+            mnemonics.push_back(first.str());
+    }
+    return mnemonics;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[]) {
+    llvm::cl::ParseCommandLineOptions(argc, argv);
+
+    if(counter != "cycles" && counter != "nanoseconds") {
+        std::cerr << "-counter must be cycles or nanoseconds" << std::endl;
+        return 1;
+    }
+    if(counter == "cycles") {
+        int fd = openCycleCounter();
+        if(fd < 0) {
+            std::cerr << "The cycle counter is not available, use -counter=nanoseconds" << std::endl;
+            return 1;
+        }
+        close(fd);
+    }
+
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmParser();
+
+    // The kernels run here, so the target is this processor with all of
+    // its features
+    llvm::Triple triple(llvm::sys::getProcessTriple());
+    std::string error;
+    const llvm::Target *target = llvm::TargetRegistry::lookupTarget(triple.getTriple(), error);
+    if(!target) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    std::string features;
+    llvm::StringMap<bool> hostFeatures;
+    if(llvm::sys::getHostCPUFeatures(hostFeatures))
+        for(const auto &feature : hostFeatures)
+            features += (feature.second ? "+" : "-") + feature.first().str() + ",";
+
+    std::unique_ptr<llvm::MCRegisterInfo> MRI(target->createMCRegInfo(triple.getTriple()));
+    std::unique_ptr<llvm::MCAsmInfo> MAI(MRI ? target->createMCAsmInfo(*MRI, triple.getTriple()) : nullptr);
+    std::unique_ptr<llvm::MCInstrInfo> MII(target->createMCInstrInfo());
+    std::unique_ptr<llvm::MCSubtargetInfo> STI(target->createMCSubtargetInfo(triple.getTriple(), llvm::sys::getHostCPUName(), features));
+    if(!MRI || !MAI || !MII || !STI) {
+        std::cerr << "Target " << triple.getTriple() << " has no machine code support." << std::endl;
+        return 1;
+    }
+    std::unique_ptr<llvm::MCInstPrinter> printer(target->createMCInstPrinter(triple, MAI->getAssemblerDialect(), *MAI, *MII, *MRI));
+
+    llvm::SourceMgr sourceMgr;
+    llvm::MCObjectFileInfo MOFI;
+    llvm::MCContext context(MAI.get(), MRI.get(), &MOFI, &sourceMgr);
+    MOFI.InitMCObjectFileInfo(triple, false, context);
+    std::unique_ptr<llvm::MCCodeEmitter> emitter(target->createMCCodeEmitter(*MII, *MRI, context));
+    if(!printer || !emitter) {
+        std::cerr << "Target " << triple.getTriple() << " cannot print or encode instructions." << std::endl;
+        return 1;
+    }
+
+    auto encode = [&](const llvm::MCInst &inst, std::vector<char> &code) -> bool {
+        llvm::SmallVector<char, 16> bytes;
+        llvm::raw_svector_ostream os(bytes);
+        llvm::SmallVector<llvm::MCFixup, 4> fixups;
+        emitter->encodeInstruction(inst, os, fixups, *STI);
+        // Anything that needs relocating is not straight-line code
+        if(!fixups.empty() || bytes.empty())
+            return false;
+        code.insert(code.end(), bytes.begin(), bytes.end());
+        return true;
+    };
+
+    // The return is parsed, as its operands are not placeholders
+    std::vector<char> returnCode;
+    {
+        sourceMgr.AddNewSourceBuffer(llvm::MemoryBuffer::getMemBufferCopy("\t" + returnText + "\n"), llvm::SMLoc());
+        InstCollector collector(context);
+        std::unique_ptr<llvm::MCAsmParser> parser(llvm::createMCAsmParser(sourceMgr, context, collector, *MAI));
+        llvm::MCTargetOptions targetOptions;
+        std::unique_ptr<llvm::MCTargetAsmParser> targetParser(target->createMCAsmParser(*STI, *parser, *MII, targetOptions));
+        if(targetParser)
+            parser->setTargetParser(*targetParser);
+        if(!targetParser || parser->Run(false) || collector.insts.size() != 1 || !encode(collector.insts.front(), returnCode)) {
+            std::cerr << "Cannot encode the return instruction \"" << returnText << "\", choose another one with -return." << std::endl;
+            return 1;
+        }
+    }
+
+    // Instructions that touch memory, leave the straight line or have
+    // other side effects cannot be repeated safely
+    std::vector<unsigned int> opcodes;
+    for(unsigned int opcode = 0; opcode < MII->getNumOpcodes(); ++opcode) {
+        const llvm::MCInstrDesc &desc = MII->get(opcode);
+        if(desc.isPseudo() || desc.mayLoad() || desc.mayStore() || desc.isTerminator() || desc.isCall()
+           || desc.isBarrier() || desc.hasUnmodeledSideEffects())
+            continue;
+        opcodes.push_back(opcode);
+    }
+
+    std::vector<std::string> texts = gpscat::runIsolated(opcodes.size(), [&](std::size_t i) {
+        return gpscat::printInstruction(gpscat::createPlaceholder(opcodes[i], *MII, *MRI), *printer, *STI);
+    });
+
+    std::set<std::string> onlyMnemonics(only.begin(), only.end());
+    std::vector<std::string> mnemonicNames;
+    std::map<std::string, std::size_t> mnemonicIndices;
+    struct Form {
+        std::size_t mnemonic;
+        std::string text;
+        std::vector<char> code;
+    };
+    std::vector<Form> forms;
+    for(std::size_t i = 0; i < opcodes.size(); ++i) {
+        std::string mnemonic = gpscat::getMnemonic(texts[i]).str();
+        if(mnemonic.empty() || mnemonic[0] == '#' || mnemonic.find_first_of(",\"") != std::string::npos)
+            continue;
+        if(!onlyMnemonics.empty() && !onlyMnemonics.count(mnemonic))
+            continue;
+
+        Form form;
+        form.text = texts[i];
+        if(!encode(gpscat::createPlaceholder(opcodes[i], *MII, *MRI), form.code))
+            continue;
+        auto inserted = mnemonicIndices.emplace(mnemonic, mnemonicNames.size());
+        if(inserted.second)
+            mnemonicNames.push_back(mnemonic);
+        form.mnemonic = inserted.first->second;
+        forms.push_back(std::move(form));
+    }
+
+    // Pairs are kernels of two alternating instructions
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    if(!pairsFrom.empty()) {
+        std::map<std::pair<std::string, std::string>, unsigned int> pairCounts;
+        std::vector<std::string> sequence = readMnemonics(pairsFrom);
+        for(std::size_t i = 1; i < sequence.size(); ++i)
+            if(mnemonicIndices.count(sequence[i - 1]) && mnemonicIndices.count(sequence[i]))
+                ++pairCounts[{sequence[i - 1], sequence[i]}];
+
+        std::vector<std::pair<unsigned int, std::pair<std::string, std::string>>> byCount;
+        for(const auto &pairCount : pairCounts)
+            byCount.push_back({pairCount.second, pairCount.first});
+        std::sort(byCount.rbegin(), byCount.rend());
+        for(std::size_t i = 0; i < byCount.size() && i < numPairs; ++i)
+            pairs.push_back({mnemonicIndices[byCount[i].second.first], mnemonicIndices[byCount[i].second.second]});
+    }
+
+    if(verbosity >= 1)
+        std::cerr << "Measuring " << forms.size() << " instructions of " << mnemonicNames.size() << " mnemonics and " << pairs.size() << " pairs." << std::endl;
+
+    // A kernel is the code of some forms repeated, and the return. Each
+    // is measured at every length, as often as -repetitions asks.
+    std::vector<std::vector<std::size_t>> kernels;
+    // Every kernel runs in a child of its own: one that faults only kills
+    // that child, and one that changes registers the caller relies on
+    // cannot spoil the measurements of the next
+    auto measureKernels = [&](std::size_t firstKernel) {
+        std::vector<std::string> lines;
+        for(std::size_t kernel = firstKernel; kernel < kernels.size(); ++kernel) {
+            lines.push_back(gpscat::runIsolated(1, [&](std::size_t) {
+                std::ostringstream line;
+                for(unsigned int repetition = 0; repetition < repetitions; ++repetition) {
+                    for(unsigned int length : kernelLengths) {
+                        std::vector<char> code;
+                        for(unsigned int copy = 0; copy < length; ++copy)
+                            for(std::size_t form : kernels[kernel])
+                                code.insert(code.end(), forms[form].code.begin(), forms[form].code.end());
+                        code.insert(code.end(), returnCode.begin(), returnCode.end());
+                        line << length << ' ' << measure(code) << ' ';
+                    }
+                }
+                return line.str();
+            }, kernelTimeout).front());
+        }
+        return lines;
+    };
+
+    for(std::size_t i = 0; i < forms.size(); ++i)
+        kernels.push_back({i});
+    std::vector<std::string> results = measureKernels(0);
+
+    // Pairs use the first form of each mnemonic that could be measured
+    std::vector<std::size_t> firstForm(mnemonicNames.size(), forms.size());
+    for(std::size_t i = forms.size(); i-- > 0;)
+        if(!results[i].empty())
+            firstForm[forms[i].mnemonic] = i;
+    for(const auto &pair : pairs) {
+        std::size_t first = firstForm[pair.first], second = firstForm[pair.second];
+        if(first < forms.size() && second < forms.size())
+            kernels.push_back({first, second});
+    }
+    std::vector<std::string> pairResults = measureKernels(forms.size());
+    results.insert(results.end(), pairResults.begin(), pairResults.end());
+
+    // Least squares over all kernels: the cost per call is a shared
+    // intercept plus the copies of each mnemonic times its cost
+    std::vector<gpscat::CostObservation> observations;
+    for(std::size_t i = 0; i < kernels.size(); ++i) {
+        if(results[i].empty()) {
+            if(verbosity >= 1 && i < forms.size())
+                std::cerr << "Cannot run " << forms[i].text << std::endl;
+            continue;
+        }
+        std::istringstream line(results[i]);
+        unsigned int length;
+        double value;
+        while(line >> length >> value) {
+            if(value < 0)
+                continue;
+            gpscat::CostObservation observation;
+            observation.value = value;
+            observation.counts.push_back({0, 1});
+            for(std::size_t form : kernels[i])
+                observation.counts.push_back({forms[form].mnemonic + 1, length});
+            observations.push_back(std::move(observation));
+        }
+    }
+
+    gpscat::CostFit fit;
+    if(!gpscat::fitCosts(observations, mnemonicNames.size() + 1, fit)) {
+        std::cerr << "Too few measurements to fit the costs." << std::endl;
+        return 1;
+    }
+
+    std::error_code ec;
+    llvm::raw_fd_ostream output(outputFilename, ec, llvm::sys::fs::F_Text);
+    if(ec) {
+        std::cerr << "Cannot write " << outputFilename << ": " << ec.message() << std::endl;
+        return 1;
+    }
+    std::unique_ptr<llvm::raw_fd_ostream> intervals;
+    if(!intervalsFilename.empty()) {
+        intervals = std::make_unique<llvm::raw_fd_ostream>(intervalsFilename, ec, llvm::sys::fs::F_Text);
+        if(ec) {
+            std::cerr << "Cannot write " << intervalsFilename << ": " << ec.message() << std::endl;
+            return 1;
+        }
+        *intervals << "Opcode,Cost,Low,High\n";
+    }
+
+    // In the order costgen writes them
+    std::map<std::string, std::size_t> sorted(mnemonicIndices.begin(), mnemonicIndices.end());
+    output << "Opcode,Cost\n";
+    std::size_t numWritten = 0;
+    for(const auto &[mnemonic, index] : sorted) {
+        if(!fit.observed[index + 1]) {
+            std::cerr << "No measurement for " << mnemonic << ", it is left out" << std::endl;
+            continue;
+        }
+        double cost = fit.costs[index + 1] * scale;
+        output << mnemonic << ',' << std::llround(std::max(0.0, cost)) << '\n';
+        ++numWritten;
+
+        if(intervals) {
+            double halfWidth = fit.halfWidths[index + 1] * scale;
+            *intervals << mnemonic << ',' << llvm::format("%.3f,%.3f,%.3f", cost, cost - halfWidth, cost + halfWidth) << '\n';
+        }
+    }
+
+    if(verbosity >= 1 || numWritten == 0)
+        std::cerr << numWritten << " mnemonics written, " << sorted.size() - numWritten << " without measurements left out, the calls cost "
+                  << fit.costs[0] << ' ' << counter << " each." << std::endl;
+    return numWritten == 0 ? 1 : 0;
+}
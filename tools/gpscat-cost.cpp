@@ -1,182 +1,271 @@
+#include <gpscat/Analyzer.h>
 #include <gpscat/AssemblyCostModel.h>
-#include <gpscat/IRLocator.h>
-#include <gpscat/MappingExtractor.h>
-#include <gpscat/IRCostCalculator.h>
 #include <gpscat/CoFloCoWrapper.h>
-#include <gpscat/Utils.h>
+#include <gpscat/AnalysisResult.h>
+#include <gpscat/ProcessSupervisor.h>
+#include <gpscat/IncrementalAnalyzer.h>
+#include <gpscat/BatchAnalyzer.h>
 
 #include <llvm/Support/CommandLine.h>
 #include <llvm/IRReader/IRReader.h>
-#include <llvm/Support/Program.h>
 #include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/FileSystem.h>
 
 #include <symengine/expression.h>
 
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <string>
 #include <system_error>
 #include <cassert>
+#include <thread>
+#include <chrono>
 
-static llvm::cl::opt<std::string> costModelFilename(llvm::cl::Positional, llvm::cl::desc("<cost model csv file>"), llvm::cl::Required);
+static llvm::cl::opt<std::string> costModelFilename(llvm::cl::Positional, llvm::cl::desc("<cost model csv file, or builtin:<name>>"), llvm::cl::Required);
 static llvm::cl::opt<std::string> inputFilename(llvm::cl::Positional, llvm::cl::desc("<input bitcode file>"), llvm::cl::init("-"));
 static llvm::cl::opt<std::string> arch("arch", llvm::cl::desc("Target assembly language"), llvm::cl::init("wasm32"));
+static llvm::cl::opt<std::string> cpu("mcpu", llvm::cl::desc("Target processor, passed to llc and used by -schedule-blocks"), llvm::cl::init(std::string()));
+static llvm::cl::opt<bool> scheduleBlocks("schedule-blocks", llvm::cl::desc("Cost blocks by the cycles per iteration of a simulated out-of-order pipeline of -mcpu instead of summing the cost model"));
 static llvm::cl::opt<bool> keepTemporaryFiles("keep-temporary-files", llvm::cl::desc("Don't remove the temporary files when analyzing cost"));
 static llvm::cl::opt<int> verbosity("verbose", llvm::cl::desc("verbosity level (0, 1, 2)"), llvm::cl::init(0));
 static llvm::cl::opt<std::string> optLevel("O", llvm::cl::Prefix, llvm::cl::desc("Optimization level for llc"), llvm::cl::init("2"));
+static llvm::cl::opt<unsigned int> numInlines("inline", llvm::cl::desc("Maximum number of function inline steps"), llvm::cl::init(0));
+static llvm::cl::opt<bool> eagerInline("eager-inline", llvm::cl::desc("Exhaustively inline (acyclic call hierarchies only)"));
+static llvm::cl::opt<std::string> functionName("function", llvm::cl::desc("Entry function for the cost analysis"), llvm::cl::init(std::string()));
+static llvm::cl::opt<std::string> solverWorker("solver-worker", llvm::cl::desc("Solve with persistent worker processes running this program instead of starting cofloco for every query"), llvm::cl::init(std::string()));
+static llvm::cl::opt<unsigned int> numSolverWorkers("solver-workers", llvm::cl::desc("Number of persistent solver worker processes"), llvm::cl::init(1));
 static llvm::cl::opt<bool> removeNat("remove-nat", llvm::cl::desc("Remove all occurrences of nat(x) (Can lead to incorrect upperbounds)"));
 static llvm::cl::opt<bool> replaceNat("replace-nat", llvm::cl::desc("Replace all nat(x) with max([x,0])"));
+static llvm::cl::opt<bool> coalesceTicks("coalesce-ticks", llvm::cl::desc("Move block costs onto fewer blocks before extracting the cost relation system"));
+static llvm::cl::opt<bool> sliceControl("slice-control", llvm::cl::desc("Drop computations that influence neither control flow nor call arguments before extracting the cost relation system"));
+static llvm::cl::opt<unsigned int> componentJobs("component-jobs", llvm::cl::desc("Solve the loops of the cost relation system separately, using up to N concurrent CoFloCo processes (0 solves the whole system at once)"), llvm::cl::init(0));
+static llvm::cl::opt<bool> portfolio("portfolio", llvm::cl::desc("Race several llvm2kittel/CoFloCo configurations and keep the first finite bound"));
+static llvm::cl::opt<bool> portfolioBest("portfolio-best", llvm::cl::desc("With -portfolio, wait for every configuration and keep the tightest bound"));
+static llvm::cl::opt<unsigned int> portfolioTimeout("portfolio-timeout", llvm::cl::desc("Time budget in seconds of each configuration in the portfolio"), llvm::cl::init(60));
+static llvm::cl::opt<bool> compositional("compositional", llvm::cl::desc("Solve every function once, bottom-up along the call graph, and charge calls with the bound of the callee instead of inlining"));
+static llvm::cl::opt<unsigned int> compositionalJobs("compositional-jobs", llvm::cl::desc("Number of functions solved concurrently with -compositional"),
+                                                     llvm::cl::init(std::thread::hardware_concurrency()));
+static llvm::cl::opt<bool> allFunctions("all-functions", llvm::cl::desc("Solve the bound of every externally visible function and print them as a table"));
+static llvm::cl::opt<unsigned int> functionJobs("function-jobs", llvm::cl::desc("Number of functions solved concurrently with -all-functions"),
+                                                llvm::cl::init(std::thread::hardware_concurrency()));
 static llvm::cl::opt<bool> symengineFormat("symengine-format", llvm::cl::desc("Print the upperbound in SynEngine format"));
+static llvm::cl::opt<unsigned int> deadlineSeconds("deadline", llvm::cl::desc("Time budget in seconds for the whole analysis (0 for none)"), llvm::cl::init(0));
+static llvm::cl::opt<unsigned int> maxChildren("max-children", llvm::cl::desc("Maximum number of external tools running at once (0 for unlimited)"),
+                                               llvm::cl::init(std::thread::hardware_concurrency()));
+static llvm::cl::opt<unsigned int> memoryBudget("memory-budget", llvm::cl::desc("Total memory in MB the external tools may reserve, each its -child-memory-limit (0 for unlimited)"), llvm::cl::init(0));
+static llvm::cl::opt<unsigned int> childMemoryLimit("child-memory-limit", llvm::cl::desc("Address space limit in MB of each external tool (0 for unlimited)"), llvm::cl::init(0));
+static llvm::cl::opt<unsigned int> childCPULimit("child-cpu-limit", llvm::cl::desc("CPU time limit in seconds of each external tool (0 for unlimited)"), llvm::cl::init(0));
+static llvm::cl::opt<std::string> cacheDir("cache-dir", llvm::cl::desc("Reuse the block costs and bounds of unchanged functions stored in this directory, and store new ones there"), llvm::cl::init(std::string()));
+static llvm::cl::opt<unsigned int> cacheSize("cache-size", llvm::cl::desc("Size limit in MB of the cache directory"), llvm::cl::init(1024));
+static llvm::cl::opt<bool> watch("watch", llvm::cl::desc("Keep running and analyze the input file again whenever it changes, recompiling and solving only what the changes affect"));
+static llvm::cl::opt<std::string> batchManifest("batch", llvm::cl::desc("Analyze every bitcode file listed in this manifest, one path per line, instead of the input file"), llvm::cl::init(std::string()));
+static llvm::cl::opt<std::string> journalPath("journal", llvm::cl::desc("Journal of the results of -batch inputs; inputs with a complete result are skipped when the batch is run again (default: <manifest>.journal)"), llvm::cl::init(std::string()));
+static llvm::cl::opt<unsigned int> batchJobs("batch-jobs", llvm::cl::desc("Number of -batch inputs analyzed concurrently"),
+                                             llvm::cl::init(std::thread::hardware_concurrency()));
+static llvm::cl::opt<bool> jsonOutput("json", llvm::cl::desc("Print the result as JSON, including block costs and partial results"));
+static llvm::cl::opt<std::string> sourceProfile("source-profile", llvm::cl::desc("Write the instruction costs per source line of the input's debug info to this file, as collapsed stacks for flame graph tools"), llvm::cl::init(std::string()));
 
 using namespace std::literals;
 
-int main(int argc, char *argv[]) {
-    llvm::cl::ParseCommandLineOptions(argc, argv);
+// -inline, -eager-inline, -function and the solver workers
+static gpscat::SolverConfiguration getSolverConfiguration() {
+    gpscat::SolverConfiguration configuration;
+    configuration.numInlines = numInlines;
+    configuration.eagerInline = eagerInline;
+    configuration.functionName = functionName;
+    configuration.solverWorker = solverWorker;
+    configuration.numSolverWorkers = numSolverWorkers;
+    return configuration;
+}
 
-    // Read bitcode file
-    if(verbosity >= 1) std::cout << "Reading input bitcode file." << std::endl;
+// -remove-nat, -replace-nat and -symengine-format
+static std::string formatBound(std::string costUpperBound) {
+    gpscat::CoFloCoWrapper coflocoWrapper;
+    if(removeNat) costUpperBound = coflocoWrapper.removeNat(costUpperBound);
+    if(replaceNat) costUpperBound = coflocoWrapper.replaceNatWithMax(costUpperBound);
 
-    llvm::LLVMContext context;
-    llvm::SMDiagnostic err;
-    std::unique_ptr<llvm::Module> module = parseIRFile(inputFilename, err, context);
+    if(symengineFormat) {
+        SymEngine::Expression symUpperBound(costUpperBound);
+        costUpperBound = expand(symUpperBound).get_basic()->__str__();
+    }
+    return costUpperBound;
+}
 
-    if(!module) {
-        err.print(argv[0], llvm::errs());
-        return 1;
+static void printResult(const gpscat::AnalysisResult &result) {
+    if(jsonOutput) {
+        std::cout << result.toJSON() << std::endl;
+    }
+    else if(allFunctions) {
+        if(verbosity >= 1) std::cout << "\nThe inferred cost upperbounds are" << std::endl;
+        for(const auto &functionCost : result.functionCosts)
+            std::cout << functionCost.name << '\t' << (functionCost.bound.empty() ? "none" : functionCost.bound) << std::endl;
+        if(result.status != gpscat::AnalysisResult::Status::Complete)
+            std::cerr << "Analysis stopped during stage \"" << result.stage << "\": " << result.message << std::endl;
     }
+    else if(result.status == gpscat::AnalysisResult::Status::Complete) {
+        if(verbosity >= 1) std::cout << "\nThe inferred cost upperbound is" << std::endl;
+        std::cout << result.bound << std::endl;
+        // The first resource is the bound above
+        for(std::size_t i = 1; i < result.resourceBounds.size(); ++i)
+            std::cout << result.resourceBounds[i].resource << '\t' << (result.resourceBounds[i].bound.empty() ? "none" : result.resourceBounds[i].bound) << std::endl;
+    }
+    else {
+        std::cerr << "Analysis stopped during stage \"" << result.stage << "\": " << result.message << std::endl;
+    }
+}
 
-    // Read cost model
-    if(verbosity >= 1) std::cout << "Reading cost model." << std::endl;
+static gpscat::Analyzer::Options getAnalyzerOptions() {
+    gpscat::Analyzer::Options options;
+    options.arch = arch;
+    options.optLevel = optLevel;
+    options.cpu = cpu;
+    options.scheduleBlocks = scheduleBlocks;
+    options.configuration = getSolverConfiguration();
+    options.coalesceTicks = coalesceTicks;
+    options.sliceControl = sliceControl;
+    options.componentJobs = componentJobs;
+    options.portfolio = portfolio;
+    options.portfolioBest = portfolioBest;
+    options.portfolioTimeout = portfolioTimeout;
+    options.compositional = compositional;
+    options.compositionalJobs = compositionalJobs;
+    options.allFunctions = allFunctions;
+    options.functionJobs = functionJobs;
+    options.deadlineSeconds = deadlineSeconds;
+    options.cacheDir = cacheDir;
+    options.cacheSizeMB = cacheSize;
+    options.keepTemporaryFiles = keepTemporaryFiles;
+    options.log = &std::cout;
+    options.verbosity = verbosity;
+    return options;
+}
 
-    gpscat::AssemblyCostModel costModel(costModelFilename);
-    
-    // Use IRLocator to create LLVM IR to ASM mapping information
-    if(verbosity >= 1) std::cout << "Creating LLVM IR to ASM mapping information." << std::endl;
+static int watchInputFile(const gpscat::AssemblyCostModel &costModel, const gpscat::Analyzer::Options &options) {
+    if(inputFilename == "-") {
+        std::cerr << "-watch needs an input file." << std::endl;
+        return 1;
+    }
 
-    gpscat::IRLocator irLocator;
-    irLocator.run(module.get());
+    gpscat::IncrementalAnalyzer incrementalAnalyzer(costModel, options);
 
-    // Compile this module into target language
-    if(verbosity >= 1) std::cout << "Compiling into target language." << std::endl;
+    // Runs until interrupted
+    llvm::sys::TimePoint<> lastModification;
+    while(true) {
+        llvm::sys::fs::file_status status;
+        if(llvm::sys::fs::status(inputFilename, status) || status.getLastModificationTime() == lastModification) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+        lastModification = status.getLastModificationTime();
+
+        auto start = std::chrono::steady_clock::now();
+
+        // A file which is still being written fails to parse, and is read
+        // again when the writer is done with it
+        llvm::LLVMContext context;
+        llvm::SMDiagnostic err;
+        std::unique_ptr<llvm::Module> module = parseIRFile(inputFilename, err, context);
+        if(!module) {
+            err.print("gpscat-cost", llvm::errs());
+            continue;
+        }
 
-    std::string mappingBitcodePath = gpscat::getTemporaryFilePath("gpscat-cost", "map.bc");
-    std::string mappingAsmPath = gpscat::getTemporaryFilePath("gpscat-cost", "map.s");
-    gpscat::writeBitcodeFile(module.get(), mappingBitcodePath);
+        gpscat::AnalysisResult result = incrementalAnalyzer.analyze(module.get());
+        if(result.status == gpscat::AnalysisResult::Status::Complete)
+            result.bound = formatBound(result.bound);
+        printResult(result);
 
-    llvm::ErrorOr<std::string> llcPath = llvm::sys::findProgramByName("llc");
-    if(std::error_code ec = llcPath.getError()) {
-        std::cerr << ec << std::endl
-                  << ec.message() << std::endl;
-        return 3;
-    }
-    llvm::sys::ExecuteAndWait(llcPath.get(),
-                              {"llc"s, mappingBitcodePath, "-o"s, mappingAsmPath, "-march="s + arch, "-O"s + optLevel});
-
-    // Extract LLVM IR to ASM mapping
-    if(verbosity >= 1) std::cout << "Extract mapping information." << std::endl;
-
-    gpscat::MappingExtractor mappingExtractor;
-    const auto& IRAsmMap = mappingExtractor.extractMapping(mappingAsmPath, costModel, module.get());
-
-    // Print mapping
-    if(verbosity >= 2) {
-        std::cout << "\n--------LLVM IR to Assembly mapping--------\n";
-        // print LLVM IR instructions by their original order
-        uint32_t lineNumber = 0;
-        for(auto &&F : *module) {
-            for(auto &&B : F) {
-                for(auto &&I : B) {
-                    lineNumber++;
-                    std::cout << lineNumber << '\t';
-
-                    auto &&instOpcodeName = std::string(I.getOpcodeName());
-                    instOpcodeName.resize(20, ' ');
-                    std::cout << instOpcodeName << '\t';
-
-                    auto it = IRAsmMap.find(&I);
-                    if(it != IRAsmMap.end()) {
-                        for(const auto& asmInst : it->second)
-                            std::cout << asmInst.getName() << ' ';
-                    }
-                    std::cout << '\n';
-                }
-            }
+        if(verbosity >= 1) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "Updated in " << elapsed << " ms: " << incrementalAnalyzer.getNumCompiled() << " functions compiled, "
+                      << incrementalAnalyzer.getNumSolved() << " solved." << std::endl;
         }
-        std::cout.flush();
     }
+}
 
-    // Calculate LLVM IR block level costs
-    if(verbosity >= 1) std::cout << "Calculating LLVM IR block level costs." << std::endl;
-
-    gpscat::IRCostCalculator irCostCalculator(module.get(), costModel, IRAsmMap);
-
-    if(verbosity >= 2) {
-        // Print inst cost
-        {
-        std::cout << "\n--------Instruction cost--------\n";
-        uint32_t lineNumber = 0;
-        for(auto &&F : *module) {
-            for(auto &&B : F) {
-                for(auto &&I : B) {
-                    lineNumber++;
-
-                    auto &&instOpcodeName = std::string(I.getOpcodeName());
-                    instOpcodeName.resize(20, ' ');
-                    std::cout << lineNumber << '\t' << instOpcodeName << '\t'
-                              << irCostCalculator.getInstCost(&I) << '\n';
-                }
-            }
-        }
-        std::cout.flush();
-        }
-    
-        // Print block cost
-        {
-        std::cout << "\n--------Block cost--------\n";
-        uint32_t lineNumber = 0;
-        for(auto &&F : *module) {
-            for(auto &&B : F) {
-                lineNumber++;
-                std::cout << lineNumber << '\t'
-                          << irCostCalculator.getBlockCost(&B) << '\n';
-            }
-        }
-        std::cout.flush();
-        }
-    }
+static int analyzeBatch(const gpscat::AssemblyCostModel &costModel, const gpscat::Analyzer::Options &options) {
+    auto inputs = gpscat::BatchAnalyzer::readManifest(batchManifest);
+    std::string journal = journalPath.empty() ? batchManifest + ".journal"s : std::string(journalPath);
+
+    bool allComplete = true;
+    gpscat::BatchAnalyzer batchAnalyzer(costModel, options, batchJobs);
+    batchAnalyzer.run(inputs, journal, [&allComplete](const std::string &input, const gpscat::AnalysisResult &result) {
+        allComplete &= result.status == gpscat::AnalysisResult::Status::Complete;
+        if(jsonOutput)
+            std::cout << input << '\t' << result.toJSON() << std::endl;
+        else if(result.status == gpscat::AnalysisResult::Status::Complete)
+            std::cout << input << '\t' << formatBound(result.bound) << std::endl;
+        else
+            std::cout << input << "\tstopped during stage \"" << result.stage << "\": " << result.message << std::endl;
+    });
+
+    return allComplete ? 0 : 4;
+}
 
-    // Call upperbound solver to calculate LLVM IR function level cost
-    if(verbosity >= 1) std::cout << "Calculating LLVM IR function level cost." << std::endl;
+int main(int argc, char *argv[]) {
+    llvm::cl::ParseCommandLineOptions(argc, argv);
 
-    gpscat::CoFloCoWrapper coflocoWrapper;
+    gpscat::ProcessSupervisor &supervisor = gpscat::ProcessSupervisor::get();
+    if(!supervisor.configure(maxChildren, memoryBudget, {childMemoryLimit, childCPULimit})) {
+        std::cerr << "-memory-budget needs -child-memory-limit, which is what every external tool reserves from it" << std::endl;
+        return 1;
+    }
+    supervisor.installSignalHandlers();
 
-    if(verbosity >= 1) std::cout << "\tAnnotating cost information." << std::endl;
-    coflocoWrapper.cost2tick(module.get(), irCostCalculator.getBlockCostMap());
+    if(watch || !batchManifest.empty()) {
+        // Only the results are printed, one per version or input
+        if(!sourceProfile.empty()) {
+            std::cerr << "-source-profile cannot be combined with -watch or -batch" << std::endl;
+            return 1;
+        }
+        if(allFunctions && !batchManifest.empty() && !jsonOutput) {
+            std::cerr << "-all-functions with -batch needs -json" << std::endl;
+            return 1;
+        }
 
-    if(verbosity >= 1) std::cout << "\tExtracting cost relation system." << std::endl;
-    std::string crsPath = gpscat::getTemporaryFilePath("gpscat-cost", "tmp.ces");
-    coflocoWrapper.extractCostRelationSystem(module.get(), crsPath);
+        gpscat::AssemblyCostModel costModel(costModelFilename);
+        return watch ? watchInputFile(costModel, getAnalyzerOptions()) : analyzeBatch(costModel, getAnalyzerOptions());
+    }
 
-    if(verbosity >= 1) std::cout << "\tSolving cost upperbound." << std::endl;
-    std::string costUpperBound = coflocoWrapper.readCRSAndSolveUpperBound(crsPath);
+    // Read bitcode file
+    if(verbosity >= 1) std::cout << "Reading input bitcode file." << std::endl;
 
-    if(removeNat) costUpperBound = coflocoWrapper.removeNat(costUpperBound);
-    if(replaceNat) costUpperBound = coflocoWrapper.replaceNatWithMax(costUpperBound);
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> module = parseIRFile(inputFilename, err, context);
 
-    if(symengineFormat) {
-        SymEngine::Expression symUpperBound(costUpperBound);
-        costUpperBound = expand(symUpperBound).get_basic()->__str__();
+    if(!module) {
+        err.print(argv[0], llvm::errs());
+        return 1;
     }
 
-    // Output cost upperbound
-    if(verbosity >= 1) std::cout << "\nThe inferred cost upperbound is" << std::endl;
-    std::cout << costUpperBound << std::endl;
+    // Read cost model
+    if(verbosity >= 1) std::cout << "Reading cost model." << std::endl;
 
-    // Remove temporary file
-    if(!keepTemporaryFiles) {
-        llvm::sys::fs::remove(mappingBitcodePath);
-        llvm::sys::fs::remove(mappingAsmPath);
-        llvm::sys::fs::remove(crsPath);
+    gpscat::Analyzer analyzer(costModelFilename, getAnalyzerOptions());
+    gpscat::AnalysisResult result = analyzer.analyze(module.get());
+
+    // Print whatever the analysis got to, even if it stopped early
+    for(auto &functionCost : result.functionCosts)
+        if(!functionCost.bound.empty())
+            functionCost.bound = formatBound(functionCost.bound);
+    if(!result.bound.empty())
+        result.bound = formatBound(result.bound);
+    for(auto &resourceBound : result.resourceBounds)
+        if(!resourceBound.bound.empty())
+            resourceBound.bound = formatBound(resourceBound.bound);
+    printResult(result);
+
+    if(!sourceProfile.empty()) {
+        if(result.sourceFiles.empty())
+            std::cerr << "No source locations, the input has no debug info or its costs came from the cache" << std::endl;
+        std::ofstream profile(sourceProfile);
+        profile << result.toCollapsedStacks();
+        if(!profile)
+            std::cerr << "Cannot write " << sourceProfile << std::endl;
     }
 
-    return 0;
+    return result.status == gpscat::AnalysisResult::Status::Complete ? 0 : 4;
 }
@@ -0,0 +1,75 @@
+// Generates a cost model for gpscat-cost from the scheduling model LLVM
+// has for a target, so that targets without a hand-written cost table can
+// be analyzed. Opcodes are keyed by the mnemonic llc prints for them.
+
+#include <gpscat/CostModelGenerator.h>
+
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static llvm::cl::opt<std::string> arch("arch", llvm::cl::desc("Target architecture, as passed to gpscat-cost"), llvm::cl::init(""));
+static llvm::cl::opt<std::string> targetTriple("mtriple", llvm::cl::desc("Target triple"), llvm::cl::init(""));
+static llvm::cl::opt<std::string> cpu("mcpu", llvm::cl::desc("Processor whose scheduling model is used, as passed to llc"), llvm::cl::init("generic"));
+static llvm::cl::opt<std::string> features("mattr", llvm::cl::desc("Target features"), llvm::cl::init(""));
+static llvm::cl::opt<std::string> primary("primary", llvm::cl::desc("Metric of the Cost column, latency or throughput; the other one gets its own column"),
+                                          llvm::cl::init("latency"));
+static llvm::cl::opt<std::string> aggregate("aggregate", llvm::cl::desc("How the costs of opcodes printed with the same mnemonic are combined: median, max or min"),
+                                            llvm::cl::init("median"));
+static llvm::cl::opt<unsigned int> scale("scale", llvm::cl::desc("Factor applied to cycles before rounding them up to integer costs"), llvm::cl::init(1));
+static llvm::cl::opt<std::string> outputFilename("o", llvm::cl::desc("Output cost model csv file"), llvm::cl::init("-"));
+static llvm::cl::opt<unsigned int> verbosity("verbose", llvm::cl::desc("Verbosity"), llvm::cl::init(0));
+
+int main(int argc, char *argv[]) {
+    llvm::cl::ParseCommandLineOptions(argc, argv);
+
+    if(primary != "latency" && primary != "throughput") {
+        std::cerr << "-primary must be latency or throughput" << std::endl;
+        return 1;
+    }
+
+    gpscat::CostModelGenerator::Options options;
+    if(aggregate == "median") options.aggregate = gpscat::CostModelGenerator::Aggregate::Median;
+    else if(aggregate == "max") options.aggregate = gpscat::CostModelGenerator::Aggregate::Max;
+    else if(aggregate == "min") options.aggregate = gpscat::CostModelGenerator::Aggregate::Min;
+    else {
+        std::cerr << "-aggregate must be median, max or min" << std::endl;
+        return 1;
+    }
+    options.scale = scale;
+    options.log = &std::cerr;
+    options.verbosity = verbosity;
+
+    std::vector<gpscat::CostModelGenerator::Entry> entries;
+    std::vector<std::string> unscheduledMnemonics;
+    try {
+        gpscat::CostModelGenerator generator(arch, targetTriple, cpu, features);
+        entries = generator.generate(options);
+        unscheduledMnemonics = generator.getUnscheduledMnemonics();
+    }
+    catch(const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    // Their costs would silently be 0 in gpscat-cost
+    for(const auto &mnemonic : unscheduledMnemonics)
+        std::cerr << "No scheduling information for " << mnemonic << ", it is left out" << std::endl;
+
+    std::error_code ec;
+    llvm::raw_fd_ostream output(outputFilename, ec, llvm::sys::fs::F_Text);
+    if(ec) {
+        std::cerr << "Cannot write " << outputFilename << ": " << ec.message() << std::endl;
+        return 1;
+    }
+    output << gpscat::CostModelGenerator::toCSV(entries, primary == "latency");
+
+    if(verbosity >= 1 || entries.empty())
+        std::cerr << entries.size() << " mnemonics written, " << unscheduledMnemonics.size() << " without scheduling information left out." << std::endl;
+    return entries.empty() ? 1 : 0;
+}
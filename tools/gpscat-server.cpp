@@ -0,0 +1,77 @@
+#include <gpscat/AnalysisServer.h>
+#include <gpscat/Analyzer.h>
+#include <gpscat/ProcessSupervisor.h>
+
+#include <llvm/Support/CommandLine.h>
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+static llvm::cl::opt<std::string> costModelFilename(llvm::cl::Positional, llvm::cl::desc("<default cost model csv file, or builtin:<name>>"), llvm::cl::Required);
+static llvm::cl::opt<std::string> socketPath("socket", llvm::cl::desc("Path of the Unix domain socket to listen on"), llvm::cl::Required);
+static llvm::cl::opt<std::string> arch("arch", llvm::cl::desc("Default target assembly language"), llvm::cl::init("wasm32"));
+static llvm::cl::opt<std::string> optLevel("O", llvm::cl::Prefix, llvm::cl::desc("Default optimization level for llc"), llvm::cl::init("2"));
+static llvm::cl::opt<std::string> cpu("mcpu", llvm::cl::desc("Default target processor, passed to llc and used by schedule-blocks"), llvm::cl::init(std::string()));
+static llvm::cl::opt<bool> scheduleBlocks("schedule-blocks", llvm::cl::desc("Cost blocks by the cycles of a simulated pipeline of the processor by default"));
+static llvm::cl::opt<unsigned int> numInlines("inline", llvm::cl::desc("Default maximum number of function inline steps"), llvm::cl::init(0));
+static llvm::cl::opt<bool> eagerInline("eager-inline", llvm::cl::desc("Exhaustively inline by default (acyclic call hierarchies only)"));
+static llvm::cl::opt<std::string> functionName("function", llvm::cl::desc("Default entry function for the cost analysis"), llvm::cl::init(std::string()));
+static llvm::cl::opt<std::string> solverWorker("solver-worker", llvm::cl::desc("Solve with persistent worker processes running this program instead of starting cofloco for every query"), llvm::cl::init(std::string()));
+static llvm::cl::opt<unsigned int> numSolverWorkers("solver-workers", llvm::cl::desc("Number of persistent solver worker processes"), llvm::cl::init(1));
+static llvm::cl::opt<bool> coalesceTicks("coalesce-ticks", llvm::cl::desc("Move block costs onto fewer blocks by default"));
+static llvm::cl::opt<bool> sliceControl("slice-control", llvm::cl::desc("Slice the control flow by default"));
+static llvm::cl::opt<bool> compositional("compositional", llvm::cl::desc("Solve every function once, bottom-up along the call graph, by default"));
+static llvm::cl::opt<unsigned int> compositionalJobs("compositional-jobs", llvm::cl::desc("Number of functions of one request solved concurrently with compositional"),
+                                                     llvm::cl::init(1));
+static llvm::cl::opt<unsigned int> numWorkers("jobs", llvm::cl::desc("Number of requests handled concurrently"),
+                                              llvm::cl::init(std::thread::hardware_concurrency()));
+static llvm::cl::opt<unsigned int> deadlineSeconds("deadline", llvm::cl::desc("Default time budget in seconds of a request (0 for none)"), llvm::cl::init(0));
+static llvm::cl::opt<std::string> cacheDir("cache-dir", llvm::cl::desc("Keep the block costs and bounds in this directory instead of memory, shared with other servers and gpscat-cost"), llvm::cl::init(std::string()));
+static llvm::cl::opt<unsigned int> cacheSize("cache-size", llvm::cl::desc("Size limit in MB of the cache directory"), llvm::cl::init(1024));
+static llvm::cl::opt<unsigned int> maxChildren("max-children", llvm::cl::desc("Maximum number of external tools running at once (0 for unlimited)"),
+                                               llvm::cl::init(std::thread::hardware_concurrency()));
+static llvm::cl::opt<unsigned int> memoryBudget("memory-budget", llvm::cl::desc("Total memory in MB the external tools may reserve, each its -child-memory-limit (0 for unlimited)"), llvm::cl::init(0));
+static llvm::cl::opt<unsigned int> childMemoryLimit("child-memory-limit", llvm::cl::desc("Address space limit in MB of each external tool (0 for unlimited)"), llvm::cl::init(0));
+static llvm::cl::opt<unsigned int> childCPULimit("child-cpu-limit", llvm::cl::desc("CPU time limit in seconds of each external tool (0 for unlimited)"), llvm::cl::init(0));
+
+int main(int argc, char *argv[]) {
+    llvm::cl::ParseCommandLineOptions(argc, argv, "gpscat analysis server\n\n"
+        "  Each connection sends one request, a line of <option>=<value> pairs\n"
+        "  ending with size=<N>, followed by N bytes of bitcode or textual IR,\n"
+        "  and receives the result as one line of JSON. Cost models are read\n"
+        "  once per path for the lifetime of the server.\n");
+
+    gpscat::ProcessSupervisor &supervisor = gpscat::ProcessSupervisor::get();
+    if(!supervisor.configure(maxChildren, memoryBudget, {childMemoryLimit, childCPULimit})) {
+        std::cerr << "-memory-budget needs -child-memory-limit, which is what every external tool reserves from it" << std::endl;
+        return 1;
+    }
+    supervisor.installSignalHandlers();
+
+    gpscat::Analyzer::Options options;
+    options.arch = arch;
+    options.optLevel = optLevel;
+    options.cpu = cpu;
+    options.scheduleBlocks = scheduleBlocks;
+    options.configuration.numInlines = numInlines;
+    options.configuration.eagerInline = eagerInline;
+    options.configuration.functionName = functionName;
+    options.configuration.solverWorker = solverWorker;
+    options.configuration.numSolverWorkers = numSolverWorkers;
+    options.coalesceTicks = coalesceTicks;
+    options.sliceControl = sliceControl;
+    options.compositional = compositional;
+    options.compositionalJobs = compositionalJobs;
+    options.deadlineSeconds = deadlineSeconds;
+    options.cacheDir = cacheDir;
+    options.cacheSizeMB = cacheSize;
+
+    gpscat::AnalysisServer server(costModelFilename, options, numWorkers);
+    if(!server.listen(socketPath))
+        return 1;
+
+    // Runs until interrupted
+    server.serve();
+    return 0;
+}
@@ -0,0 +1,254 @@
+// Checks bounds of gpscat-cost against executions. The module is
+// analyzed as gpscat-cost would, then the entry function, with the ticks
+// of its block costs, is run under a JIT on arguments drawn from the
+// bounds file. The costs the ticks add up to must not exceed the bound
+// evaluated at the same arguments, and their difference is the slack of
+// the bound.
+
+#include <gpscat/Analyzer.h>
+#include <gpscat/BoundExpression.h>
+#include <gpscat/CostExecutor.h>
+#include <gpscat/ProcessSupervisor.h>
+#include <gpscat/Utils.h>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+static llvm::cl::opt<std::string> costModelFilename(llvm::cl::Positional, llvm::cl::desc("<cost model csv file, or builtin:<name>>"), llvm::cl::Required);
+static llvm::cl::opt<std::string> inputFilename(llvm::cl::Positional, llvm::cl::desc("<input bitcode file>"), llvm::cl::init("-"));
+static llvm::cl::list<std::string> functionNames("function", llvm::cl::desc("Entry functions to validate, each analyzed on its own"), llvm::cl::CommaSeparated, llvm::cl::OneOrMore);
+static llvm::cl::opt<std::string> boundsFilename("bounds", llvm::cl::desc("Ranges of the parameters, one \"<variable> <low> <high>\" per line"), llvm::cl::Required);
+static llvm::cl::opt<unsigned int> numSamples("samples", llvm::cl::desc("Number of executions of each function"), llvm::cl::init(100));
+static llvm::cl::opt<unsigned int> seed("seed", llvm::cl::desc("Seed of the sampled arguments"), llvm::cl::init(1));
+static llvm::cl::opt<unsigned int> timeoutSeconds("timeout", llvm::cl::desc("Time limit in seconds of each execution (0 for none)"), llvm::cl::init(10));
+static llvm::cl::opt<std::string> arch("arch", llvm::cl::desc("Target assembly language"), llvm::cl::init("wasm32"));
+static llvm::cl::opt<std::string> cpu("mcpu", llvm::cl::desc("Target processor, passed to llc and used by -schedule-blocks"), llvm::cl::init(std::string()));
+static llvm::cl::opt<bool> scheduleBlocks("schedule-blocks", llvm::cl::desc("Cost blocks by the cycles per iteration of a simulated out-of-order pipeline of -mcpu instead of summing the cost model"));
+static llvm::cl::opt<std::string> optLevel("O", llvm::cl::Prefix, llvm::cl::desc("Optimization level for llc"), llvm::cl::init("2"));
+static llvm::cl::opt<unsigned int> numInlines("inline", llvm::cl::desc("Maximum number of function inline steps"), llvm::cl::init(0));
+static llvm::cl::opt<bool> eagerInline("eager-inline", llvm::cl::desc("Exhaustively inline (acyclic call hierarchies only)"));
+static llvm::cl::opt<bool> compositional("compositional", llvm::cl::desc("Solve every function once, bottom-up along the call graph, and charge calls with the bound of the callee instead of inlining"));
+static llvm::cl::opt<std::string> cacheDir("cache-dir", llvm::cl::desc("Reuse the block costs and bounds of unchanged functions stored in this directory, and store new ones there"), llvm::cl::init(std::string()));
+static llvm::cl::opt<bool> keepTemporaryFiles("keep-temporary-files", llvm::cl::desc("Don't remove the temporary files when analyzing cost"));
+static llvm::cl::opt<int> verbosity("verbose", llvm::cl::desc("verbosity level (0, 1, 2)"), llvm::cl::init(0));
+
+static gpscat::Analyzer::Options getAnalyzerOptions(const std::string &functionName) {
+    gpscat::Analyzer::Options options;
+    options.arch = arch;
+    options.optLevel = optLevel;
+    options.cpu = cpu;
+    options.scheduleBlocks = scheduleBlocks;
+    options.configuration.numInlines = numInlines;
+    options.configuration.eagerInline = eagerInline;
+    options.configuration.functionName = functionName;
+    options.compositional = compositional;
+    options.cacheDir = cacheDir;
+    options.keepTemporaryFiles = keepTemporaryFiles;
+    options.log = &std::cout;
+    options.verbosity = verbosity;
+    return options;
+}
+
+// variable -> [low, high], like gpscat-score reads them
+static std::map<std::string, std::pair<double, double>> readBounds(const std::string &path) {
+    std::map<std::string, std::pair<double, double>> bounds;
+    std::ifstream boundsFile(path);
+    if(!boundsFile)
+        std::cerr << "Cannot read " << path << std::endl;
+
+    std::string variableName;
+    double lowerBound, upperBound;
+    while(boundsFile >> variableName >> lowerBound >> upperBound) {
+        if(lowerBound > upperBound)
+            std::cerr << "Lowerbound is greater than upperbound!" << std::endl;
+        else
+            bounds[variableName] = {lowerBound, upperBound};
+    }
+    return bounds;
+}
+
+struct Summary {
+    unsigned int executions = 0;
+    unsigned int violations = 0;
+    unsigned int failures = 0;
+    // Slack relative to the bound
+    double minSlack = std::numeric_limits<double>::infinity();
+    double maxSlack = -std::numeric_limits<double>::infinity();
+    double sumSlack = 0;
+};
+
+// 0 if every execution stays within the bound, 3 if one exceeds it, 4 if
+// there is no bound to compare with and 1 if the function cannot be run,
+// including when no sample returned
+static int validate(const llvm::MemoryBufferRef &bitcode, const std::string &functionName,
+                    const std::map<std::string, std::pair<double, double>> &bounds) {
+    auto context = std::make_unique<llvm::LLVMContext>();
+    llvm::SMDiagnostic err;
+    std::unique_ptr<llvm::Module> module = llvm::parseIR(bitcode, err, *context);
+    if(!module) {
+        err.print("gpscat-validate", llvm::errs());
+        return 1;
+    }
+
+    llvm::Function *F = module->getFunction(functionName);
+    if(!F || F->isDeclaration()) {
+        std::cerr << "Function " << functionName << " is not defined in " << inputFilename << std::endl;
+        return 1;
+    }
+
+    // Bounds refer to the parameters by name, the way the solver names
+    // them
+    std::vector<std::string> variables;
+    std::vector<std::uniform_int_distribution<std::int64_t>> distributions;
+    for(auto &&arg : F->args()) {
+        if(!arg.hasName())
+            arg.setName("arg" + std::to_string(arg.getArgNo()));
+        variables.push_back(gpscat::getBoundVariableName(arg));
+
+        auto it = bounds.find(variables.back());
+        if(it == bounds.end()) {
+            std::cerr << "Parameter " << variables.back() << " of " << functionName << " has no range in " << boundsFilename << std::endl;
+            return 1;
+        }
+        auto low = static_cast<std::int64_t>(std::ceil(it->second.first));
+        auto high = static_cast<std::int64_t>(std::floor(it->second.second));
+        if(low > high) {
+            std::cerr << "The range of " << variables.back() << " holds no integer" << std::endl;
+            return 1;
+        }
+        distributions.emplace_back(low, high);
+    }
+
+    std::optional<gpscat::BoundExpression> bound;
+    try {
+        gpscat::Analyzer analyzer(costModelFilename, getAnalyzerOptions(functionName));
+        gpscat::AnalysisResult result = analyzer.analyze(module.get());
+        if(!result.bound.empty())
+            bound = gpscat::BoundExpression::parse(result.bound);
+        std::cout << functionName << ": bound " << (bound ? result.bound : "unknown") << std::endl;
+        if(!bound && !result.message.empty())
+            std::cerr << functionName << ": " << result.message << std::endl;
+    }
+    catch(const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    catch(const std::invalid_argument &e) {
+        std::cerr << functionName << ": cannot evaluate the bound: " << e.what() << std::endl;
+    }
+
+    // The analysis left the ticks of the block costs in the module, and
+    // nothing else: -compositional summarizes calls in a copy
+    std::unique_ptr<gpscat::CostExecutor> executor;
+    try {
+        executor = std::make_unique<gpscat::CostExecutor>(std::move(context), std::move(module), functionName);
+    }
+    catch(const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    Summary summary;
+    std::mt19937_64 generator(seed);
+    for(unsigned int sample = 0; sample < numSamples; ++sample) {
+        std::vector<std::int64_t> args;
+        std::map<std::string, double> values;
+        std::cout << "  ";
+        for(std::size_t i = 0; i < variables.size(); ++i) {
+            args.push_back(distributions[i](generator));
+            values[variables[i]] = static_cast<double>(args.back());
+            std::cout << variables[i] << '=' << args.back() << ' ';
+        }
+
+        std::optional<std::int64_t> cost = executor->run(args, timeoutSeconds);
+        if(!cost) {
+            std::cout << " did not return" << std::endl;
+            ++summary.failures;
+            continue;
+        }
+        ++summary.executions;
+        std::cout << " cost " << *cost;
+        if(!bound) {
+            std::cout << std::endl;
+            continue;
+        }
+
+        double boundValue = bound->evaluate(values);
+        double slack = boundValue - static_cast<double>(*cost);
+        std::cout << "  bound " << boundValue;
+        if(slack < 0) {
+            std::cout << "  VIOLATED by " << -slack << std::endl;
+            ++summary.violations;
+        }
+        else {
+            double relativeSlack = std::isinf(boundValue) ? 1 : boundValue > 0 ? slack / boundValue : 0;
+            std::cout << "  slack " << slack << " (" << 100 * relativeSlack << "%)" << std::endl;
+            summary.minSlack = std::min(summary.minSlack, relativeSlack);
+            summary.maxSlack = std::max(summary.maxSlack, relativeSlack);
+            summary.sumSlack += relativeSlack;
+        }
+    }
+
+    std::cout << functionName << ": " << summary.executions << " executions, " << summary.failures << " did not return";
+    if(bound) {
+        std::cout << ", " << summary.violations << " violations";
+        unsigned int withinBound = summary.executions - summary.violations;
+        if(withinBound)
+            std::cout << ", slack min " << 100 * summary.minSlack << "% mean " << 100 * summary.sumSlack / withinBound
+                      << "% max " << 100 * summary.maxSlack << '%';
+    }
+    std::cout << std::endl;
+
+    if(summary.violations)
+        return 3;
+    // Nothing was checked against the bound
+    if(numSamples && !summary.executions) {
+        std::cerr << functionName << ": no execution returned" << std::endl;
+        return 1;
+    }
+    return bound ? 0 : 4;
+}
+
+int main(int argc, char *argv[]) {
+    llvm::cl::ParseCommandLineOptions(argc, argv);
+
+    gpscat::ProcessSupervisor::get().installSignalHandlers();
+
+    // Every function is analyzed from its own copy of the module
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> bitcode = llvm::MemoryBuffer::getFileOrSTDIN(inputFilename);
+    if(!bitcode) {
+        std::cerr << "Cannot read " << inputFilename << ": " << bitcode.getError().message() << std::endl;
+        return 1;
+    }
+
+    auto bounds = readBounds(boundsFilename);
+
+    // A violated bound matters more than any failure
+    int exitCode = 0;
+    for(const std::string &functionName : functionNames) {
+        int functionExitCode = validate(bitcode.get()->getMemBufferRef(), functionName, bounds);
+        if(exitCode != 3 && functionExitCode)
+            exitCode = functionExitCode == 3 ? 3 : std::max(exitCode, functionExitCode);
+    }
+    return exitCode;
+}